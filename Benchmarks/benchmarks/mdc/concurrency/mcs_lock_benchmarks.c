@@ -0,0 +1,277 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mcs_lock_benchmarks.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <mdc/concurrency/latch.h>
+#include <mdc/concurrency/mcs_lock.h>
+#include <mdc/std/threads.h>
+#include <mdc/std/time.h>
+
+enum {
+  kMaxThreadsCount = 64,
+  kLocksCount = 1 << 20,
+  kRepeatsCount = 3
+};
+
+struct LockType {
+  const char* name;
+  int (*init)(void* lock);
+  void (*deinit)(void* lock);
+  void (*lock)(void* lock);
+  void (*unlock)(void* lock);
+};
+
+union Lock {
+  mtx_t mutex;
+  struct Mdc_McsLock mcs_lock;
+};
+
+struct Run {
+  const struct LockType* lock_type;
+  union Lock lock;
+  struct Mdc_Latch start_latch;
+  int locks_per_thread;
+  unsigned long counter;
+};
+
+static int InitPlainMutex(void* lock) {
+  return mtx_init(lock, mtx_plain);
+}
+
+static int InitAdaptiveMutex(void* lock) {
+  return mtx_init(lock, mtx_plain | mtx_adaptive);
+}
+
+static void DeinitMutex(void* lock) {
+  mtx_destroy(lock);
+}
+
+static void LockMutex(void* lock) {
+  mtx_lock(lock);
+}
+
+static void UnlockMutex(void* lock) {
+  mtx_unlock(lock);
+}
+
+static int InitMcsLock(void* lock) {
+  Mdc_McsLock_Init(lock);
+
+  return thrd_success;
+}
+
+static void DeinitMcsLock(void* lock) {
+  Mdc_McsLock_Deinit(lock);
+}
+
+static void LockMcsLock(void* lock) {
+  Mdc_McsLock_Lock(lock);
+}
+
+static void UnlockMcsLock(void* lock) {
+  Mdc_McsLock_Unlock(lock);
+}
+
+static const struct LockType kLockTypes[] = {
+  {
+      "mtx_plain",
+      &InitPlainMutex,
+      &DeinitMutex,
+      &LockMutex,
+      &UnlockMutex
+  },
+  {
+      "mtx_adaptive",
+      &InitAdaptiveMutex,
+      &DeinitMutex,
+      &LockMutex,
+      &UnlockMutex
+  },
+  {
+      "Mdc_McsLock",
+      &InitMcsLock,
+      &DeinitMcsLock,
+      &LockMcsLock,
+      &UnlockMcsLock
+  }
+};
+
+enum {
+  kLockTypesCount = sizeof(kLockTypes) / sizeof(kLockTypes[0])
+};
+
+static int IncrementCounter(void* arg) {
+  struct Run* run = arg;
+  const struct LockType* lock_type = run->lock_type;
+  int i;
+
+  Mdc_Latch_Wait(&run->start_latch);
+
+  for (i = 0; i < run->locks_per_thread; ++i) {
+    lock_type->lock(&run->lock);
+    run->counter += 1;
+    lock_type->unlock(&run->lock);
+  }
+
+  return 0;
+}
+
+static double GetElapsedNanoseconds(
+    const struct timespec* start,
+    const struct timespec* end
+) {
+  return (end->tv_sec - start->tv_sec) * 1e9
+      + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+* Returns the wall time per acquisition in nanoseconds, or a negative
+* value on failure. Threads are created before the clock starts and
+* are released together through the latch.
+*/
+static double MeasureRun(
+    const struct LockType* lock_type,
+    size_t threads_count
+) {
+  struct Run run;
+  thrd_t threads[kMaxThreadsCount];
+  struct timespec start;
+  struct timespec end;
+  size_t created_count;
+  size_t i;
+  double elapsed;
+
+  int init_result;
+  int thread_create_result;
+
+  elapsed = -1;
+
+  run.lock_type = lock_type;
+  run.locks_per_thread = (int) (kLocksCount / threads_count);
+  run.counter = 0;
+
+  init_result = lock_type->init(&run.lock);
+  if (init_result != thrd_success) {
+    goto return_bad;
+  }
+
+  init_result = Mdc_Latch_Init(&run.start_latch, 1);
+  if (init_result != thrd_success) {
+    goto deinit_lock;
+  }
+
+  for (created_count = 0; created_count < threads_count; ++created_count) {
+    thread_create_result = thrd_create(
+        &threads[created_count],
+        &IncrementCounter,
+        &run
+    );
+    if (thread_create_result != thrd_success) {
+      break;
+    }
+  }
+
+  timespec_get(&start, TIME_UTC);
+  Mdc_Latch_CountDown(&run.start_latch, 1);
+
+  for (i = 0; i < created_count; ++i) {
+    thrd_join(threads[i], NULL);
+  }
+
+  timespec_get(&end, TIME_UTC);
+
+  if (created_count == threads_count) {
+    elapsed = GetElapsedNanoseconds(&start, &end)
+        / ((double) run.locks_per_thread * threads_count);
+  }
+
+  Mdc_Latch_Deinit(&run.start_latch);
+
+deinit_lock:
+  lock_type->deinit(&run.lock);
+
+return_bad:
+  return elapsed;
+}
+
+void Mdc_McsLock_RunBenchmarks(void) {
+  size_t threads_count;
+  size_t i;
+  size_t repeat;
+  double best_elapsed;
+  double elapsed;
+
+  printf(
+      "Lock contention: ns per acquisition, best of %d runs of %d"
+          " acquisitions\n",
+      kRepeatsCount,
+      kLocksCount
+  );
+
+  printf("%8s", "threads");
+  for (i = 0; i < kLockTypesCount; ++i) {
+    printf("%16s", kLockTypes[i].name);
+  }
+  printf("\n");
+
+  for (threads_count = 1;
+      threads_count <= kMaxThreadsCount;
+      threads_count *= 2) {
+    printf("%8u", (unsigned int) threads_count);
+
+    for (i = 0; i < kLockTypesCount; ++i) {
+      best_elapsed = -1;
+
+      for (repeat = 0; repeat < kRepeatsCount; ++repeat) {
+        elapsed = MeasureRun(&kLockTypes[i], threads_count);
+        if (elapsed < 0) {
+          best_elapsed = -1;
+          break;
+        }
+
+        if (best_elapsed < 0 || elapsed < best_elapsed) {
+          best_elapsed = elapsed;
+        }
+      }
+
+      if (best_elapsed < 0) {
+        printf("%16s", "failed");
+      } else {
+        printf("%16.1f", best_elapsed);
+      }
+    }
+
+    printf("\n");
+    fflush(stdout);
+  }
+}
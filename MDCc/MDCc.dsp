@@ -160,6 +160,58 @@ LINK32=link.exe
 # Begin Group "mdc_h"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency_h"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\barrier.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\latch.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\mcs_lock.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\mpmc_queue.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\mtx.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\once_cell.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\rw_lock.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\semaphore.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\spsc_ring.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\thrd.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\thread_local.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\thread_pool.h
+# End Source File
+# End Group
 # Begin Group "error_h"
 
 # PROP Default_Filter ""
@@ -173,8 +225,16 @@ SOURCE=.\include\mdc\error\exit_on_error.h
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\include\mdc\malloc\arena.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\malloc\malloc.h
 # End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\malloc\pool.h
+# End Source File
 # End Group
 # Begin Group "std_h"
 
@@ -185,6 +245,10 @@ SOURCE=.\include\mdc\std\assert.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\include\mdc\std\stdatomic.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\std\stdbool.h
 # End Source File
 # Begin Source File
@@ -197,6 +261,10 @@ SOURCE=.\include\mdc\std\threads.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\include\mdc\std\time.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\std\wchar.h
 # End Source File
 # End Group
@@ -224,6 +292,98 @@ SOURCE=.\include\mdc\wchar_t\wide_encoding.h
 # Begin Group "mdc_c"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency_c"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\barrier.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\cpu_pause.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\latch.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mcs_lock.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\monotonic_clock.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\monotonic_clock.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mpmc_queue.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mtx.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mtx_profile.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mtx_profile.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\once_cell.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\power_of_two.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\power_of_two.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\rw_lock.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\semaphore.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\sharded_counter.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\sharded_counter.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\spsc_ring.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\thrd.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\thread_pool.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\work_stealing_deque.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\work_stealing_deque.h
+# End Source File
+# End Group
 # Begin Group "error_c"
 
 # PROP Default_Filter ""
@@ -237,12 +397,36 @@ SOURCE=.\src\mdc\error\exit_on_error.c
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\src\mdc\malloc\allocator.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\malloc\arena.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\mdc\malloc\malloc.c
 # End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\malloc\malloc_accounting.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\malloc\pool.c
+# End Source File
 # End Group
 # Begin Group "std_c"
 
 # PROP Default_Filter ""
+# Begin Group "stdatomic_c"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\std\stdatomic\stdatomic.c
+# End Source File
+# End Group
 # Begin Group "threads_c"
 
 # PROP Default_Filter ""
@@ -256,12 +440,48 @@ SOURCE=.\src\mdc\std\threads\cond.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\mdc\std\threads\deadline.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\threads\deadline.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\threads\futex.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\threads\futex.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\mdc\std\threads\mutex.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\mdc\std\threads\mutex.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\mdc\std\threads\threads.c
 # End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\threads\tss.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\threads\tss.h
+# End Source File
+# End Group
+# Begin Group "time_c"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\std\time\time.c
+# End Source File
 # End Group
 # Begin Group "wchar_c"
 
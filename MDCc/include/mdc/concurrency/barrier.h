@@ -0,0 +1,154 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_BARRIER_H_
+#define MDC_C_CONCURRENCY_BARRIER_H_
+
+#include <limits.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_Barrier_kMaxCount = INT_MAX
+};
+
+/**
+ * A reusable barrier for a fixed number of threads that proceed in
+ * phases. Each phase completes when the expected number of arrivals
+ * is reached. The last thread to arrive runs the optional completion
+ * function, resets the count and flips the phase, which releases
+ * every waiter at once.
+ *
+ * The phase acts as the barrier's sense: a thread remembers the phase
+ * it arrived in and waits for it to change, so the count can be reset
+ * for the next phase without racing threads that are still waking up
+ * from the previous one. On Linux, the phase is a futex word.
+ */
+
+#if defined(__linux__)
+
+struct Mdc_Barrier {
+  int phase_;
+  int remaining_count_;
+  int expected_count_;
+
+  void (*completion_)(void* context);
+  void* completion_context_;
+};
+
+#else
+
+struct Mdc_Barrier {
+  mtx_t mutex_;
+  cnd_t cond_;
+
+  int phase_;
+  int remaining_count_;
+  int expected_count_;
+
+  void (*completion_)(void* context);
+  void* completion_context_;
+};
+
+#endif
+
+/**
+ * Initializes the barrier.
+ *
+ * @param barrier the barrier to initialize
+ * @param count the number of arrivals that complete each phase,
+ *    between 0 and Mdc_Barrier_kMaxCount
+ * @param completion the function that the last arriving thread runs
+ *    before a phase completes, or NULL
+ * @param completion_context the argument that is passed to the
+ *    completion function
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_Barrier_Init(
+    struct Mdc_Barrier* barrier,
+    int count,
+    void (*completion)(void* context),
+    void* completion_context
+);
+
+DLLEXPORT void Mdc_Barrier_Deinit(struct Mdc_Barrier* barrier);
+
+/**
+ * Arrives at the barrier the specified number of times without
+ * blocking. The phase that was arrived in is written out, to be
+ * passed to Mdc_Barrier_Wait.
+ *
+ * @param barrier the barrier to arrive at
+ * @param count the number of arrivals, which must not exceed the
+ *    arrivals remaining in the current phase
+ * @param phase receives the phase that was arrived in
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Barrier_Arrive(
+    struct Mdc_Barrier* barrier,
+    int count,
+    int* phase
+);
+
+/**
+ * Blocks until the specified phase has completed.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Barrier_Wait(struct Mdc_Barrier* barrier, int phase);
+
+/**
+ * Arrives at the barrier once, then blocks until the current phase
+ * has completed.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Barrier_ArriveAndWait(struct Mdc_Barrier* barrier);
+
+/**
+ * Decrements the expected number of arrivals for all subsequent
+ * phases, then arrives at the barrier once without blocking.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Barrier_ArriveAndDrop(struct Mdc_Barrier* barrier);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_BARRIER_H_ */
@@ -0,0 +1,118 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_LATCH_H_
+#define MDC_C_CONCURRENCY_LATCH_H_
+
+#include <limits.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_Latch_kMaxCount = INT_MAX
+};
+
+/**
+ * A single-use countdown. Threads count the latch down and wait for
+ * it to reach zero, at which point every waiter is released at once
+ * and the latch stays open. On Linux, the count is a futex word, and
+ * waiters are only woken by the count down that reaches zero.
+ */
+
+#if defined(__linux__)
+
+struct Mdc_Latch {
+  int count_;
+};
+
+#else
+
+struct Mdc_Latch {
+  mtx_t mutex_;
+  cnd_t cond_;
+
+  int count_;
+};
+
+#endif
+
+/**
+ * Initializes the latch.
+ *
+ * @param latch the latch to initialize
+ * @param count the number of count downs needed to open the latch,
+ *    between 0 and Mdc_Latch_kMaxCount
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_Latch_Init(struct Mdc_Latch* latch, int count);
+
+DLLEXPORT void Mdc_Latch_Deinit(struct Mdc_Latch* latch);
+
+/**
+ * Decrements the count by the specified amount without blocking. The
+ * amount must not exceed the current count. Waiters are released
+ * when the count reaches zero.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Latch_CountDown(struct Mdc_Latch* latch, int count);
+
+/**
+ * Returns nonzero if the count has reached zero, or zero otherwise.
+ */
+DLLEXPORT int Mdc_Latch_TryWait(struct Mdc_Latch* latch);
+
+/**
+ * Blocks until the count reaches zero.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Latch_Wait(struct Mdc_Latch* latch);
+
+/**
+ * Decrements the count by the specified amount, then blocks until the
+ * count reaches zero.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Latch_ArriveAndWait(struct Mdc_Latch* latch, int count);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_LATCH_H_ */
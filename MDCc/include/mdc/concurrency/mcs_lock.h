@@ -0,0 +1,101 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_MCS_LOCK_H_
+#define MDC_C_CONCURRENCY_MCS_LOCK_H_
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_McsLock_kCacheLineSize = 64
+};
+
+/**
+ * A queue lock for heavily contended critical sections. Each waiter
+ * enqueues a node on its own stack and spins on that node alone, so a
+ * handoff touches only the cache lines of the releasing and the next
+ * thread, instead of every waiter polling one shared lock word. The
+ * lock is granted in FIFO order.
+ *
+ * The lock itself serves as the node of the owner (the K42 variant of
+ * the MCS lock), so callers do not need to supply nodes. Waiters that
+ * spin for too long yield their time slice. The lock is not recursive.
+ *
+ * Because the lock is handed over in order, a waiter that has been
+ * preempted stalls every thread queued behind it. The lock therefore
+ * suits threads that each have their own core; with more threads than
+ * cores, mtx_t is usually faster.
+ */
+struct Mdc_McsLock {
+  struct Mdc_McsLock* tail_;
+  struct Mdc_McsLock* next_;
+  int is_waiting_;
+
+  unsigned char padding_[
+      Mdc_McsLock_kCacheLineSize
+          - sizeof(struct Mdc_McsLock*) * 2
+          - sizeof(int)
+  ];
+};
+
+DLLEXPORT void Mdc_McsLock_Init(struct Mdc_McsLock* lock);
+
+DLLEXPORT void Mdc_McsLock_Deinit(struct Mdc_McsLock* lock);
+
+/**
+ * Blocks until the lock is acquired. Threads are granted the lock in
+ * the order that they called this function.
+ */
+DLLEXPORT void Mdc_McsLock_Lock(struct Mdc_McsLock* lock);
+
+/**
+ * Acquires the lock without blocking.
+ *
+ * @return thrd_success if acquired, or thrd_busy if the lock is held
+ */
+DLLEXPORT int Mdc_McsLock_TryLock(struct Mdc_McsLock* lock);
+
+/**
+ * Releases the lock, handing it to the next waiting thread if there
+ * is one. The calling thread must hold the lock.
+ */
+DLLEXPORT void Mdc_McsLock_Unlock(struct Mdc_McsLock* lock);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_MCS_LOCK_H_ */
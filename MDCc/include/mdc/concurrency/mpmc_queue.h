@@ -0,0 +1,179 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_MPMC_QUEUE_H_
+#define MDC_C_CONCURRENCY_MPMC_QUEUE_H_
+
+#include <stddef.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_MpmcQueue_kCacheLineSize = 64
+};
+
+enum {
+  Mdc_MpmcQueue_kPlain = 0x0,
+  Mdc_MpmcQueue_kBlocking = 0x1
+};
+
+/**
+ * A bounded, lock-free queue of fixed-size elements for any number of
+ * producers and consumers, after Dmitry Vyukov's design. Each slot
+ * holds a sequence number that tells producers and consumers whether
+ * the slot is free for the current lap, so an operation only contends
+ * on one index and one slot.
+ *
+ * A blocking queue can also wait for space or elements. The mutex
+ * and condition variables are only touched when a thread is waiting.
+ */
+struct Mdc_MpmcQueue {
+  size_t enqueue_index_;
+  char enqueue_padding_[Mdc_MpmcQueue_kCacheLineSize - sizeof(size_t)];
+
+  size_t dequeue_index_;
+  char dequeue_padding_[Mdc_MpmcQueue_kCacheLineSize - sizeof(size_t)];
+
+  unsigned char* slots_;
+  size_t slot_size_;
+  size_t element_size_;
+  size_t mask_;
+
+  int flags_;
+  long waiting_producers_count_;
+  long waiting_consumers_count_;
+
+  mtx_t mutex_;
+  cnd_t not_empty_cond_;
+  cnd_t not_full_cond_;
+};
+
+/**
+ * Initializes the queue.
+ *
+ * @param queue the queue to initialize
+ * @param element_size the size of each element, in bytes
+ * @param capacity the minimum number of elements that the queue can
+ *    hold, which is rounded up to a power of two of at least 2
+ * @param flags Mdc_MpmcQueue_kPlain, or Mdc_MpmcQueue_kBlocking to
+ *    allow the blocking and timed functions
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure, including when the queue would be too
+ *    large to allocate
+ */
+DLLEXPORT int Mdc_MpmcQueue_Init(
+    struct Mdc_MpmcQueue* queue,
+    size_t element_size,
+    size_t capacity,
+    int flags
+);
+
+DLLEXPORT void Mdc_MpmcQueue_Deinit(struct Mdc_MpmcQueue* queue);
+
+DLLEXPORT size_t Mdc_MpmcQueue_GetCapacity(
+    const struct Mdc_MpmcQueue* queue
+);
+
+/**
+ * Pushes an element without blocking.
+ *
+ * @return nonzero if pushed, or zero if the queue is full
+ */
+DLLEXPORT int Mdc_MpmcQueue_TryPush(
+    struct Mdc_MpmcQueue* queue,
+    const void* element
+);
+
+/**
+ * Pops an element without blocking.
+ *
+ * @return nonzero if popped, or zero if the queue is empty
+ */
+DLLEXPORT int Mdc_MpmcQueue_TryPop(
+    struct Mdc_MpmcQueue* queue,
+    void* element
+);
+
+/**
+ * Blocks until the element is pushed. The queue must have been
+ * initialized with Mdc_MpmcQueue_kBlocking.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_MpmcQueue_Push(
+    struct Mdc_MpmcQueue* queue,
+    const void* element
+);
+
+/**
+ * Blocks until an element is popped. The queue must have been
+ * initialized with Mdc_MpmcQueue_kBlocking.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_MpmcQueue_Pop(struct Mdc_MpmcQueue* queue, void* element);
+
+/**
+ * Blocks until the element is pushed or until the TIME_UTC time
+ * point is reached.
+ *
+ * @return thrd_success on success, thrd_timedout if the time point
+ *    was reached, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_MpmcQueue_TimedPush(
+    struct Mdc_MpmcQueue* queue,
+    const void* element,
+    const struct timespec* time_point
+);
+
+/**
+ * Blocks until an element is popped or until the TIME_UTC time point
+ * is reached.
+ *
+ * @return thrd_success on success, thrd_timedout if the time point
+ *    was reached, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_MpmcQueue_TimedPop(
+    struct Mdc_MpmcQueue* queue,
+    void* element,
+    const struct timespec* time_point
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_MPMC_QUEUE_H_ */
@@ -0,0 +1,167 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_MTX_H_
+#define MDC_C_CONCURRENCY_MTX_H_
+
+#include <stdio.h>
+
+#include "../std/stdint.h"
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_Mtx_kProfileHistogramBucketsCount = 32
+};
+
+/**
+ * Lock contention statistics of a profiled mutex. Histogram bucket i
+ * counts the durations from 2^i up to 2^(i + 1) nanoseconds, except
+ * that bucket 0 also counts durations under 1 nanosecond and the last
+ * bucket counts every longer duration. Only contended acquisitions
+ * have a wait time.
+ */
+struct Mdc_MtxProfileStats {
+  const char* name;
+
+  uint64_t acquisitions_count;
+  uint64_t contended_count;
+
+  uint64_t total_wait_nanoseconds;
+  uint64_t total_hold_nanoseconds;
+
+  uint64_t wait_histogram[Mdc_Mtx_kProfileHistogramBucketsCount];
+  uint64_t hold_histogram[Mdc_Mtx_kProfileHistogramBucketsCount];
+};
+
+/**
+ * Attempts to lock the mutex without blocking, retrying with a CPU
+ * pause hint up to the specified number of times while the mutex is
+ * held by another thread.
+ *
+ * @param mutex the mutex to lock
+ * @param spins the maximum number of retries after the first attempt
+ * @return thrd_success if locked, thrd_busy if the mutex remained
+ *    held, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Mtx_TryLockSpin(mtx_t* mutex, unsigned int spins);
+
+/**
+ * Returns the maximum number of CPU pause hints that a contended
+ * mtx_adaptive mutex spins for before it sleeps.
+ */
+DLLEXPORT unsigned int Mdc_Mtx_GetAdaptiveSpinLimit(void);
+
+/**
+ * Sets the maximum number of CPU pause hints that a contended
+ * mtx_adaptive mutex spins for before it sleeps. Each mutex spins
+ * for less when its recent acquisitions needed less. The limit
+ * applies to every adaptive mutex in the process, except for those
+ * backed by glibc's own adaptive mutex, which has its own tunable.
+ *
+ * @param spins the new limit, where 0 disables spinning
+ */
+DLLEXPORT void Mdc_Mtx_SetAdaptiveSpinLimit(unsigned int spins);
+
+/**
+ * Registers the mutex for lock contention profiling under the
+ * specified name. While profiling is enabled, mtx_lock, mtx_timedlock,
+ * mtx_trylock and mtx_unlock record how often the mutex is acquired,
+ * how often it was already held, how long threads waited for it, and
+ * how long it was held. mtx_destroy unregisters the mutex.
+ *
+ * Statistics are kept in per-thread shards that are only merged when
+ * read, so recording takes no lock. Profiling is unavailable when the
+ * compiler provides C11 threads.
+ *
+ * @param mutex the mutex to profile
+ * @param name the name used in reports, which must remain valid
+ *    while the mutex is registered
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error if the mutex is already registered or too many
+ *    mutexes are registered
+ */
+DLLEXPORT int Mdc_Mtx_RegisterProfile(mtx_t* mutex, const char* name);
+
+/**
+ * Unregisters the mutex from lock contention profiling, discarding
+ * its statistics. No other thread may use the mutex during the call.
+ */
+DLLEXPORT void Mdc_Mtx_UnregisterProfile(mtx_t* mutex);
+
+/**
+ * Returns nonzero if registered mutexes are being profiled.
+ */
+DLLEXPORT int Mdc_Mtx_IsProfilingEnabled(void);
+
+/**
+ * Starts or stops recording statistics for registered mutexes.
+ * Profiling is disabled by default. While it is disabled, locking or
+ * unlocking a mutex costs one extra atomic load.
+ */
+DLLEXPORT void Mdc_Mtx_SetProfilingEnabled(int is_enabled);
+
+/**
+ * Merges the statistics of a registered mutex.
+ *
+ * @return thrd_success on success, or thrd_error if the mutex is not
+ *    registered
+ */
+DLLEXPORT int Mdc_Mtx_GetProfileStats(
+    mtx_t* mutex,
+    struct Mdc_MtxProfileStats* stats
+);
+
+/**
+ * Zeroes the statistics of every registered mutex.
+ */
+DLLEXPORT void Mdc_Mtx_ResetProfiles(void);
+
+/**
+ * Writes a table of every registered mutex's statistics to the
+ * stream, sorted from the longest total wait time to the shortest.
+ * Wait and hold time percentiles are the upper bounds of their
+ * histogram buckets.
+ *
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error if writing failed
+ */
+DLLEXPORT int Mdc_Mtx_PrintProfileReport(FILE* stream);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_MTX_H_ */
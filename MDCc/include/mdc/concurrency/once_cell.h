@@ -0,0 +1,169 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_ONCE_CELL_H_
+#define MDC_C_CONCURRENCY_ONCE_CELL_H_
+
+#include <stddef.h>
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_OnceCell_kUninitialized = 0,
+  Mdc_OnceCell_kRunning = 1,
+  Mdc_OnceCell_kRunningWithWaiters = 2,
+  Mdc_OnceCell_kReady = 3
+};
+
+/**
+ * A value that is initialized exactly once by a user callback, then
+ * read without locking. Once the cell is ready, a read is a single
+ * acquire load of the state, which MDC_ONCE_CELL_GET performs in the
+ * caller. Threads that race with the initializer block until it is
+ * done. On Linux, the state is a futex word.
+ *
+ * A cell with static storage duration that is zero-initialized or
+ * initialized with MDC_ONCE_CELL_INIT is ready to use.
+ */
+
+struct Mdc_OnceCell {
+  int state_;
+  void* value_;
+};
+
+#define MDC_ONCE_CELL_INIT { Mdc_OnceCell_kUninitialized, NULL }
+
+DLLEXPORT void Mdc_OnceCell_Init(struct Mdc_OnceCell* cell);
+
+DLLEXPORT void Mdc_OnceCell_Deinit(struct Mdc_OnceCell* cell);
+
+/**
+ * Returns the value of the cell. If the cell is not ready, the
+ * callback is invoked with the context to produce the value, unless
+ * another thread is already doing so, in which case the calling
+ * thread blocks until it is done. If the callback returns NULL, the
+ * cell is left uninitialized so that a later call can try again.
+ * The callback must not get the value of the same cell.
+ *
+ * @param cell the cell to get the value of
+ * @param init the callback that produces the value
+ * @param context the argument passed to the callback
+ * @return the value of the cell, or NULL if the callback failed
+ */
+DLLEXPORT void* Mdc_OnceCell_Get(
+    struct Mdc_OnceCell* cell,
+    void* (*init)(void* context),
+    void* context
+);
+
+/**
+ * Returns the value of the cell if it is ready, or NULL otherwise.
+ * Never blocks.
+ */
+DLLEXPORT void* Mdc_OnceCell_TryGet(struct Mdc_OnceCell* cell);
+
+/**
+ * Returns nonzero if the cell is ready, or zero otherwise.
+ */
+DLLEXPORT int Mdc_OnceCell_IsReady(struct Mdc_OnceCell* cell);
+
+/**
+ * Claims the initialization of the cell. If another thread has
+ * claimed it, blocks until that thread commits or aborts. Returns
+ * nonzero if the calling thread must initialize the cell and then
+ * call either Mdc_OnceCell_CommitInit or Mdc_OnceCell_AbortInit, or
+ * zero if the cell is ready.
+ */
+DLLEXPORT int Mdc_OnceCell_BeginInit(struct Mdc_OnceCell* cell);
+
+/**
+ * Publishes the value of the cell and wakes the blocked threads.
+ */
+DLLEXPORT void Mdc_OnceCell_CommitInit(
+    struct Mdc_OnceCell* cell,
+    void* value
+);
+
+/**
+ * Returns the cell to the uninitialized state and wakes the blocked
+ * threads, one of which claims the initialization next.
+ */
+DLLEXPORT void Mdc_OnceCell_AbortInit(struct Mdc_OnceCell* cell);
+
+/*
+* The inline acquire load uses the compiler's builtins directly, so
+* that users of this header do not get the atomics polyfill. Other
+* compilers fall back to calling Mdc_OnceCell_IsReady.
+*/
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+
+/* Volatile reads have acquire semantics in MSVC on x86 and x64. */
+#define MDC_C_CONCURRENCY_ONCE_CELL_IS_READY_(cell) \
+    (*(volatile int*) &(cell)->state_ == Mdc_OnceCell_kReady)
+
+#elif defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+
+#define MDC_C_CONCURRENCY_ONCE_CELL_IS_READY_(cell) \
+    (__atomic_load_n(&(cell)->state_, __ATOMIC_ACQUIRE) \
+        == Mdc_OnceCell_kReady)
+
+#else
+
+#define MDC_C_CONCURRENCY_ONCE_CELL_IS_READY_(cell) \
+    (Mdc_OnceCell_IsReady(cell) != 0)
+
+#endif
+
+/**
+ * Checks whether the cell is ready like Mdc_OnceCell_IsReady, but
+ * inline where the compiler allows, so that it costs a single acquire
+ * load and no function call.
+ */
+#define MDC_ONCE_CELL_IS_READY(cell) \
+    MDC_C_CONCURRENCY_ONCE_CELL_IS_READY_(cell)
+
+/**
+ * Gets the value of the cell like Mdc_OnceCell_Get, but performs the
+ * ready check inline. The cell argument is evaluated more than once.
+ */
+#define MDC_ONCE_CELL_GET(cell, init, context) \
+    (MDC_ONCE_CELL_IS_READY(cell) \
+        ? (cell)->value_ \
+        : Mdc_OnceCell_Get((cell), (init), (context)))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_ONCE_CELL_H_ */
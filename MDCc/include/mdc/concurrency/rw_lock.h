@@ -0,0 +1,146 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_RW_LOCK_H_
+#define MDC_C_CONCURRENCY_RW_LOCK_H_
+
+#if defined(__GNUC__) && !defined(__MINGW32__)
+  #include <pthread.h>
+#endif
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * A reader-writer lock that allows any number of concurrent readers
+ * or a single writer. Writers are preferred: once a writer is
+ * waiting, new readers block until it has acquired and released the
+ * lock. The lock is not recursive.
+ */
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+struct Mdc_RwLock {
+  mtx_t mutex_;
+  cnd_t readers_cond_;
+  cnd_t writers_cond_;
+
+  unsigned int readers_count_;
+  unsigned int waiting_writers_count_;
+  int is_writer_active_;
+};
+
+#elif defined(__GNUC__)
+
+struct Mdc_RwLock {
+  pthread_rwlock_t rwlock_;
+};
+
+#endif
+
+/**
+ * Initializes the reader-writer lock.
+ *
+ * @param rw_lock the reader-writer lock to initialize
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_Init(struct Mdc_RwLock* rw_lock);
+
+DLLEXPORT void Mdc_RwLock_Deinit(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Blocks until the lock is acquired for shared reading.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_LockShared(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Acquires the lock for shared reading without blocking.
+ *
+ * @return thrd_success if acquired, thrd_busy if a writer holds or is
+ *    waiting for the lock, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_TryLockShared(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Blocks until the lock is acquired for shared reading or until the
+ * TIME_UTC time point is reached.
+ *
+ * @return thrd_success on success, thrd_timedout if the time point
+ *    was reached, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_TimedLockShared(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+);
+
+DLLEXPORT int Mdc_RwLock_UnlockShared(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Blocks until the lock is acquired for exclusive writing.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_Lock(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Acquires the lock for exclusive writing without blocking.
+ *
+ * @return thrd_success if acquired, thrd_busy if the lock is held, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_TryLock(struct Mdc_RwLock* rw_lock);
+
+/**
+ * Blocks until the lock is acquired for exclusive writing or until
+ * the TIME_UTC time point is reached.
+ *
+ * @return thrd_success on success, thrd_timedout if the time point
+ *    was reached, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_RwLock_TimedLock(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+);
+
+DLLEXPORT int Mdc_RwLock_Unlock(struct Mdc_RwLock* rw_lock);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_RW_LOCK_H_ */
@@ -0,0 +1,130 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_SEMAPHORE_H_
+#define MDC_C_CONCURRENCY_SEMAPHORE_H_
+
+#include <limits.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_Semaphore_kMaxCount = INT_MAX
+};
+
+/**
+ * A counting semaphore. Acquiring decrements the count, blocking
+ * while it is zero, and releasing increments it. On Linux, the count
+ * is a futex word, so uncontended operations never enter the kernel
+ * and a release only issues a wake when a thread is waiting.
+ */
+
+#if defined(__linux__)
+
+struct Mdc_Semaphore {
+  int count_;
+  int waiting_count_;
+};
+
+#else
+
+struct Mdc_Semaphore {
+  mtx_t mutex_;
+  cnd_t cond_;
+
+  int count_;
+  int waiting_count_;
+};
+
+#endif
+
+/**
+ * Initializes the semaphore.
+ *
+ * @param semaphore the semaphore to initialize
+ * @param count the initial count, between 0 and
+ *    Mdc_Semaphore_kMaxCount
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_Semaphore_Init(struct Mdc_Semaphore* semaphore, int count);
+
+DLLEXPORT void Mdc_Semaphore_Deinit(struct Mdc_Semaphore* semaphore);
+
+/**
+ * Blocks until the count is nonzero, then decrements it.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Semaphore_Acquire(struct Mdc_Semaphore* semaphore);
+
+/**
+ * Decrements the count without blocking.
+ *
+ * @return thrd_success if decremented, thrd_busy if the count is
+ *    zero, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Semaphore_TryAcquire(struct Mdc_Semaphore* semaphore);
+
+/**
+ * Blocks until the count is nonzero or until the TIME_UTC time point
+ * is reached. On success, the count is decremented.
+ *
+ * @return thrd_success on success, thrd_timedout if the time point
+ *    was reached, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Semaphore_TimedAcquire(
+    struct Mdc_Semaphore* semaphore,
+    const struct timespec* time_point
+);
+
+/**
+ * Increments the count by the specified amount, and unblocks up to
+ * that many waiting threads. The count must not exceed
+ * Mdc_Semaphore_kMaxCount.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Semaphore_Release(
+    struct Mdc_Semaphore* semaphore,
+    int count
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_SEMAPHORE_H_ */
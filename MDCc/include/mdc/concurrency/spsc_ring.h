@@ -0,0 +1,191 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_SPSC_RING_H_
+#define MDC_C_CONCURRENCY_SPSC_RING_H_
+
+#include <stddef.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_SpscRing_kCacheLineSize = 64
+};
+
+enum {
+  Mdc_SpscRing_kPlain = 0x0,
+  Mdc_SpscRing_kBlocking = 0x1
+};
+
+/**
+ * A bounded, lock-free ring buffer of fixed-size elements for one
+ * producer thread and one consumer thread. The producer's and the
+ * consumer's indices are kept on separate cache lines, along with
+ * each side's cached copy of the other's index, so that a handoff
+ * only touches the other side's line when the ring looks full or
+ * empty.
+ *
+ * A blocking ring can also wait for space or elements. The mutex and
+ * condition variables are only touched when a side is waiting.
+ */
+struct Mdc_SpscRing {
+  /* Written by the consumer. */
+  size_t head_;
+  size_t cached_tail_;
+  char head_padding_[Mdc_SpscRing_kCacheLineSize - 2 * sizeof(size_t)];
+
+  /* Written by the producer. */
+  size_t tail_;
+  size_t cached_head_;
+  char tail_padding_[Mdc_SpscRing_kCacheLineSize - 2 * sizeof(size_t)];
+
+  unsigned char* elements_;
+  size_t element_size_;
+  size_t mask_;
+
+  int flags_;
+  long is_consumer_waiting_;
+  long is_producer_waiting_;
+
+  mtx_t mutex_;
+  cnd_t not_empty_cond_;
+  cnd_t not_full_cond_;
+};
+
+/**
+ * Initializes the ring.
+ *
+ * @param ring the ring to initialize
+ * @param element_size the size of each element, in bytes
+ * @param capacity the minimum number of elements that the ring can
+ *    hold, which is rounded up to a power of two
+ * @param flags Mdc_SpscRing_kPlain, or Mdc_SpscRing_kBlocking to
+ *    allow the blocking functions
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure, including when the ring would be too large
+ *    to allocate
+ */
+DLLEXPORT int Mdc_SpscRing_Init(
+    struct Mdc_SpscRing* ring,
+    size_t element_size,
+    size_t capacity,
+    int flags
+);
+
+DLLEXPORT void Mdc_SpscRing_Deinit(struct Mdc_SpscRing* ring);
+
+DLLEXPORT size_t Mdc_SpscRing_GetCapacity(const struct Mdc_SpscRing* ring);
+
+/**
+ * Pushes as many of the elements as there is space for, without
+ * blocking. May only be called by the producer.
+ *
+ * @return the number of elements pushed
+ */
+DLLEXPORT size_t Mdc_SpscRing_TryPushBatch(
+    struct Mdc_SpscRing* ring,
+    const void* elements,
+    size_t count
+);
+
+/**
+ * Pops up to the specified number of elements, without blocking. May
+ * only be called by the consumer.
+ *
+ * @return the number of elements popped
+ */
+DLLEXPORT size_t Mdc_SpscRing_TryPopBatch(
+    struct Mdc_SpscRing* ring,
+    void* elements,
+    size_t max_count
+);
+
+/**
+ * Pushes one element without blocking.
+ *
+ * @return nonzero if pushed, or zero if the ring is full
+ */
+DLLEXPORT int Mdc_SpscRing_TryPush(
+    struct Mdc_SpscRing* ring,
+    const void* element
+);
+
+/**
+ * Pops one element without blocking.
+ *
+ * @return nonzero if popped, or zero if the ring is empty
+ */
+DLLEXPORT int Mdc_SpscRing_TryPop(struct Mdc_SpscRing* ring, void* element);
+
+/**
+ * Blocks until every element is pushed. The ring must have been
+ * initialized with Mdc_SpscRing_kBlocking.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_SpscRing_PushBatch(
+    struct Mdc_SpscRing* ring,
+    const void* elements,
+    size_t count
+);
+
+/**
+ * Blocks until at least one element is available, then pops up to
+ * the specified number of elements. The ring must have been
+ * initialized with Mdc_SpscRing_kBlocking.
+ *
+ * @param popped_count receives the number of elements popped
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_SpscRing_PopBatch(
+    struct Mdc_SpscRing* ring,
+    void* elements,
+    size_t max_count,
+    size_t* popped_count
+);
+
+DLLEXPORT int Mdc_SpscRing_Push(
+    struct Mdc_SpscRing* ring,
+    const void* element
+);
+
+DLLEXPORT int Mdc_SpscRing_Pop(struct Mdc_SpscRing* ring, void* element);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_SPSC_RING_H_ */
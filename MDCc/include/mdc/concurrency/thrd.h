@@ -0,0 +1,136 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_THRD_H_
+#define MDC_C_CONCURRENCY_THRD_H_
+
+#include <stddef.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Attributes applied to a thread when it is created. Zero or NULL
+ * fields keep the platform default.
+ */
+struct Mdc_ThrdAttributes {
+  /**
+   * The stack size in bytes, or 0 for the platform default. Sizes
+   * below the platform minimum are raised to the minimum.
+   */
+  size_t stack_size;
+
+  /**
+   * The thread name shown in debuggers and profilers, or NULL. Linux
+   * truncates names to 15 characters.
+   */
+  const char* name;
+
+  /**
+   * The set of CPUs the thread may run on, where bit N refers to
+   * CPU N, or 0 to allow every CPU.
+   */
+  size_t affinity_mask;
+};
+
+/**
+ * Initializes the thread attributes to the platform defaults.
+ *
+ * @param attributes the thread attributes to initialize
+ */
+DLLEXPORT void Mdc_ThrdAttributes_Init(
+    struct Mdc_ThrdAttributes* attributes
+);
+
+/**
+ * Creates a new thread that executes the function with the specified
+ * argument, applying the thread attributes. The stack size and CPU
+ * affinity are applied before the thread starts running.
+ *
+ * @param thr the destination thread identifier
+ * @param func the function to execute
+ * @param arg the argument passed to the function
+ * @param attributes the thread attributes, or NULL for the defaults
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_Thrd_CreateEx(
+    thrd_t* thr,
+    thrd_start_t func,
+    void* arg,
+    const struct Mdc_ThrdAttributes* attributes
+);
+
+/**
+ * Returns a number that identifies the thread among all running
+ * threads. On Windows versions before Vista, the ID of a thread other
+ * than the calling thread cannot be queried, and 0 is returned.
+ *
+ * @param thr the thread identifier
+ * @return the ID of the thread, or 0 if unavailable
+ */
+DLLEXPORT unsigned long Mdc_Thrd_GetId(thrd_t thr);
+
+/**
+ * Returns the ID of the calling thread, which is never 0 and is the
+ * value that Mdc_Thrd_GetId returns for the thread.
+ */
+DLLEXPORT unsigned long Mdc_Thrd_GetCurrentId(void);
+
+/**
+ * Returns the number of processors that are online, which is at
+ * least 1.
+ */
+DLLEXPORT size_t Mdc_Thrd_GetHardwareConcurrency(void);
+
+/**
+ * Sleeps for the specified duration with microsecond accuracy. The
+ * thread sleeps through the bulk of the duration in one call, then
+ * spin-waits on a monotonic clock for the final stretch to absorb
+ * the wakeup latency of the scheduler. The spin margin starts at a
+ * platform default and grows to the largest oversleep seen, up to a
+ * small cap, so a coarse system timer costs some CPU time rather than
+ * accuracy. Where thread-local storage is available, the margin
+ * carries over to the next call on the same thread and slowly decays.
+ *
+ * @param duration the time to sleep for
+ */
+DLLEXPORT void Mdc_Thrd_PreciseSleep(const struct timespec* duration);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_THRD_H_ */
@@ -0,0 +1,59 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_THREAD_LOCAL_H_
+#define MDC_C_CONCURRENCY_THREAD_LOCAL_H_
+
+/**
+ * Storage-class specifier for variables with thread storage duration.
+ * Each thread sees its own instance of the variable, which is reached
+ * without any locking or function call. MDC_HAS_THREAD_LOCAL is
+ * defined when the compiler provides the specifier; otherwise, use
+ * tss_t instead.
+ *
+ * Variables declared with MSVC's __declspec(thread) are not allocated
+ * for DLLs loaded with LoadLibrary on Windows versions older than
+ * Vista.
+ */
+
+#if __STDC_VERSION__ >= 201112L
+  #define MDC_THREAD_LOCAL _Thread_local
+  #define MDC_HAS_THREAD_LOCAL
+#elif __cplusplus >= 201103L || _MSVC_LANG >= 201103L
+  #define MDC_THREAD_LOCAL thread_local
+  #define MDC_HAS_THREAD_LOCAL
+#elif defined(_MSC_VER)
+  #define MDC_THREAD_LOCAL __declspec(thread)
+  #define MDC_HAS_THREAD_LOCAL
+#elif defined(__GNUC__)
+  #define MDC_THREAD_LOCAL __thread
+  #define MDC_HAS_THREAD_LOCAL
+#endif
+
+#endif /* MDC_C_CONCURRENCY_THREAD_LOCAL_H_ */
@@ -0,0 +1,146 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_THREAD_POOL_H_
+#define MDC_C_CONCURRENCY_THREAD_POOL_H_
+
+#include <stddef.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * A unit of work executed by a thread pool worker.
+ */
+struct Mdc_ThreadPoolTask {
+  void (*func)(void* arg);
+  void* arg;
+};
+
+struct Mdc_ThreadPoolWorker;
+
+/**
+ * A fixed set of worker threads that execute submitted tasks. Each
+ * worker owns a Chase-Lev deque. Tasks submitted from a worker go to
+ * the back of its own deque and are taken from there in LIFO order.
+ * Idle workers steal from the front of a randomly chosen victim's
+ * deque. Tasks submitted from other threads, or that do not fit in a
+ * full deque, go to a shared injection queue.
+ */
+struct Mdc_ThreadPool {
+  struct Mdc_ThreadPoolWorker* workers_;
+  size_t workers_count_;
+
+  mtx_t mutex_;
+  cnd_t work_cond_;
+  cnd_t idle_cond_;
+
+  struct Mdc_ThreadPoolTask* injected_tasks_;
+  size_t injected_capacity_;
+  size_t injected_front_;
+  long injected_count_;
+
+  long pending_count_;
+  long work_epoch_;
+  long sleepers_count_;
+  long is_stopping_;
+};
+
+/**
+ * Initializes a thread pool and starts its worker threads.
+ *
+ * @param pool the thread pool to initialize
+ * @param workers_count the number of worker threads, or 0 to use one
+ *    worker per processor
+ * @return thrd_success on success, thrd_nomem if out of memory, or
+ *    thrd_error on failure
+ */
+DLLEXPORT int Mdc_ThreadPool_Init(
+    struct Mdc_ThreadPool* pool,
+    size_t workers_count
+);
+
+/**
+ * Waits for every submitted task to finish, then stops the worker
+ * threads and releases the thread pool's resources.
+ *
+ * @param pool the thread pool to deinitialize
+ */
+DLLEXPORT void Mdc_ThreadPool_Deinit(struct Mdc_ThreadPool* pool);
+
+/**
+ * Submits a task to the thread pool.
+ *
+ * @param pool the thread pool
+ * @param func the function to execute
+ * @param arg the argument passed to the function
+ * @return thrd_success on success, or thrd_nomem if out of memory
+ */
+DLLEXPORT int Mdc_ThreadPool_Submit(
+    struct Mdc_ThreadPool* pool,
+    void (*func)(void* arg),
+    void* arg
+);
+
+/**
+ * Submits multiple tasks to the thread pool, waking idle workers
+ * once for the whole batch. Either every task is submitted or none
+ * are.
+ *
+ * @param pool the thread pool
+ * @param tasks the tasks to submit
+ * @param count the number of tasks
+ * @return thrd_success on success, or thrd_nomem if out of memory
+ */
+DLLEXPORT int Mdc_ThreadPool_SubmitBatch(
+    struct Mdc_ThreadPool* pool,
+    const struct Mdc_ThreadPoolTask* tasks,
+    size_t count
+);
+
+/**
+ * Blocks until every submitted task, including tasks submitted by
+ * other tasks, has finished executing. Must not be called from a
+ * task.
+ *
+ * @param pool the thread pool
+ */
+DLLEXPORT void Mdc_ThreadPool_WaitIdle(struct Mdc_ThreadPool* pool);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_CONCURRENCY_THREAD_POOL_H_ */
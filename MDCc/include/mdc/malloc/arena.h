@@ -0,0 +1,141 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_MALLOC_ARENA_H_
+#define MDC_C_MALLOC_ARENA_H_
+
+#include <stddef.h>
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  Mdc_Arena_kDefaultBlockSize = 64 * 1024
+};
+
+/**
+ * A bump-pointer region allocator. Allocations are carved out of a
+ * chain of blocks and are never freed individually. Instead, the
+ * arena is rewound to a mark or reset, both in constant time. Blocks
+ * are kept for reuse until the arena is deinitialized. The arena is
+ * not thread-safe.
+ */
+
+struct Mdc_ArenaBlock;
+
+struct Mdc_Arena {
+  struct Mdc_ArenaBlock* first_block_;
+  struct Mdc_ArenaBlock* current_block_;
+
+  unsigned char* position_;
+  unsigned char* end_;
+
+  size_t block_size_;
+};
+
+/**
+ * A checkpoint of an arena's position. Rewinding to it frees every
+ * allocation made since it was taken.
+ */
+struct Mdc_ArenaMark {
+  struct Mdc_ArenaBlock* block_;
+  unsigned char* position_;
+};
+
+/**
+ * Initializes the arena. No memory is allocated until the first
+ * allocation.
+ *
+ * @param arena the arena to initialize
+ * @param block_size the usable size of each block, or 0 for
+ *    Mdc_Arena_kDefaultBlockSize. Larger allocations get a block of
+ *    their own.
+ */
+DLLEXPORT void Mdc_Arena_Init(struct Mdc_Arena* arena, size_t block_size);
+
+/**
+ * Frees every block of the arena.
+ */
+DLLEXPORT void Mdc_Arena_Deinit(struct Mdc_Arena* arena);
+
+/**
+ * Allocates memory that is suitably aligned for any type, like
+ * malloc.
+ *
+ * @return the allocated memory, or NULL if out of memory
+ */
+DLLEXPORT void* Mdc_Arena_Allocate(struct Mdc_Arena* arena, size_t size);
+
+/**
+ * Allocates memory with the specified alignment, which must be a power
+ * of two.
+ *
+ * @return the allocated memory, or NULL if out of memory or if the
+ *    alignment is not a power of two
+ */
+DLLEXPORT void* Mdc_Arena_AllocateAligned(
+    struct Mdc_Arena* arena,
+    size_t size,
+    size_t alignment
+);
+
+/**
+ * Records the current position of the arena.
+ *
+ * @param arena the arena
+ * @param mark the destination mark
+ */
+DLLEXPORT void Mdc_Arena_GetMark(
+    const struct Mdc_Arena* arena,
+    struct Mdc_ArenaMark* mark
+);
+
+/**
+ * Frees every allocation made since the mark was taken. Marks taken
+ * after this one become invalid.
+ */
+DLLEXPORT void Mdc_Arena_Rewind(
+    struct Mdc_Arena* arena,
+    const struct Mdc_ArenaMark* mark
+);
+
+/**
+ * Frees every allocation of the arena. The blocks are kept for reuse.
+ */
+DLLEXPORT void Mdc_Arena_Reset(struct Mdc_Arena* arena);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_MALLOC_ARENA_H_ */
@@ -33,34 +33,128 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include "../std/stdint.h"
+
 #include "../../../dllexport_define.inc"
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-#if defined(NDEBUG)
+/**
+ * Allocation accounting. Every block carries a small header that
+ * records its size, so that the number of bytes can be tracked on
+ * free. Counters are sharded per thread and merged on read. The
+ * accounting is enabled by default in debug builds and disabled in
+ * release builds, and can be switched at runtime in both. Blocks
+ * allocated while it is disabled are never counted, even if they are
+ * freed after it is enabled.
+ */
+
+struct Mdc_MallocStats {
+  uint64_t malloc_count;
+  uint64_t free_count;
+
+  /* The totals over every counted allocation and free. */
+  uint64_t allocated_bytes;
+  uint64_t freed_bytes;
 
-#define Mdc_malloc(size) malloc(size)
-#define Mdc_calloc(num, size) calloc(num, size)
-#define Mdc_realloc(ptr, new_size) realloc(ptr, new_size)
-#define Mdc_free(ptr) free(ptr)
+  size_t current_bytes;
 
-#define Mdc_GetMallocDifference() 0
-#define Mdc_PrintMallocLeaks()
+  /*
+  * The highest number of bytes in use at once. Threads publish their
+  * byte counts in batches, so the peak may miss short spikes of up to
+  * Mdc_Malloc_kPeakGranularityBytes per thread.
+  */
+  size_t peak_bytes;
+};
+
+enum {
+  Mdc_Malloc_kPeakGranularityBytes = 64 * 1024
+};
+
+/**
+ * The functions through which every MDC allocation reaches the
+ * underlying allocator. Each function receives the context. The
+ * aligned functions may both be NULL, in which case aligned blocks
+ * are carved out of larger blocks from malloc_func.
+ */
+struct Mdc_AllocatorVTable {
+  void* (*malloc_func)(void* context, size_t size);
+  void* (*calloc_func)(void* context, size_t num, size_t size);
+  void* (*realloc_func)(void* context, void* ptr, size_t new_size);
+  void (*free_func)(void* context, void* ptr);
 
-#else
+  /* The alignment is a power of two. */
+  void* (*aligned_alloc_func)(void* context, size_t size, size_t alignment);
+  void (*aligned_free_func)(void* context, void* ptr);
+
+  void* context;
+};
 
 DLLEXPORT void* Mdc_malloc(size_t size);
 DLLEXPORT void* Mdc_calloc(size_t num, size_t size);
 DLLEXPORT void* Mdc_realloc(void* ptr, size_t new_size);
 DLLEXPORT void Mdc_free(void* ptr);
 
+/**
+ * Allocates a block with the specified alignment. The block may be
+ * freed with either Mdc_AlignedFree or Mdc_free, but cannot be passed
+ * to Mdc_realloc.
+ *
+ * @param alignment the alignment, which must be a power of two
+ * @param size the size of the block
+ * @return the allocated block, or NULL if out of memory or if the
+ *    alignment is not a power of two
+ */
+DLLEXPORT void* Mdc_AlignedAlloc(size_t alignment, size_t size);
+
+DLLEXPORT void Mdc_AlignedFree(void* ptr);
+
+/**
+ * Frees a block whose size is known to the caller. Debug builds
+ * assert that the size matches the size the block was allocated
+ * with.
+ */
+DLLEXPORT void Mdc_FreeSized(void* ptr, size_t size);
+
+/**
+ * Returns the number of bytes that can be used in the block, which is
+ * the size it was allocated or reallocated with, or 0 if the block is
+ * NULL.
+ */
+DLLEXPORT size_t Mdc_AllocUsableSize(const void* ptr);
+
+/**
+ * Replaces the allocator used by every later MDC allocation, in both
+ * debug and release builds. The allocator can be replaced at any
+ * time, since every block remembers the allocator that allocated it,
+ * and is reallocated and freed through that allocator. A vtable must
+ * outlive every block that it allocated.
+ *
+ * @param vtable the new allocator, or NULL to restore the default
+ *    allocator, which uses the C library
+ */
+DLLEXPORT void Mdc_SetAllocator(const struct Mdc_AllocatorVTable* vtable);
+
+/**
+ * Returns the allocator used by every MDC allocation.
+ */
+DLLEXPORT const struct Mdc_AllocatorVTable* Mdc_GetAllocator(void);
+
+DLLEXPORT int Mdc_IsMallocAccountingEnabled(void);
+DLLEXPORT void Mdc_SetMallocAccountingEnabled(int is_enabled);
+
+/**
+ * Merges the counters of every thread into the stats.
+ *
+ * @param stats the destination stats
+ */
+DLLEXPORT void Mdc_GetMallocStats(struct Mdc_MallocStats* stats);
+
 DLLEXPORT int Mdc_GetMallocDifference(void);
 DLLEXPORT void Mdc_PrintMallocLeaks(void);
 
-#endif
-
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
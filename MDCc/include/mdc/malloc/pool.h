@@ -0,0 +1,128 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_MALLOC_POOL_H_
+#define MDC_C_MALLOC_POOL_H_
+
+#include <stddef.h>
+
+#include "../std/threads.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+enum {
+  /* The number of objects moved between a thread and the depot. */
+  Mdc_Pool_kMagazineCapacity = 32,
+
+  Mdc_Pool_kSlabSize = 64 * 1024
+};
+
+/**
+ * A thread-safe allocator of fixed-size objects. Objects are carved
+ * out of slabs into cache-line-aligned slots, so that objects used by
+ * different threads never share a cache line. Each thread caches
+ * freed objects in two magazines of up to Mdc_Pool_kMagazineCapacity
+ * objects, and only locks the pool to exchange a whole magazine with
+ * the shared depot. Slabs are kept until the pool is deinitialized.
+ *
+ * If malloc accounting is enabled when the pool is initialized, each
+ * object allocated from it is counted as a malloc of the object size,
+ * and each object freed to it as a free.
+ */
+
+struct Mdc_PoolSlab;
+struct Mdc_PoolSlot;
+struct Mdc_PoolCache;
+
+struct Mdc_Pool {
+  size_t object_size_;
+  size_t slot_size_;
+  size_t slots_per_slab_;
+  int is_counted_;
+
+  tss_t cache_key_;
+
+  mtx_t mutex_;
+
+  /* Guarded by the mutex. */
+  struct Mdc_PoolSlab* slabs_;
+  unsigned char* carve_position_;
+  size_t carve_slots_count_;
+  struct Mdc_PoolSlot* depot_;
+  struct Mdc_PoolCache* caches_;
+};
+
+/**
+ * Initializes a pool. No slab is allocated until the first
+ * allocation.
+ *
+ * @param pool the pool to initialize
+ * @param object_size the size of every object
+ * @return thrd_success on success, or thrd_error on failure
+ */
+DLLEXPORT int Mdc_Pool_Init(struct Mdc_Pool* pool, size_t object_size);
+
+/**
+ * Releases every slab of the pool, along with the objects cached by
+ * every thread. No thread may use the pool or its objects afterwards.
+ *
+ * @param pool the pool to deinitialize
+ */
+DLLEXPORT void Mdc_Pool_Deinit(struct Mdc_Pool* pool);
+
+/**
+ * Allocates an object from the pool.
+ *
+ * @return the allocated object, or NULL if out of memory
+ */
+DLLEXPORT void* Mdc_Pool_Allocate(struct Mdc_Pool* pool);
+
+/**
+ * Frees an object to the pool that allocated it. Any thread may free
+ * the object. Does nothing if the object is NULL.
+ */
+DLLEXPORT void Mdc_Pool_Free(struct Mdc_Pool* pool, void* ptr);
+
+/**
+ * Returns the objects cached by the calling thread to the depot, so
+ * that other threads can allocate them. This happens automatically
+ * when the thread exits.
+ */
+DLLEXPORT void Mdc_Pool_FlushThreadCache(struct Mdc_Pool* pool);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_MALLOC_POOL_H_ */
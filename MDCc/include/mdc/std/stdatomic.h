@@ -0,0 +1,542 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_STD_STDATOMIC_H_
+#define MDC_C_STD_STDATOMIC_H_
+
+/*
+* C++ has atomics of its own, so C++ translation units never get the
+* C11 names. C++11 gets <atomic>, and C++98 only gets the MDC_ and
+* Mdc_ prefixed polyfill that the std::atomic polyfill is built on.
+*/
+#if defined(__cplusplus) \
+    && (__cplusplus >= 201103L || _MSVC_LANG >= 201103L)
+
+#include <atomic>
+
+#elif !defined(__cplusplus) \
+    && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+#else
+
+#include <stddef.h>
+
+#include "stdint.h"
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Order and consistency
+ */
+
+#if defined(__ATOMIC_RELAXED)
+
+enum Mdc_MemoryOrder {
+  Mdc_MemoryOrder_kRelaxed = __ATOMIC_RELAXED,
+  Mdc_MemoryOrder_kConsume = __ATOMIC_CONSUME,
+  Mdc_MemoryOrder_kAcquire = __ATOMIC_ACQUIRE,
+  Mdc_MemoryOrder_kRelease = __ATOMIC_RELEASE,
+  Mdc_MemoryOrder_kAcqRel = __ATOMIC_ACQ_REL,
+  Mdc_MemoryOrder_kSeqCst = __ATOMIC_SEQ_CST
+};
+
+#else
+
+enum Mdc_MemoryOrder {
+  Mdc_MemoryOrder_kRelaxed,
+  Mdc_MemoryOrder_kConsume,
+  Mdc_MemoryOrder_kAcquire,
+  Mdc_MemoryOrder_kRelease,
+  Mdc_MemoryOrder_kAcqRel,
+  Mdc_MemoryOrder_kSeqCst
+};
+
+#endif
+
+/**
+ * Fences
+ */
+
+DLLEXPORT void Mdc_Atomic_ThreadFence(enum Mdc_MemoryOrder order);
+DLLEXPORT void Mdc_Atomic_SignalFence(enum Mdc_MemoryOrder order);
+
+#if defined(_MSC_VER)
+
+/*
+* MSVC has no generic atomic builtins, so each operation selects the
+* 32-bit or 64-bit interlocked function by the size of the object.
+* Volatile accesses have acquire and release semantics in MSVC on x86
+* and x64, and every read-modify-write operation is a full barrier.
+* On x64, results are widened to __int64 and should be cast back to
+* the type of the object.
+*/
+
+DLLEXPORT long Mdc_Atomic_Exchange32(volatile long* obj, long desired);
+DLLEXPORT int Mdc_Atomic_CompareExchange32(
+    volatile long* obj,
+    long* expected,
+    long desired
+);
+DLLEXPORT long Mdc_Atomic_FetchAdd32(volatile long* obj, long arg);
+DLLEXPORT long Mdc_Atomic_FetchOr32(volatile long* obj, long arg);
+DLLEXPORT long Mdc_Atomic_FetchAnd32(volatile long* obj, long arg);
+DLLEXPORT long Mdc_Atomic_FetchXor32(volatile long* obj, long arg);
+
+#if defined(_WIN64)
+
+DLLEXPORT __int64 Mdc_Atomic_Exchange64(
+    volatile __int64* obj,
+    __int64 desired
+);
+DLLEXPORT int Mdc_Atomic_CompareExchange64(
+    volatile __int64* obj,
+    __int64* expected,
+    __int64 desired
+);
+DLLEXPORT __int64 Mdc_Atomic_FetchAdd64(volatile __int64* obj, __int64 arg);
+DLLEXPORT __int64 Mdc_Atomic_FetchOr64(volatile __int64* obj, __int64 arg);
+DLLEXPORT __int64 Mdc_Atomic_FetchAnd64(volatile __int64* obj, __int64 arg);
+DLLEXPORT __int64 Mdc_Atomic_FetchXor64(volatile __int64* obj, __int64 arg);
+
+#define MDC_C_STD_STDATOMIC_SELECT_(obj, op32, op64) \
+    (sizeof(*(obj)) == 8 ? (op64) : (op32))
+
+#else
+
+#define MDC_C_STD_STDATOMIC_SELECT_(obj, op32, op64) (op32)
+
+#endif /* defined(_WIN64) */
+
+#define MDC_C_STD_STDATOMIC_RMW_(func, obj, arg) \
+    MDC_C_STD_STDATOMIC_SELECT_( \
+        obj, \
+        Mdc_Atomic_##func##32( \
+            (volatile long*) (obj), \
+            (long) (intptr_t) (arg) \
+        ), \
+        Mdc_Atomic_##func##64( \
+            (volatile __int64*) (obj), \
+            (__int64) (arg) \
+        ) \
+    )
+
+#define MDC_ATOMIC_LOAD_EXPLICIT(obj, order) \
+    MDC_C_STD_STDATOMIC_SELECT_( \
+        obj, \
+        *(volatile long*) (obj), \
+        *(volatile __int64*) (obj) \
+    )
+#define MDC_ATOMIC_STORE_EXPLICIT(obj, desired, order) \
+    ((void) MDC_C_STD_STDATOMIC_RMW_(Exchange, obj, desired))
+#define MDC_ATOMIC_EXCHANGE_EXPLICIT(obj, desired, order) \
+    MDC_C_STD_STDATOMIC_RMW_(Exchange, obj, desired)
+#define MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    MDC_C_STD_STDATOMIC_SELECT_( \
+        obj, \
+        Mdc_Atomic_CompareExchange32( \
+            (volatile long*) (obj), \
+            (long*) (expected), \
+            (long) (intptr_t) (desired) \
+        ), \
+        Mdc_Atomic_CompareExchange64( \
+            (volatile __int64*) (obj), \
+            (__int64*) (expected), \
+            (__int64) (desired) \
+        ) \
+    )
+#define MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+        obj, \
+        expected, \
+        desired, \
+        success, \
+        failure \
+    )
+#define MDC_ATOMIC_FETCH_ADD_EXPLICIT(obj, arg, order) \
+    MDC_C_STD_STDATOMIC_RMW_(FetchAdd, obj, arg)
+#define MDC_ATOMIC_FETCH_SUB_EXPLICIT(obj, arg, order) \
+    MDC_C_STD_STDATOMIC_RMW_(FetchAdd, obj, -(intptr_t) (arg))
+#define MDC_ATOMIC_FETCH_OR_EXPLICIT(obj, arg, order) \
+    MDC_C_STD_STDATOMIC_RMW_(FetchOr, obj, arg)
+#define MDC_ATOMIC_FETCH_AND_EXPLICIT(obj, arg, order) \
+    MDC_C_STD_STDATOMIC_RMW_(FetchAnd, obj, arg)
+#define MDC_ATOMIC_FETCH_XOR_EXPLICIT(obj, arg, order) \
+    MDC_C_STD_STDATOMIC_RMW_(FetchXor, obj, arg)
+
+struct Mdc_AtomicFlag {
+  volatile long value_;
+};
+
+#define MDC_ATOMIC_FLAG_TEST_AND_SET_EXPLICIT(obj, order) \
+    (Mdc_Atomic_Exchange32(&(obj)->value_, 1) != 0)
+#define MDC_ATOMIC_FLAG_CLEAR_EXPLICIT(obj, order) \
+    ((void) Mdc_Atomic_Exchange32(&(obj)->value_, 0))
+
+#elif defined(__GNUC__) && defined(__ATOMIC_RELAXED)
+
+#define MDC_ATOMIC_LOAD_EXPLICIT(obj, order) \
+    __atomic_load_n((obj), (order))
+#define MDC_ATOMIC_STORE_EXPLICIT(obj, desired, order) \
+    __atomic_store_n((obj), (desired), (order))
+#define MDC_ATOMIC_EXCHANGE_EXPLICIT(obj, desired, order) \
+    __atomic_exchange_n((obj), (desired), (order))
+#define MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    __atomic_compare_exchange_n( \
+        (obj), \
+        (expected), \
+        (desired), \
+        0, \
+        (success), \
+        (failure) \
+    )
+#define MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    __atomic_compare_exchange_n( \
+        (obj), \
+        (expected), \
+        (desired), \
+        1, \
+        (success), \
+        (failure) \
+    )
+#define MDC_ATOMIC_FETCH_ADD_EXPLICIT(obj, arg, order) \
+    __atomic_fetch_add((obj), (arg), (order))
+#define MDC_ATOMIC_FETCH_SUB_EXPLICIT(obj, arg, order) \
+    __atomic_fetch_sub((obj), (arg), (order))
+#define MDC_ATOMIC_FETCH_OR_EXPLICIT(obj, arg, order) \
+    __atomic_fetch_or((obj), (arg), (order))
+#define MDC_ATOMIC_FETCH_AND_EXPLICIT(obj, arg, order) \
+    __atomic_fetch_and((obj), (arg), (order))
+#define MDC_ATOMIC_FETCH_XOR_EXPLICIT(obj, arg, order) \
+    __atomic_fetch_xor((obj), (arg), (order))
+
+struct Mdc_AtomicFlag {
+  volatile unsigned char value_;
+};
+
+#define MDC_ATOMIC_FLAG_TEST_AND_SET_EXPLICIT(obj, order) \
+    __atomic_test_and_set(&(obj)->value_, (order))
+#define MDC_ATOMIC_FLAG_CLEAR_EXPLICIT(obj, order) \
+    __atomic_clear(&(obj)->value_, (order))
+
+#elif defined(__GNUC__)
+
+/*
+* GCC before 4.7 only has the __sync builtins, which are all full
+* barriers. The memory order arguments are ignored.
+*/
+
+#define MDC_ATOMIC_LOAD_EXPLICIT(obj, order) \
+    __extension__ ({ \
+      __typeof__(*(obj)) mdc_value_ = (__sync_synchronize(), *(obj)); \
+      __sync_synchronize(); \
+\
+      mdc_value_; \
+    })
+#define MDC_ATOMIC_STORE_EXPLICIT(obj, desired, order) \
+    ((void) MDC_ATOMIC_EXCHANGE_EXPLICIT((obj), (desired), (order)))
+#define MDC_ATOMIC_EXCHANGE_EXPLICIT(obj, desired, order) \
+    __extension__ ({ \
+      __typeof__(obj) mdc_obj_ = (obj); \
+      __typeof__(*mdc_obj_) mdc_desired_ = (desired); \
+      __typeof__(*mdc_obj_) mdc_old_; \
+\
+      do { \
+        mdc_old_ = *mdc_obj_; \
+      } while (!__sync_bool_compare_and_swap( \
+          mdc_obj_, \
+          mdc_old_, \
+          mdc_desired_ \
+      )); \
+\
+      mdc_old_; \
+    })
+#define MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    __extension__ ({ \
+      __typeof__(expected) mdc_expected_ = (expected); \
+      __typeof__(*mdc_expected_) mdc_old_ = __sync_val_compare_and_swap( \
+          (obj), \
+          *mdc_expected_, \
+          (desired) \
+      ); \
+      int mdc_is_success_ = (mdc_old_ == *mdc_expected_); \
+\
+      if (!mdc_is_success_) { \
+        *mdc_expected_ = mdc_old_; \
+      } \
+\
+      mdc_is_success_; \
+    })
+#define MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+        obj, \
+        expected, \
+        desired, \
+        success, \
+        failure \
+    )
+#define MDC_ATOMIC_FETCH_ADD_EXPLICIT(obj, arg, order) \
+    __sync_fetch_and_add((obj), (arg))
+#define MDC_ATOMIC_FETCH_SUB_EXPLICIT(obj, arg, order) \
+    __sync_fetch_and_sub((obj), (arg))
+#define MDC_ATOMIC_FETCH_OR_EXPLICIT(obj, arg, order) \
+    __sync_fetch_and_or((obj), (arg))
+#define MDC_ATOMIC_FETCH_AND_EXPLICIT(obj, arg, order) \
+    __sync_fetch_and_and((obj), (arg))
+#define MDC_ATOMIC_FETCH_XOR_EXPLICIT(obj, arg, order) \
+    __sync_fetch_and_xor((obj), (arg))
+
+struct Mdc_AtomicFlag {
+  volatile unsigned char value_;
+};
+
+#define MDC_ATOMIC_FLAG_TEST_AND_SET_EXPLICIT(obj, order) \
+    (__sync_synchronize(), \
+        __sync_lock_test_and_set(&(obj)->value_, 1) != 0)
+#define MDC_ATOMIC_FLAG_CLEAR_EXPLICIT(obj, order) \
+    (__sync_lock_release(&(obj)->value_), __sync_synchronize())
+
+#endif
+
+#define MDC_ATOMIC_FLAG_INIT { 0 }
+
+/*
+* The C11 names, which C++ must not see because they collide with
+* its own atomics.
+*/
+#if !defined(__cplusplus)
+
+/**
+ * Order and consistency
+ */
+
+typedef enum Mdc_MemoryOrder memory_order;
+
+#define memory_order_relaxed Mdc_MemoryOrder_kRelaxed
+#define memory_order_consume Mdc_MemoryOrder_kConsume
+#define memory_order_acquire Mdc_MemoryOrder_kAcquire
+#define memory_order_release Mdc_MemoryOrder_kRelease
+#define memory_order_acq_rel Mdc_MemoryOrder_kAcqRel
+#define memory_order_seq_cst Mdc_MemoryOrder_kSeqCst
+
+#define kill_dependency(y) (y)
+
+/**
+ * Lock-free property
+ */
+
+#define ATOMIC_BOOL_LOCK_FREE 2
+#define ATOMIC_INT_LOCK_FREE 2
+#define ATOMIC_LONG_LOCK_FREE 2
+#define ATOMIC_POINTER_LOCK_FREE 2
+
+#define atomic_is_lock_free(obj) 1
+
+/**
+ * Atomic integer types. C90 has no _Atomic qualifier, so these are
+ * volatile integers that must only be accessed through the functions
+ * below. Only 32-bit and 64-bit widths are provided, because those
+ * are the widths that the Windows interlocked functions support.
+ */
+
+typedef volatile int atomic_bool;
+typedef volatile int atomic_int;
+typedef volatile unsigned int atomic_uint;
+typedef volatile long atomic_long;
+typedef volatile unsigned long atomic_ulong;
+typedef volatile intptr_t atomic_intptr_t;
+typedef volatile uintptr_t atomic_uintptr_t;
+typedef volatile size_t atomic_size_t;
+typedef volatile ptrdiff_t atomic_ptrdiff_t;
+
+#define ATOMIC_VAR_INIT(value) (value)
+#define atomic_init(obj, value) ((void) (*(obj) = (value)))
+
+/**
+ * Fences
+ */
+
+#define atomic_thread_fence(order) Mdc_Atomic_ThreadFence(order)
+#define atomic_signal_fence(order) Mdc_Atomic_SignalFence(order)
+
+/**
+ * Operations on atomic types
+ */
+
+#define atomic_load_explicit(obj, order) \
+    MDC_ATOMIC_LOAD_EXPLICIT(obj, order)
+#define atomic_store_explicit(obj, desired, order) \
+    MDC_ATOMIC_STORE_EXPLICIT(obj, desired, order)
+#define atomic_exchange_explicit(obj, desired, order) \
+    MDC_ATOMIC_EXCHANGE_EXPLICIT(obj, desired, order)
+#define atomic_compare_exchange_strong_explicit( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT( \
+        obj, \
+        expected, \
+        desired, \
+        success, \
+        failure \
+    )
+#define atomic_compare_exchange_weak_explicit( \
+    obj, \
+    expected, \
+    desired, \
+    success, \
+    failure \
+) \
+    MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT( \
+        obj, \
+        expected, \
+        desired, \
+        success, \
+        failure \
+    )
+#define atomic_fetch_add_explicit(obj, arg, order) \
+    MDC_ATOMIC_FETCH_ADD_EXPLICIT(obj, arg, order)
+#define atomic_fetch_sub_explicit(obj, arg, order) \
+    MDC_ATOMIC_FETCH_SUB_EXPLICIT(obj, arg, order)
+#define atomic_fetch_or_explicit(obj, arg, order) \
+    MDC_ATOMIC_FETCH_OR_EXPLICIT(obj, arg, order)
+#define atomic_fetch_and_explicit(obj, arg, order) \
+    MDC_ATOMIC_FETCH_AND_EXPLICIT(obj, arg, order)
+#define atomic_fetch_xor_explicit(obj, arg, order) \
+    MDC_ATOMIC_FETCH_XOR_EXPLICIT(obj, arg, order)
+
+/**
+ * Flag type and operations
+ */
+
+typedef struct Mdc_AtomicFlag atomic_flag;
+
+#define ATOMIC_FLAG_INIT MDC_ATOMIC_FLAG_INIT
+
+#define atomic_flag_test_and_set_explicit(obj, order) \
+    MDC_ATOMIC_FLAG_TEST_AND_SET_EXPLICIT(obj, order)
+#define atomic_flag_clear_explicit(obj, order) \
+    MDC_ATOMIC_FLAG_CLEAR_EXPLICIT(obj, order)
+
+/**
+ * Operations with sequentially consistent ordering
+ */
+
+#define atomic_load(obj) \
+    atomic_load_explicit((obj), memory_order_seq_cst)
+#define atomic_store(obj, desired) \
+    atomic_store_explicit((obj), (desired), memory_order_seq_cst)
+#define atomic_exchange(obj, desired) \
+    atomic_exchange_explicit((obj), (desired), memory_order_seq_cst)
+#define atomic_compare_exchange_strong(obj, expected, desired) \
+    atomic_compare_exchange_strong_explicit( \
+        (obj), \
+        (expected), \
+        (desired), \
+        memory_order_seq_cst, \
+        memory_order_seq_cst \
+    )
+#define atomic_compare_exchange_weak(obj, expected, desired) \
+    atomic_compare_exchange_weak_explicit( \
+        (obj), \
+        (expected), \
+        (desired), \
+        memory_order_seq_cst, \
+        memory_order_seq_cst \
+    )
+#define atomic_fetch_add(obj, arg) \
+    atomic_fetch_add_explicit((obj), (arg), memory_order_seq_cst)
+#define atomic_fetch_sub(obj, arg) \
+    atomic_fetch_sub_explicit((obj), (arg), memory_order_seq_cst)
+#define atomic_fetch_or(obj, arg) \
+    atomic_fetch_or_explicit((obj), (arg), memory_order_seq_cst)
+#define atomic_fetch_and(obj, arg) \
+    atomic_fetch_and_explicit((obj), (arg), memory_order_seq_cst)
+#define atomic_fetch_xor(obj, arg) \
+    atomic_fetch_xor_explicit((obj), (arg), memory_order_seq_cst)
+#define atomic_flag_test_and_set(obj) \
+    atomic_flag_test_and_set_explicit((obj), memory_order_seq_cst)
+#define atomic_flag_clear(obj) \
+    atomic_flag_clear_explicit((obj), memory_order_seq_cst)
+
+#endif /* !defined(__cplusplus) */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* defined(__cplusplus) \
+    && (__cplusplus >= 201103L || _MSVC_LANG >= 201103L) */
+
+#endif /* MDC_C_STD_STDATOMIC_H_ */
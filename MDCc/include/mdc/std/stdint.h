@@ -32,7 +32,8 @@
 
 #if __cplusplus >= 201103L \
     ||  __STDC_VERSION__ >= 199901L \
-    || _MSC_VER >= 1600
+    || _MSC_VER >= 1600 \
+    || defined(__GNUC__)
 
 #include <stdint.h>
 
@@ -168,6 +169,7 @@ typedef uint32_t uintptr_t;
 
 #endif /* __cplusplus >= 201103L \
     ||  __STDC_VERSION__ >= 199901L \
-    || _MSC_VER >= 1600 */
+    || _MSC_VER >= 1600 \
+    || defined(__GNUC__) */
 
 #endif /* MDC_C_STD_STDINT_H_ */
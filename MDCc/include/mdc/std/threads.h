@@ -34,6 +34,11 @@
 
 #include <threads.h>
 
+/* Native mutexes do not spin, so the extension flag has no effect. */
+enum {
+  mtx_adaptive = 0x0
+};
+
 #else
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -42,6 +47,8 @@
   #include <pthread.h>
 #endif
 
+#include "time.h"
+
 #include "../../../dllexport_define.inc"
 
 #ifdef __cplusplus
@@ -75,6 +82,10 @@ typedef pthread_t thrd_t;
 DLLEXPORT int thrd_create(thrd_t* thr, thrd_start_t func, void* arg);
 DLLEXPORT int thrd_equal(thrd_t lhs, thrd_t rhs);
 DLLEXPORT thrd_t thrd_current(void);
+DLLEXPORT int thrd_sleep(
+    const struct timespec* duration,
+    struct timespec* remaining
+);
 DLLEXPORT void thrd_yield(void);
 DLLEXPORT void thrd_exit(int res);
 DLLEXPORT int thrd_detach(thrd_t thr);
@@ -87,7 +98,13 @@ DLLEXPORT int thrd_join(thrd_t thr, int *res);
 enum {
   mtx_plain = 0x1,
   mtx_recursive = 0x4,
-  mtx_timed = 0x3
+  mtx_timed = 0x3,
+
+  /*
+  * Extension: a contended adaptive mutex spins for a learned number
+  * of iterations before it sleeps.
+  */
+  mtx_adaptive = 0x8
 };
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -97,6 +114,22 @@ typedef struct {
   int type_;
 
   BOOL is_owned_;
+  int spin_count_;
+} mtx_t;
+
+#elif defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+
+/*
+* The state word is a 32-bit futex. Locking and unlocking an
+* uncontended mutex is a single atomic operation.
+*/
+typedef struct {
+  int state_;
+  int type_;
+
+  int owner_;
+  unsigned int recursion_count_;
+  int spin_count_;
 } mtx_t;
 
 #elif defined(__GNUC__)
@@ -108,6 +141,10 @@ typedef pthread_mutex_t mtx_t;
 DLLEXPORT int mtx_init(mtx_t* mutex, int type);
 DLLEXPORT void mtx_destroy(mtx_t* mutex);
 DLLEXPORT int mtx_lock(mtx_t* mutex);
+DLLEXPORT int mtx_timedlock(
+    mtx_t* mutex,
+    const struct timespec* time_point
+);
 DLLEXPORT int mtx_trylock(mtx_t *mutex);
 DLLEXPORT int mtx_unlock(mtx_t *mutex);
 
@@ -149,6 +186,13 @@ typedef struct {
   LONG has_signal_pass;
 } cnd_t;
 
+#elif defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+
+typedef struct {
+  int sequence_;
+  mtx_t* mutex_;
+} cnd_t;
+
 #elif defined(__GNUC__)
 
 typedef pthread_cond_t cnd_t;
@@ -160,6 +204,36 @@ DLLEXPORT void cnd_destroy(cnd_t* cond);
 DLLEXPORT int cnd_signal(cnd_t* cond);
 DLLEXPORT int cnd_broadcast(cnd_t* cond);
 DLLEXPORT int cnd_wait(cnd_t* cond, mtx_t* mutex);
+DLLEXPORT int cnd_timedwait(
+    cnd_t* cond,
+    mtx_t* mutex,
+    const struct timespec* time_point
+);
+
+/**
+ * Thread-specific storage
+ */
+
+typedef void (*tss_dtor_t)(void*);
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+#define TSS_DTOR_ITERATIONS 4
+
+typedef DWORD tss_t;
+
+#elif defined(__GNUC__)
+
+#define TSS_DTOR_ITERATIONS PTHREAD_DESTRUCTOR_ITERATIONS
+
+typedef pthread_key_t tss_t;
+
+#endif
+
+DLLEXPORT int tss_create(tss_t* key, tss_dtor_t dtor);
+DLLEXPORT void tss_delete(tss_t key);
+DLLEXPORT void* tss_get(tss_t key);
+DLLEXPORT int tss_set(tss_t key, void* value);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,75 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_STD_TIME_H_
+#define MDC_C_STD_TIME_H_
+
+#include <time.h>
+
+#include "../../../dllexport_define.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#if defined(_MSC_VER) && _MSC_VER < 1900 && !defined(_TIMESPEC_DEFINED)
+
+#define _TIMESPEC_DEFINED
+
+struct timespec {
+  time_t tv_sec;
+  long tv_nsec;
+};
+
+#endif /* defined(_MSC_VER) && _MSC_VER < 1900 && !defined(_TIMESPEC_DEFINED) */
+
+#if !defined(TIME_UTC)
+
+#define MDC_INTERNAL_TIMESPEC_GET
+
+#define TIME_UTC 1
+
+/**
+ * Sets the timespec to the current calendar time in the specified
+ * time base.
+ *
+ * @param ts the timespec to set
+ * @param base TIME_UTC
+ * @return base on success, or 0 on failure
+ */
+DLLEXPORT int timespec_get(struct timespec* ts, int base);
+
+#endif /* !defined(TIME_UTC) */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_C_STD_TIME_H_ */
@@ -0,0 +1,305 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/barrier.h"
+
+#include <stddef.h>
+
+#if defined(__linux__)
+  #include "../../../include/mdc/std/stdatomic.h"
+  #include "../std/threads/futex.h"
+#endif
+
+static int GetNextPhase(int phase) {
+  return (int) ((unsigned int) phase + 1);
+}
+
+#if defined(__linux__)
+
+/*
+* A thread reads the phase before counting its arrival, so the phase
+* cannot have moved on yet. The last thread resets the count before
+* publishing the next phase, and a thread only arrives again after it
+* has seen that phase, so it never sees the stale count.
+*/
+
+int Mdc_Barrier_Init(
+    struct Mdc_Barrier* barrier,
+    int count,
+    void (*completion)(void* context),
+    void* completion_context
+) {
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  barrier->phase_ = 0;
+  barrier->remaining_count_ = count;
+  barrier->expected_count_ = count;
+
+  barrier->completion_ = completion;
+  barrier->completion_context_ = completion_context;
+
+  return thrd_success;
+}
+
+void Mdc_Barrier_Deinit(struct Mdc_Barrier* barrier) {
+  (void) barrier;
+}
+
+static int CompletePhase(struct Mdc_Barrier* barrier, int phase) {
+  int expected_count;
+
+  if (barrier->completion_ != NULL) {
+    barrier->completion_(barrier->completion_context_);
+  }
+
+  expected_count = (int) atomic_load_explicit(
+      &barrier->expected_count_,
+      memory_order_relaxed
+  );
+
+  atomic_store_explicit(
+      &barrier->remaining_count_,
+      expected_count,
+      memory_order_relaxed
+  );
+  atomic_store_explicit(
+      &barrier->phase_,
+      GetNextPhase(phase),
+      memory_order_release
+  );
+
+  return Mdc_Futex_Wake(&barrier->phase_, INT_MAX);
+}
+
+static void DecrementExpectedCount(struct Mdc_Barrier* barrier) {
+  atomic_fetch_sub_explicit(
+      &barrier->expected_count_,
+      1,
+      memory_order_relaxed
+  );
+}
+
+int Mdc_Barrier_Arrive(
+    struct Mdc_Barrier* barrier,
+    int count,
+    int* phase
+) {
+  int current_phase;
+  int previous_count;
+
+  if (count <= 0) {
+    return thrd_error;
+  }
+
+  current_phase = (int) atomic_load_explicit(
+      &barrier->phase_,
+      memory_order_acquire
+  );
+
+  /*
+  * The chain of read-modify-writes makes every earlier arrival, and
+  * any drop that preceded it, visible to the last thread. Arriving
+  * too many times is rejected without changing the count.
+  */
+  previous_count = (int) atomic_load_explicit(
+      &barrier->remaining_count_,
+      memory_order_relaxed
+  );
+
+  do {
+    if (previous_count < count) {
+      return thrd_error;
+    }
+  } while (!atomic_compare_exchange_weak_explicit(
+      &barrier->remaining_count_,
+      &previous_count,
+      previous_count - count,
+      memory_order_acq_rel,
+      memory_order_relaxed
+  ));
+
+  *phase = current_phase;
+
+  if (previous_count != count) {
+    return thrd_success;
+  }
+
+  return CompletePhase(barrier, current_phase);
+}
+
+int Mdc_Barrier_Wait(struct Mdc_Barrier* barrier, int phase) {
+  int wait_result;
+
+  while (atomic_load_explicit(&barrier->phase_, memory_order_acquire)
+      == phase) {
+    /* The wait returns immediately if the phase has since changed. */
+    wait_result = Mdc_Futex_Wait(&barrier->phase_, phase);
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+
+  return thrd_success;
+}
+
+#else
+
+int Mdc_Barrier_Init(
+    struct Mdc_Barrier* barrier,
+    int count,
+    void (*completion)(void* context),
+    void* completion_context
+) {
+  int result;
+
+  if (count < 0) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  barrier->phase_ = 0;
+  barrier->remaining_count_ = count;
+  barrier->expected_count_ = count;
+
+  barrier->completion_ = completion;
+  barrier->completion_context_ = completion_context;
+
+  result = mtx_init(&barrier->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = cnd_init(&barrier->cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  return thrd_success;
+
+destroy_mutex:
+  mtx_destroy(&barrier->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_Barrier_Deinit(struct Mdc_Barrier* barrier) {
+  cnd_destroy(&barrier->cond_);
+  mtx_destroy(&barrier->mutex_);
+}
+
+static void DecrementExpectedCount(struct Mdc_Barrier* barrier) {
+  mtx_lock(&barrier->mutex_);
+  barrier->expected_count_ -= 1;
+  mtx_unlock(&barrier->mutex_);
+}
+
+int Mdc_Barrier_Arrive(
+    struct Mdc_Barrier* barrier,
+    int count,
+    int* phase
+) {
+  int result;
+
+  if (count <= 0) {
+    return thrd_error;
+  }
+
+  if (mtx_lock(&barrier->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  if (barrier->remaining_count_ < count) {
+    result = thrd_error;
+    goto unlock_mutex;
+  }
+
+  *phase = barrier->phase_;
+  barrier->remaining_count_ -= count;
+
+  if (barrier->remaining_count_ != 0) {
+    result = thrd_success;
+    goto unlock_mutex;
+  }
+
+  if (barrier->completion_ != NULL) {
+    barrier->completion_(barrier->completion_context_);
+  }
+
+  barrier->remaining_count_ = barrier->expected_count_;
+  barrier->phase_ = GetNextPhase(barrier->phase_);
+
+  result = cnd_broadcast(&barrier->cond_);
+
+unlock_mutex:
+  mtx_unlock(&barrier->mutex_);
+
+  return result;
+}
+
+int Mdc_Barrier_Wait(struct Mdc_Barrier* barrier, int phase) {
+  int wait_result;
+
+  if (mtx_lock(&barrier->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  wait_result = thrd_success;
+  while (barrier->phase_ == phase && wait_result == thrd_success) {
+    wait_result = cnd_wait(&barrier->cond_, &barrier->mutex_);
+  }
+
+  mtx_unlock(&barrier->mutex_);
+
+  return wait_result;
+}
+
+#endif
+
+int Mdc_Barrier_ArriveAndWait(struct Mdc_Barrier* barrier) {
+  int arrive_result;
+  int phase;
+
+  arrive_result = Mdc_Barrier_Arrive(barrier, 1, &phase);
+  if (arrive_result != thrd_success) {
+    return arrive_result;
+  }
+
+  return Mdc_Barrier_Wait(barrier, phase);
+}
+
+int Mdc_Barrier_ArriveAndDrop(struct Mdc_Barrier* barrier) {
+  int phase;
+
+  DecrementExpectedCount(barrier);
+
+  return Mdc_Barrier_Arrive(barrier, 1, &phase);
+}
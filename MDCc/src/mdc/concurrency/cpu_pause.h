@@ -0,0 +1,68 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_CPU_PAUSE_H_
+#define MDC_C_CONCURRENCY_CPU_PAUSE_H_
+
+/**
+ * Hints to the CPU that the calling thread is in a spin-wait loop.
+ * This reduces power usage and frees execution resources for the
+ * sibling hardware thread.
+ */
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+#include <windows.h>
+
+#if defined(YieldProcessor)
+  #define MDC_CPU_PAUSE() YieldProcessor()
+#elif defined(_M_IX86)
+  /* PAUSE is encoded as REP NOP, which VC6 does not know by name. */
+  #define MDC_CPU_PAUSE() __asm _emit 0xF3 __asm _emit 0x90
+#else
+  #define MDC_CPU_PAUSE()
+#endif
+
+#elif defined(__GNUC__)
+
+#if defined(__i386__) || defined(__x86_64__)
+  #define MDC_CPU_PAUSE() __asm__ __volatile__("pause" ::: "memory")
+#elif defined(__aarch64__) || defined(__arm__)
+  #define MDC_CPU_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#else
+  #define MDC_CPU_PAUSE() __asm__ __volatile__("" ::: "memory")
+#endif
+
+#else
+
+#define MDC_CPU_PAUSE()
+
+#endif
+
+#endif /* MDC_C_CONCURRENCY_CPU_PAUSE_H_ */
@@ -0,0 +1,207 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/latch.h"
+
+#if defined(__linux__)
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "../std/threads/futex.h"
+
+int Mdc_Latch_Init(struct Mdc_Latch* latch, int count) {
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  latch->count_ = count;
+
+  return thrd_success;
+}
+
+void Mdc_Latch_Deinit(struct Mdc_Latch* latch) {
+  (void) latch;
+}
+
+int Mdc_Latch_CountDown(struct Mdc_Latch* latch, int count) {
+  int previous_count;
+
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  /* Reject counting down too far without changing the count. */
+  previous_count = (int) atomic_load_explicit(
+      &latch->count_,
+      memory_order_relaxed
+  );
+
+  do {
+    if (previous_count < count) {
+      return thrd_error;
+    }
+  } while (!atomic_compare_exchange_weak_explicit(
+      &latch->count_,
+      &previous_count,
+      previous_count - count,
+      memory_order_release,
+      memory_order_relaxed
+  ));
+
+  if (previous_count != count || count == 0) {
+    return thrd_success;
+  }
+
+  return Mdc_Futex_Wake(&latch->count_, INT_MAX);
+}
+
+int Mdc_Latch_TryWait(struct Mdc_Latch* latch) {
+  return atomic_load_explicit(&latch->count_, memory_order_acquire) == 0;
+}
+
+int Mdc_Latch_Wait(struct Mdc_Latch* latch) {
+  int count;
+  int wait_result;
+
+  for (;;) {
+    count = (int) atomic_load_explicit(&latch->count_, memory_order_acquire);
+    if (count == 0) {
+      return thrd_success;
+    }
+
+    /* The wait returns immediately if the count has since changed. */
+    wait_result = Mdc_Futex_Wait(&latch->count_, count);
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+}
+
+#else
+
+int Mdc_Latch_Init(struct Mdc_Latch* latch, int count) {
+  int result;
+
+  if (count < 0) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  latch->count_ = count;
+
+  result = mtx_init(&latch->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = cnd_init(&latch->cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  return thrd_success;
+
+destroy_mutex:
+  mtx_destroy(&latch->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_Latch_Deinit(struct Mdc_Latch* latch) {
+  cnd_destroy(&latch->cond_);
+  mtx_destroy(&latch->mutex_);
+}
+
+int Mdc_Latch_CountDown(struct Mdc_Latch* latch, int count) {
+  int result;
+
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  if (mtx_lock(&latch->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  if (latch->count_ < count) {
+    result = thrd_error;
+  } else {
+    latch->count_ -= count;
+
+    if (latch->count_ == 0 && count != 0) {
+      result = cnd_broadcast(&latch->cond_);
+    } else {
+      result = thrd_success;
+    }
+  }
+
+  mtx_unlock(&latch->mutex_);
+
+  return result;
+}
+
+int Mdc_Latch_TryWait(struct Mdc_Latch* latch) {
+  int is_open;
+
+  mtx_lock(&latch->mutex_);
+  is_open = (latch->count_ == 0);
+  mtx_unlock(&latch->mutex_);
+
+  return is_open;
+}
+
+int Mdc_Latch_Wait(struct Mdc_Latch* latch) {
+  int wait_result;
+
+  if (mtx_lock(&latch->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  wait_result = thrd_success;
+  while (latch->count_ != 0 && wait_result == thrd_success) {
+    wait_result = cnd_wait(&latch->cond_, &latch->mutex_);
+  }
+
+  mtx_unlock(&latch->mutex_);
+
+  return wait_result;
+}
+
+#endif
+
+int Mdc_Latch_ArriveAndWait(struct Mdc_Latch* latch, int count) {
+  int count_down_result;
+
+  count_down_result = Mdc_Latch_CountDown(latch, count);
+  if (count_down_result != thrd_success) {
+    return count_down_result;
+  }
+
+  return Mdc_Latch_Wait(latch);
+}
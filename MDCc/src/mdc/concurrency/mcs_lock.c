@@ -0,0 +1,192 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/mcs_lock.h"
+
+#include <stddef.h>
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "../../../include/mdc/std/stdint.h"
+#include "cpu_pause.h"
+
+enum {
+  kMaxSpinCount = 1024
+};
+
+/*
+* The tail is NULL when the lock is free, points to the lock itself
+* when it is held with no waiters, and otherwise points to the node of
+* the last waiter. A waiter links itself to the previous tail through
+* its next_ member, and the new owner moves its successor into the
+* lock's next_ member before its node goes out of scope.
+*/
+
+static struct Mdc_McsLock* LoadTail(struct Mdc_McsLock* lock) {
+  return (struct Mdc_McsLock*) (intptr_t) atomic_load_explicit(
+      &lock->tail_,
+      memory_order_relaxed
+  );
+}
+
+static int CompareExchangeTail(
+    struct Mdc_McsLock* lock,
+    struct Mdc_McsLock* expected,
+    struct Mdc_McsLock* desired
+) {
+  return atomic_compare_exchange_strong_explicit(
+      &lock->tail_,
+      &expected,
+      desired,
+      memory_order_acq_rel,
+      memory_order_relaxed
+  );
+}
+
+static struct Mdc_McsLock* LoadNext(struct Mdc_McsLock* node) {
+  return (struct Mdc_McsLock*) (intptr_t) atomic_load_explicit(
+      &node->next_,
+      memory_order_acquire
+  );
+}
+
+static void StoreNext(struct Mdc_McsLock* node, struct Mdc_McsLock* next) {
+  atomic_store_explicit(&node->next_, next, memory_order_release);
+}
+
+/*
+* Spins on the CPU for a bounded number of iterations, then yields.
+* With more threads than cores, the next owner might be descheduled,
+* and pure spinning would only burn the time slice it needs.
+*/
+static void Backoff(int* spin_count) {
+  if (*spin_count < kMaxSpinCount) {
+    *spin_count += 1;
+    MDC_CPU_PAUSE();
+  } else {
+    thrd_yield();
+  }
+}
+
+static struct Mdc_McsLock* WaitForNext(struct Mdc_McsLock* node) {
+  struct Mdc_McsLock* next;
+  int spin_count;
+
+  spin_count = 0;
+  for (next = LoadNext(node); next == NULL; next = LoadNext(node)) {
+    Backoff(&spin_count);
+  }
+
+  return next;
+}
+
+void Mdc_McsLock_Init(struct Mdc_McsLock* lock) {
+  lock->tail_ = NULL;
+  lock->next_ = NULL;
+  lock->is_waiting_ = 0;
+}
+
+void Mdc_McsLock_Deinit(struct Mdc_McsLock* lock) {
+  (void) lock;
+}
+
+void Mdc_McsLock_Lock(struct Mdc_McsLock* lock) {
+  struct Mdc_McsLock node;
+  struct Mdc_McsLock* previous;
+  struct Mdc_McsLock* next;
+  int spin_count;
+
+  for (;;) {
+    previous = LoadTail(lock);
+
+    if (previous == NULL) {
+      if (CompareExchangeTail(lock, NULL, lock)) {
+        return;
+      }
+
+      continue;
+    }
+
+    node.next_ = NULL;
+    node.is_waiting_ = 1;
+
+    if (CompareExchangeTail(lock, previous, &node)) {
+      break;
+    }
+  }
+
+  StoreNext(previous, &node);
+
+  spin_count = 0;
+  while (atomic_load_explicit(&node.is_waiting_, memory_order_acquire)) {
+    Backoff(&spin_count);
+  }
+
+  /*
+  * The lock is now held, but the node is about to go out of scope, so
+  * the successor must be moved into the lock. If there is none yet,
+  * the tail is pointed back to the lock, unless a waiter has just
+  * enqueued itself behind the node.
+  */
+  next = LoadNext(&node);
+  if (next == NULL) {
+    StoreNext(lock, NULL);
+
+    if (CompareExchangeTail(lock, &node, lock)) {
+      return;
+    }
+
+    next = WaitForNext(&node);
+  }
+
+  StoreNext(lock, next);
+}
+
+int Mdc_McsLock_TryLock(struct Mdc_McsLock* lock) {
+  if (LoadTail(lock) != NULL) {
+    return thrd_busy;
+  }
+
+  return CompareExchangeTail(lock, NULL, lock) ? thrd_success : thrd_busy;
+}
+
+void Mdc_McsLock_Unlock(struct Mdc_McsLock* lock) {
+  struct Mdc_McsLock* next;
+
+  next = LoadNext(lock);
+  if (next == NULL) {
+    if (CompareExchangeTail(lock, lock, NULL)) {
+      return;
+    }
+
+    next = WaitForNext(lock);
+  }
+
+  /* The waiter's node may go out of scope once it is released. */
+  atomic_store_explicit(&next->is_waiting_, 0, memory_order_release);
+}
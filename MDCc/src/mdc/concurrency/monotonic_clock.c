@@ -0,0 +1,66 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "monotonic_clock.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+uint64_t Mdc_MonotonicClock_GetNanoseconds(void) {
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  uint64_t seconds;
+  uint64_t remainder;
+
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+
+  seconds = counter.QuadPart / frequency.QuadPart;
+  remainder = counter.QuadPart % frequency.QuadPart;
+
+  return seconds * 1000000000
+      + remainder * 1000000000 / frequency.QuadPart;
+}
+
+#else
+
+uint64_t Mdc_MonotonicClock_GetNanoseconds(void) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+#endif
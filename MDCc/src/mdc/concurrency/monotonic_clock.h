@@ -0,0 +1,45 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_MONOTONIC_CLOCK_H_
+#define MDC_C_CONCURRENCY_MONOTONIC_CLOCK_H_
+
+#include "../../../include/mdc/std/stdint.h"
+
+/*
+* The clock used to time sleeps and lock statistics, which must not
+* jump when the system time is changed.
+*/
+
+/**
+ * Returns the current time of a monotonic clock, in nanoseconds.
+ */
+uint64_t Mdc_MonotonicClock_GetNanoseconds(void);
+
+#endif /* MDC_C_CONCURRENCY_MONOTONIC_CLOCK_H_ */
@@ -0,0 +1,458 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/mpmc_queue.h"
+
+#include <string.h>
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+#include "power_of_two.h"
+
+/*
+* Each slot starts with its sequence number, followed by the element.
+* A slot at index i is free for the producer of lap n when its
+* sequence is i, and ready for the consumer when its sequence is
+* i + 1. The consumer then advances it by the capacity, to the next
+* lap's index. Indices and sequences wrap around, so they are
+* compared through their signed difference.
+*/
+
+static size_t* GetSlotSequence(
+    const struct Mdc_MpmcQueue* queue,
+    size_t index
+) {
+  return (size_t*) &queue->slots_[(index & queue->mask_) * queue->slot_size_];
+}
+
+static unsigned char* GetSlotElement(
+    const struct Mdc_MpmcQueue* queue,
+    size_t index
+) {
+  return &queue->slots_[
+      (index & queue->mask_) * queue->slot_size_ + sizeof(size_t)
+  ];
+}
+
+static ptrdiff_t GetPushLag(const struct Mdc_MpmcQueue* queue, size_t index) {
+  size_t sequence;
+
+  sequence = (size_t) atomic_load_explicit(
+      GetSlotSequence(queue, index),
+      memory_order_acquire
+  );
+
+  return (ptrdiff_t) (sequence - index);
+}
+
+static ptrdiff_t GetPopLag(const struct Mdc_MpmcQueue* queue, size_t index) {
+  size_t sequence;
+
+  sequence = (size_t) atomic_load_explicit(
+      GetSlotSequence(queue, index),
+      memory_order_acquire
+  );
+
+  return (ptrdiff_t) (sequence - (index + 1));
+}
+
+static int IsFull(struct Mdc_MpmcQueue* queue) {
+  size_t index;
+
+  index = (size_t) atomic_load_explicit(
+      &queue->enqueue_index_,
+      memory_order_relaxed
+  );
+
+  return GetPushLag(queue, index) < 0;
+}
+
+static int IsEmpty(struct Mdc_MpmcQueue* queue) {
+  size_t index;
+
+  index = (size_t) atomic_load_explicit(
+      &queue->dequeue_index_,
+      memory_order_relaxed
+  );
+
+  return GetPopLag(queue, index) < 0;
+}
+
+/*
+* A waiter counts itself and then checks the queue, while the other
+* side publishes its slot and then checks the count. The fences
+* ensure that at least one of them sees the other's write, so a
+* wakeup is never lost.
+*/
+
+static void WakeWaiter(
+    struct Mdc_MpmcQueue* queue,
+    long* waiting_count,
+    cnd_t* cond
+) {
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (atomic_load_explicit(waiting_count, memory_order_relaxed) == 0) {
+    return;
+  }
+
+  mtx_lock(&queue->mutex_);
+  cnd_signal(cond);
+  mtx_unlock(&queue->mutex_);
+}
+
+static int Wait(
+    struct Mdc_MpmcQueue* queue,
+    long* waiting_count,
+    cnd_t* cond,
+    int (*is_blocked)(struct Mdc_MpmcQueue*),
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (!(queue->flags_ & Mdc_MpmcQueue_kBlocking)) {
+    return thrd_error;
+  }
+
+  if (mtx_lock(&queue->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  atomic_fetch_add_explicit(waiting_count, 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  wait_result = thrd_success;
+  while (is_blocked(queue) && wait_result == thrd_success) {
+    if (time_point == NULL) {
+      wait_result = cnd_wait(cond, &queue->mutex_);
+    } else {
+      wait_result = cnd_timedwait(cond, &queue->mutex_, time_point);
+    }
+  }
+
+  atomic_fetch_sub_explicit(waiting_count, 1, memory_order_relaxed);
+
+  mtx_unlock(&queue->mutex_);
+
+  return wait_result;
+}
+
+static int PushUntil(
+    struct Mdc_MpmcQueue* queue,
+    const void* element,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  for (;;) {
+    if (Mdc_MpmcQueue_TryPush(queue, element)) {
+      return thrd_success;
+    }
+
+    wait_result = Wait(
+        queue,
+        &queue->waiting_producers_count_,
+        &queue->not_full_cond_,
+        &IsFull,
+        time_point
+    );
+
+    if (wait_result == thrd_timedout) {
+      return Mdc_MpmcQueue_TryPush(queue, element)
+          ? thrd_success
+          : thrd_timedout;
+    }
+
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+}
+
+static int PopUntil(
+    struct Mdc_MpmcQueue* queue,
+    void* element,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  for (;;) {
+    if (Mdc_MpmcQueue_TryPop(queue, element)) {
+      return thrd_success;
+    }
+
+    wait_result = Wait(
+        queue,
+        &queue->waiting_consumers_count_,
+        &queue->not_empty_cond_,
+        &IsEmpty,
+        time_point
+    );
+
+    if (wait_result == thrd_timedout) {
+      return Mdc_MpmcQueue_TryPop(queue, element)
+          ? thrd_success
+          : thrd_timedout;
+    }
+
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+}
+
+int Mdc_MpmcQueue_Init(
+    struct Mdc_MpmcQueue* queue,
+    size_t element_size,
+    size_t capacity,
+    int flags
+) {
+  int result;
+  size_t i;
+
+  /* Reject capacities that cannot be rounded up or allocated. */
+  capacity = Mdc_PowerOfTwo_RoundUp((capacity < 2) ? 2 : capacity);
+  if (capacity == 0) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  if (element_size > (size_t) -1 - 2 * sizeof(size_t)) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  /* Keep every slot's sequence number aligned. */
+  queue->slot_size_ = sizeof(size_t)
+      + (element_size + sizeof(size_t) - 1) / sizeof(size_t)
+          * sizeof(size_t);
+
+  if (capacity > (size_t) -1 / queue->slot_size_) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  queue->slots_ = Mdc_malloc(capacity * queue->slot_size_);
+  if (queue->slots_ == NULL) {
+    result = thrd_nomem;
+    goto return_bad;
+  }
+
+  queue->element_size_ = element_size;
+  queue->mask_ = capacity - 1;
+
+  for (i = 0; i < capacity; i += 1) {
+    *GetSlotSequence(queue, i) = i;
+  }
+
+  queue->enqueue_index_ = 0;
+  queue->dequeue_index_ = 0;
+
+  queue->flags_ = flags;
+  queue->waiting_producers_count_ = 0;
+  queue->waiting_consumers_count_ = 0;
+
+  if (!(flags & Mdc_MpmcQueue_kBlocking)) {
+    return thrd_success;
+  }
+
+  result = mtx_init(&queue->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto free_slots;
+  }
+
+  result = cnd_init(&queue->not_empty_cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  result = cnd_init(&queue->not_full_cond_);
+  if (result != thrd_success) {
+    goto destroy_not_empty_cond;
+  }
+
+  return thrd_success;
+
+destroy_not_empty_cond:
+  cnd_destroy(&queue->not_empty_cond_);
+
+destroy_mutex:
+  mtx_destroy(&queue->mutex_);
+
+free_slots:
+  Mdc_free(queue->slots_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_MpmcQueue_Deinit(struct Mdc_MpmcQueue* queue) {
+  if (queue->flags_ & Mdc_MpmcQueue_kBlocking) {
+    cnd_destroy(&queue->not_full_cond_);
+    cnd_destroy(&queue->not_empty_cond_);
+    mtx_destroy(&queue->mutex_);
+  }
+
+  Mdc_free(queue->slots_);
+}
+
+size_t Mdc_MpmcQueue_GetCapacity(const struct Mdc_MpmcQueue* queue) {
+  return queue->mask_ + 1;
+}
+
+int Mdc_MpmcQueue_TryPush(
+    struct Mdc_MpmcQueue* queue,
+    const void* element
+) {
+  size_t index;
+  ptrdiff_t lag;
+
+  index = (size_t) atomic_load_explicit(
+      &queue->enqueue_index_,
+      memory_order_relaxed
+  );
+
+  for (;;) {
+    lag = GetPushLag(queue, index);
+
+    if (lag == 0) {
+      /* On failure, the index is updated to the current one. */
+      if (atomic_compare_exchange_weak_explicit(
+          &queue->enqueue_index_,
+          &index,
+          index + 1,
+          memory_order_relaxed,
+          memory_order_relaxed
+      )) {
+        break;
+      }
+    } else if (lag < 0) {
+      /* The slot still holds the previous lap's element. */
+      return 0;
+    } else {
+      index = (size_t) atomic_load_explicit(
+          &queue->enqueue_index_,
+          memory_order_relaxed
+      );
+    }
+  }
+
+  memcpy(GetSlotElement(queue, index), element, queue->element_size_);
+  atomic_store_explicit(
+      GetSlotSequence(queue, index),
+      index + 1,
+      memory_order_release
+  );
+
+  if (queue->flags_ & Mdc_MpmcQueue_kBlocking) {
+    WakeWaiter(
+        queue,
+        &queue->waiting_consumers_count_,
+        &queue->not_empty_cond_
+    );
+  }
+
+  return 1;
+}
+
+int Mdc_MpmcQueue_TryPop(struct Mdc_MpmcQueue* queue, void* element) {
+  size_t index;
+  ptrdiff_t lag;
+
+  index = (size_t) atomic_load_explicit(
+      &queue->dequeue_index_,
+      memory_order_relaxed
+  );
+
+  for (;;) {
+    lag = GetPopLag(queue, index);
+
+    if (lag == 0) {
+      /* On failure, the index is updated to the current one. */
+      if (atomic_compare_exchange_weak_explicit(
+          &queue->dequeue_index_,
+          &index,
+          index + 1,
+          memory_order_relaxed,
+          memory_order_relaxed
+      )) {
+        break;
+      }
+    } else if (lag < 0) {
+      /* The slot has not been filled for this lap yet. */
+      return 0;
+    } else {
+      index = (size_t) atomic_load_explicit(
+          &queue->dequeue_index_,
+          memory_order_relaxed
+      );
+    }
+  }
+
+  memcpy(element, GetSlotElement(queue, index), queue->element_size_);
+  atomic_store_explicit(
+      GetSlotSequence(queue, index),
+      index + queue->mask_ + 1,
+      memory_order_release
+  );
+
+  if (queue->flags_ & Mdc_MpmcQueue_kBlocking) {
+    WakeWaiter(
+        queue,
+        &queue->waiting_producers_count_,
+        &queue->not_full_cond_
+    );
+  }
+
+  return 1;
+}
+
+int Mdc_MpmcQueue_Push(struct Mdc_MpmcQueue* queue, const void* element) {
+  return PushUntil(queue, element, NULL);
+}
+
+int Mdc_MpmcQueue_Pop(struct Mdc_MpmcQueue* queue, void* element) {
+  return PopUntil(queue, element, NULL);
+}
+
+int Mdc_MpmcQueue_TimedPush(
+    struct Mdc_MpmcQueue* queue,
+    const void* element,
+    const struct timespec* time_point
+) {
+  return PushUntil(queue, element, time_point);
+}
+
+int Mdc_MpmcQueue_TimedPop(
+    struct Mdc_MpmcQueue* queue,
+    void* element,
+    const struct timespec* time_point
+) {
+  return PopUntil(queue, element, time_point);
+}
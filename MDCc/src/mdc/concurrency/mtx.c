@@ -0,0 +1,75 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/mtx.h"
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "cpu_pause.h"
+
+enum {
+  kDefaultAdaptiveSpinLimit = 256
+};
+
+static atomic_uint adaptive_spin_limit = kDefaultAdaptiveSpinLimit;
+
+int Mdc_Mtx_TryLockSpin(mtx_t* mutex, unsigned int spins) {
+  unsigned int i;
+  int trylock_result;
+
+  trylock_result = mtx_trylock(mutex);
+
+  for (i = 0; trylock_result == thrd_busy && i < spins; i += 1) {
+    MDC_CPU_PAUSE();
+
+#if defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+    /*
+    * Only retry the atomic exchange once the mutex appears unlocked,
+    * so that spinning keeps the cache line in a shared state.
+    */
+    if (atomic_load_explicit(&mutex->state_, memory_order_relaxed) != 0) {
+      continue;
+    }
+#endif
+
+    trylock_result = mtx_trylock(mutex);
+  }
+
+  return trylock_result;
+}
+
+unsigned int Mdc_Mtx_GetAdaptiveSpinLimit(void) {
+  return (unsigned int) atomic_load_explicit(
+      &adaptive_spin_limit,
+      memory_order_relaxed
+  );
+}
+
+void Mdc_Mtx_SetAdaptiveSpinLimit(unsigned int spins) {
+  atomic_store_explicit(&adaptive_spin_limit, spins, memory_order_relaxed);
+}
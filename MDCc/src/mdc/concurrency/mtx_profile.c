@@ -0,0 +1,641 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mtx_profile.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../../include/mdc/concurrency/mcs_lock.h"
+#include "../../../include/mdc/concurrency/mtx.h"
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+#include "monotonic_clock.h"
+#include "sharded_counter.h"
+
+enum {
+  kShardsCount = Mdc_ShardedCounter_kShardsCount,
+  kMaxProfilesCount = 256,
+  kSlotIndexBits = 9,
+  kSlotsCount = 1 << kSlotIndexBits,
+  kHistogramBucketsCount = Mdc_Mtx_kProfileHistogramBucketsCount
+};
+
+struct ShardCounters {
+  struct Mdc_ShardedCounter acquisitions_count;
+  struct Mdc_ShardedCounter contended_count;
+
+  struct Mdc_ShardedCounter total_wait_nanoseconds;
+  struct Mdc_ShardedCounter total_hold_nanoseconds;
+
+  struct Mdc_ShardedCounter wait_histogram[kHistogramBucketsCount];
+  struct Mdc_ShardedCounter hold_histogram[kHistogramBucketsCount];
+};
+
+struct Shard {
+  struct ShardCounters counters;
+
+  unsigned char padding[
+      MDC_C_CONCURRENCY_SHARDED_COUNTER_PADDING_SIZE_(
+          sizeof(struct ShardCounters)
+      )
+  ];
+};
+
+struct Mdc_MtxProfile {
+  const char* name;
+
+  /*
+  * Only accessed by the thread that holds the mutex. The hold is timed
+  * from the outermost lock of a recursive mutex.
+  */
+  unsigned int hold_epoch;
+  unsigned int hold_depth;
+  uint64_t hold_start_time;
+
+  struct Shard shards[kShardsCount];
+};
+
+/*
+* Registered mutexes are found by address in an open addressing hash
+* table, because mtx_t cannot always hold a pointer to its profile.
+* The table is read without locking. Writers hold the registry lock
+* and publish a slot's profile before its mutex.
+*/
+struct Slot {
+  mtx_t* mutex;
+  struct Mdc_MtxProfile* profile;
+};
+
+static char tombstone;
+
+static struct Slot slots[kSlotsCount];
+
+/* Zero-initialized, which is the same as Mdc_McsLock_Init. */
+static struct Mdc_McsLock registry_lock;
+
+static atomic_int registered_count;
+
+/*
+* Odd while profiling is enabled. Each change starts a new epoch, so
+* that holds that straddle a change are discarded.
+*/
+static atomic_uint profiling_epoch;
+
+static unsigned int LoadEpoch(void) {
+  return (unsigned int) atomic_load_explicit(
+      &profiling_epoch,
+      memory_order_relaxed
+  );
+}
+
+static mtx_t* LoadSlotMutex(struct Slot* slot) {
+  return (mtx_t*) (intptr_t) atomic_load_explicit(
+      &slot->mutex,
+      memory_order_acquire
+  );
+}
+
+static mtx_t* GetTombstone(void) {
+  return (mtx_t*) &tombstone;
+}
+
+static size_t GetHomeSlotIndex(const mtx_t* mutex) {
+  uintptr_t address;
+  uint32_t hash;
+
+  address = (uintptr_t) mutex;
+  hash = (uint32_t) (address >> 3) ^ (uint32_t) (address >> 19);
+
+  /* Fibonacci hashing keeps the well mixed upper bits. */
+  return (size_t) ((uint32_t) (hash * 2654435761u) >> (32 - kSlotIndexBits));
+}
+
+static size_t GetNextSlotIndex(size_t index) {
+  return (index + 1) % kSlotsCount;
+}
+
+static struct Slot* FindSlot(const mtx_t* mutex) {
+  size_t index;
+  size_t i;
+  mtx_t* slot_mutex;
+
+  index = GetHomeSlotIndex(mutex);
+
+  for (i = 0; i < kSlotsCount; ++i) {
+    slot_mutex = LoadSlotMutex(&slots[index]);
+
+    if (slot_mutex == mutex) {
+      return &slots[index];
+    }
+
+    if (slot_mutex == NULL) {
+      break;
+    }
+
+    index = GetNextSlotIndex(index);
+  }
+
+  return NULL;
+}
+
+/*
+* Turns a trailing run of tombstones back into empty slots, so that
+* lookups of unregistered mutexes stay short.
+*/
+static void ClearTombstones(size_t index) {
+  while (slots[index].mutex == GetTombstone()
+      && slots[GetNextSlotIndex(index)].mutex == NULL) {
+    atomic_store_explicit(&slots[index].mutex, NULL, memory_order_relaxed);
+    index = (index + kSlotsCount - 1) % kSlotsCount;
+  }
+}
+
+static struct ShardCounters* GetShardCounters(
+    struct Mdc_MtxProfile* profile
+) {
+  return &profile->shards[Mdc_ShardedCounter_GetShardIndex()].counters;
+}
+
+static size_t GetBucketIndex(uint64_t nanoseconds) {
+  size_t index;
+
+  for (index = 0;
+      nanoseconds > 1 && index < kHistogramBucketsCount - 1;
+      ++index) {
+    nanoseconds >>= 1;
+  }
+
+  return index;
+}
+
+static void MergeShards(
+    struct Mdc_MtxProfile* profile,
+    struct Mdc_MtxProfileStats* stats
+) {
+  struct ShardCounters* counters;
+  size_t i;
+  size_t bucket;
+
+  memset(stats, 0, sizeof(*stats));
+  stats->name = profile->name;
+
+  for (i = 0; i < kShardsCount; ++i) {
+    counters = &profile->shards[i].counters;
+
+    stats->acquisitions_count +=
+        Mdc_ShardedCounter_Load(&counters->acquisitions_count);
+    stats->contended_count +=
+        Mdc_ShardedCounter_Load(&counters->contended_count);
+    stats->total_wait_nanoseconds +=
+        Mdc_ShardedCounter_Load(&counters->total_wait_nanoseconds);
+    stats->total_hold_nanoseconds +=
+        Mdc_ShardedCounter_Load(&counters->total_hold_nanoseconds);
+
+    for (bucket = 0; bucket < kHistogramBucketsCount; ++bucket) {
+      stats->wait_histogram[bucket] +=
+          Mdc_ShardedCounter_Load(&counters->wait_histogram[bucket]);
+      stats->hold_histogram[bucket] +=
+          Mdc_ShardedCounter_Load(&counters->hold_histogram[bucket]);
+    }
+  }
+}
+
+static void ResetShards(struct Mdc_MtxProfile* profile) {
+  struct ShardCounters* counters;
+  size_t i;
+  size_t bucket;
+
+  for (i = 0; i < kShardsCount; ++i) {
+    counters = &profile->shards[i].counters;
+
+    Mdc_ShardedCounter_Reset(&counters->acquisitions_count);
+    Mdc_ShardedCounter_Reset(&counters->contended_count);
+    Mdc_ShardedCounter_Reset(&counters->total_wait_nanoseconds);
+    Mdc_ShardedCounter_Reset(&counters->total_hold_nanoseconds);
+
+    for (bucket = 0; bucket < kHistogramBucketsCount; ++bucket) {
+      Mdc_ShardedCounter_Reset(&counters->wait_histogram[bucket]);
+      Mdc_ShardedCounter_Reset(&counters->hold_histogram[bucket]);
+    }
+  }
+}
+
+/*
+* VC6 cannot convert an unsigned 64-bit integer to a double. The
+* values converted here never exceed the signed range.
+*/
+static double ToDouble(uint64_t value) {
+  return (double) (int64_t) value;
+}
+
+static uint64_t SumHistogram(const uint64_t* histogram) {
+  uint64_t sum;
+  size_t i;
+
+  sum = 0;
+  for (i = 0; i < kHistogramBucketsCount; ++i) {
+    sum += histogram[i];
+  }
+
+  return sum;
+}
+
+/*
+* Returns the upper bound, in nanoseconds, of the bucket that holds
+* the sample at the percentile.
+*/
+static double GetPercentile(const uint64_t* histogram, double percentile) {
+  uint64_t samples_count;
+  double rank;
+  uint64_t seen_count;
+  size_t i;
+
+  samples_count = SumHistogram(histogram);
+  if (samples_count == 0) {
+    return 0;
+  }
+
+  rank = ToDouble(samples_count) * percentile;
+  seen_count = 0;
+
+  for (i = 0; i < kHistogramBucketsCount - 1; ++i) {
+    seen_count += histogram[i];
+
+    if (ToDouble(seen_count) >= rank) {
+      break;
+    }
+  }
+
+  return ToDouble((uint64_t) 1 << (i + 1));
+}
+
+static double GetMean(uint64_t total, uint64_t count) {
+  return (count == 0) ? 0 : ToDouble(total) / ToDouble(count);
+}
+
+static int CompareByTotalWaitDescending(const void* left, const void* right) {
+  const struct Mdc_MtxProfileStats* left_stats = left;
+  const struct Mdc_MtxProfileStats* right_stats = right;
+
+  if (left_stats->total_wait_nanoseconds
+      != right_stats->total_wait_nanoseconds) {
+    return (left_stats->total_wait_nanoseconds
+        < right_stats->total_wait_nanoseconds) ? 1 : -1;
+  }
+
+  if (left_stats->acquisitions_count != right_stats->acquisitions_count) {
+    return (left_stats->acquisitions_count
+        < right_stats->acquisitions_count) ? 1 : -1;
+  }
+
+  return 0;
+}
+
+static int PrintStats(FILE* stream, const struct Mdc_MtxProfileStats* stats) {
+  return fprintf(
+      stream,
+      "%-24s %14.0f %12.0f %7.2f %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+      stats->name,
+      ToDouble(stats->acquisitions_count),
+      ToDouble(stats->contended_count),
+      GetMean(stats->contended_count * 100, stats->acquisitions_count),
+      ToDouble(stats->total_wait_nanoseconds) / 1e6,
+      GetMean(stats->total_wait_nanoseconds, stats->contended_count) / 1e3,
+      GetPercentile(stats->wait_histogram, 0.99) / 1e3,
+      GetMean(
+          stats->total_hold_nanoseconds,
+          SumHistogram(stats->hold_histogram)
+      ) / 1e3,
+      GetPercentile(stats->hold_histogram, 0.99) / 1e3
+  );
+}
+
+struct Mdc_MtxProfile* Mdc_MtxProfile_Find(mtx_t* mutex) {
+  struct Slot* slot;
+
+  if ((LoadEpoch() & 1) == 0) {
+    return NULL;
+  }
+
+  slot = FindSlot(mutex);
+  if (slot == NULL) {
+    return NULL;
+  }
+
+  return slot->profile;
+}
+
+int Mdc_MtxProfile_HasRegistered(void) {
+  return atomic_load_explicit(&registered_count, memory_order_relaxed) != 0;
+}
+
+void Mdc_MtxProfile_RecordLock(
+    struct Mdc_MtxProfile* profile,
+    int is_contended,
+    uint64_t wait_start_time
+) {
+  struct ShardCounters* counters;
+  uint64_t now;
+  uint64_t wait_time;
+  unsigned int epoch;
+
+  now = Mdc_MonotonicClock_GetNanoseconds();
+  counters = GetShardCounters(profile);
+
+  Mdc_ShardedCounter_Add(&counters->acquisitions_count, 1);
+
+  if (is_contended) {
+    wait_time = now - wait_start_time;
+
+    Mdc_ShardedCounter_Add(&counters->contended_count, 1);
+    Mdc_ShardedCounter_Add(&counters->total_wait_nanoseconds, wait_time);
+    Mdc_ShardedCounter_Add(
+        &counters->wait_histogram[GetBucketIndex(wait_time)],
+        1
+    );
+  }
+
+  /*
+  * A hold from before profiling was last enabled might not have had
+  * its unlock recorded, so it is discarded.
+  */
+  epoch = LoadEpoch();
+  if (profile->hold_epoch != epoch) {
+    profile->hold_epoch = epoch;
+    profile->hold_depth = 0;
+  }
+
+  if (profile->hold_depth == 0) {
+    profile->hold_start_time = now;
+  }
+
+  profile->hold_depth += 1;
+}
+
+void Mdc_MtxProfile_RecordUnlock(struct Mdc_MtxProfile* profile) {
+  struct ShardCounters* counters;
+  uint64_t hold_time;
+
+  if (profile->hold_epoch != LoadEpoch() || profile->hold_depth == 0) {
+    return;
+  }
+
+  profile->hold_depth -= 1;
+  if (profile->hold_depth > 0) {
+    return;
+  }
+
+  hold_time = Mdc_MonotonicClock_GetNanoseconds() - profile->hold_start_time;
+  counters = GetShardCounters(profile);
+
+  Mdc_ShardedCounter_Add(&counters->total_hold_nanoseconds, hold_time);
+  Mdc_ShardedCounter_Add(
+      &counters->hold_histogram[GetBucketIndex(hold_time)],
+      1
+  );
+}
+
+int Mdc_Mtx_RegisterProfile(mtx_t* mutex, const char* name) {
+  struct Mdc_MtxProfile* profile;
+  struct Slot* free_slot;
+  size_t index;
+  size_t i;
+  mtx_t* slot_mutex;
+  int result;
+
+  profile = Mdc_malloc(sizeof(*profile));
+  if (profile == NULL) {
+    result = thrd_nomem;
+    goto return_bad;
+  }
+
+  profile->name = name;
+  profile->hold_epoch = 0;
+  profile->hold_depth = 0;
+  profile->hold_start_time = 0;
+  ResetShards(profile);
+
+  Mdc_McsLock_Lock(&registry_lock);
+
+  if (atomic_load_explicit(&registered_count, memory_order_relaxed)
+      >= kMaxProfilesCount) {
+    result = thrd_error;
+    goto unlock_registry;
+  }
+
+  /* Reuse the first free slot, but only after ruling out a duplicate. */
+  free_slot = NULL;
+  index = GetHomeSlotIndex(mutex);
+
+  for (i = 0; i < kSlotsCount; ++i) {
+    slot_mutex = slots[index].mutex;
+
+    if (slot_mutex == mutex) {
+      result = thrd_error;
+      goto unlock_registry;
+    }
+
+    if (free_slot == NULL
+        && (slot_mutex == NULL || slot_mutex == GetTombstone())) {
+      free_slot = &slots[index];
+    }
+
+    if (slot_mutex == NULL) {
+      break;
+    }
+
+    index = GetNextSlotIndex(index);
+  }
+
+  free_slot->profile = profile;
+  atomic_store_explicit(&free_slot->mutex, mutex, memory_order_release);
+  atomic_fetch_add_explicit(&registered_count, 1, memory_order_relaxed);
+
+  Mdc_McsLock_Unlock(&registry_lock);
+
+  return thrd_success;
+
+unlock_registry:
+  Mdc_McsLock_Unlock(&registry_lock);
+  Mdc_free(profile);
+
+return_bad:
+  return result;
+}
+
+void Mdc_Mtx_UnregisterProfile(mtx_t* mutex) {
+  struct Slot* slot;
+  struct Mdc_MtxProfile* profile;
+
+  profile = NULL;
+
+  Mdc_McsLock_Lock(&registry_lock);
+
+  slot = FindSlot(mutex);
+  if (slot != NULL) {
+    profile = slot->profile;
+
+    atomic_store_explicit(
+        &slot->mutex,
+        GetTombstone(),
+        memory_order_relaxed
+    );
+    slot->profile = NULL;
+    ClearTombstones((size_t) (slot - slots));
+
+    atomic_fetch_sub_explicit(&registered_count, 1, memory_order_relaxed);
+  }
+
+  Mdc_McsLock_Unlock(&registry_lock);
+
+  if (profile != NULL) {
+    Mdc_free(profile);
+  }
+}
+
+int Mdc_Mtx_IsProfilingEnabled(void) {
+  return (LoadEpoch() & 1) == 1;
+}
+
+void Mdc_Mtx_SetProfilingEnabled(int is_enabled) {
+  unsigned int epoch;
+
+  epoch = LoadEpoch();
+
+  do {
+    if ((int) (epoch & 1) == (is_enabled != 0)) {
+      return;
+    }
+  } while (!atomic_compare_exchange_weak_explicit(
+      &profiling_epoch,
+      &epoch,
+      epoch + 1,
+      memory_order_relaxed,
+      memory_order_relaxed
+  ));
+}
+
+int Mdc_Mtx_GetProfileStats(
+    mtx_t* mutex,
+    struct Mdc_MtxProfileStats* stats
+) {
+  struct Slot* slot;
+  int result;
+
+  Mdc_McsLock_Lock(&registry_lock);
+
+  slot = FindSlot(mutex);
+  if (slot == NULL) {
+    result = thrd_error;
+  } else {
+    MergeShards(slot->profile, stats);
+    result = thrd_success;
+  }
+
+  Mdc_McsLock_Unlock(&registry_lock);
+
+  return result;
+}
+
+void Mdc_Mtx_ResetProfiles(void) {
+  size_t i;
+
+  Mdc_McsLock_Lock(&registry_lock);
+
+  for (i = 0; i < kSlotsCount; ++i) {
+    if (slots[i].profile != NULL) {
+      ResetShards(slots[i].profile);
+    }
+  }
+
+  Mdc_McsLock_Unlock(&registry_lock);
+}
+
+int Mdc_Mtx_PrintProfileReport(FILE* stream) {
+  struct Mdc_MtxProfileStats* all_stats;
+  size_t stats_count;
+  size_t i;
+  int result;
+
+  all_stats = Mdc_malloc(sizeof(all_stats[0]) * kMaxProfilesCount);
+  if (all_stats == NULL) {
+    return thrd_nomem;
+  }
+
+  result = thrd_success;
+
+  /* Names are only guaranteed to be valid while registered. */
+  Mdc_McsLock_Lock(&registry_lock);
+
+  stats_count = 0;
+  for (i = 0; i < kSlotsCount; ++i) {
+    if (slots[i].profile != NULL) {
+      MergeShards(slots[i].profile, &all_stats[stats_count]);
+      stats_count += 1;
+    }
+  }
+
+  qsort(
+      all_stats,
+      stats_count,
+      sizeof(all_stats[0]),
+      &CompareByTotalWaitDescending
+  );
+
+  if (fprintf(
+      stream,
+      "%-24s %14s %12s %7s %12s %12s %12s %12s %12s\n",
+      "mutex",
+      "acquisitions",
+      "contended",
+      "cont%",
+      "wait ms",
+      "wait avg us",
+      "wait p99 us",
+      "hold avg us",
+      "hold p99 us"
+  ) < 0) {
+    result = thrd_error;
+  }
+
+  for (i = 0; i < stats_count && result == thrd_success; ++i) {
+    if (PrintStats(stream, &all_stats[i]) < 0) {
+      result = thrd_error;
+    }
+  }
+
+  Mdc_McsLock_Unlock(&registry_lock);
+
+  Mdc_free(all_stats);
+
+  return result;
+}
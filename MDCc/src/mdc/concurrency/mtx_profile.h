@@ -0,0 +1,71 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_MTX_PROFILE_H_
+#define MDC_C_CONCURRENCY_MTX_PROFILE_H_
+
+#include "../../../include/mdc/std/stdint.h"
+#include "../../../include/mdc/std/threads.h"
+
+/*
+* Hooks through which mtx_t records lock contention statistics for
+* Mdc_Mtx_RegisterProfile.
+*/
+
+struct Mdc_MtxProfile;
+
+/**
+ * Returns the profile of the mutex, or NULL if profiling is disabled
+ * or the mutex is not registered.
+ */
+struct Mdc_MtxProfile* Mdc_MtxProfile_Find(mtx_t* mutex);
+
+/**
+ * Returns nonzero if any mutex is registered, regardless of whether
+ * profiling is enabled.
+ */
+int Mdc_MtxProfile_HasRegistered(void);
+
+/**
+ * Records that the calling thread acquired the mutex. If the mutex
+ * was contended, wait_start_time is the time at which the thread
+ * started waiting for it, from Mdc_MonotonicClock_GetNanoseconds.
+ */
+void Mdc_MtxProfile_RecordLock(
+    struct Mdc_MtxProfile* profile,
+    int is_contended,
+    uint64_t wait_start_time
+);
+
+/**
+ * Records that the calling thread is about to release the mutex.
+ */
+void Mdc_MtxProfile_RecordUnlock(struct Mdc_MtxProfile* profile);
+
+#endif /* MDC_C_CONCURRENCY_MTX_PROFILE_H_ */
@@ -0,0 +1,235 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/once_cell.h"
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "../../../include/mdc/std/threads.h"
+
+static int LoadState(struct Mdc_OnceCell* cell) {
+  return (int) atomic_load_explicit(&cell->state_, memory_order_acquire);
+}
+
+static int CompareExchangeState(
+    struct Mdc_OnceCell* cell,
+    int* expected,
+    int desired
+) {
+  /* On failure, the expected state is updated to the current one. */
+  return atomic_compare_exchange_strong_explicit(
+      &cell->state_,
+      expected,
+      desired,
+      memory_order_acquire,
+      memory_order_acquire
+  );
+}
+
+static int ExchangeState(struct Mdc_OnceCell* cell, int desired) {
+  return (int) atomic_exchange_explicit(
+      &cell->state_,
+      desired,
+      memory_order_release
+  );
+}
+
+#if defined(__linux__)
+
+#include <limits.h>
+
+#include "../std/threads/futex.h"
+
+static void WaitWhileRunning(struct Mdc_OnceCell* cell) {
+  /* The wait returns immediately if the state has since changed. */
+  Mdc_Futex_Wait(&cell->state_, Mdc_OnceCell_kRunningWithWaiters);
+}
+
+static void WakeWaiters(struct Mdc_OnceCell* cell) {
+  Mdc_Futex_Wake(&cell->state_, INT_MAX);
+}
+
+#else
+
+/*
+* Initialization is rare and short, so every cell shares one mutex
+* and condition variable to wait on. They are set up on first use so
+* that cells can be statically initialized.
+*/
+
+static once_flag wait_once_flag = ONCE_FLAG_INIT;
+static mtx_t wait_mutex;
+static cnd_t wait_cond;
+static int is_wait_init = 0;
+
+static void InitWaitObjects(void) {
+  if (mtx_init(&wait_mutex, mtx_plain) != thrd_success) {
+    return;
+  }
+
+  if (cnd_init(&wait_cond) != thrd_success) {
+    mtx_destroy(&wait_mutex);
+    return;
+  }
+
+  is_wait_init = 1;
+}
+
+static void WaitWhileRunning(struct Mdc_OnceCell* cell) {
+  call_once(&wait_once_flag, &InitWaitObjects);
+
+  if (!is_wait_init) {
+    thrd_yield();
+    return;
+  }
+
+  mtx_lock(&wait_mutex);
+  while (LoadState(cell) == Mdc_OnceCell_kRunningWithWaiters) {
+    cnd_wait(&wait_cond, &wait_mutex);
+  }
+  mtx_unlock(&wait_mutex);
+}
+
+static void WakeWaiters(struct Mdc_OnceCell* cell) {
+  /*
+  * Waiters check the state while holding the mutex, so locking it
+  * here ensures that none of them can miss the wakeup.
+  */
+  call_once(&wait_once_flag, &InitWaitObjects);
+
+  if (!is_wait_init) {
+    return;
+  }
+
+  mtx_lock(&wait_mutex);
+  cnd_broadcast(&wait_cond);
+  mtx_unlock(&wait_mutex);
+}
+
+#endif
+
+void Mdc_OnceCell_Init(struct Mdc_OnceCell* cell) {
+  cell->state_ = Mdc_OnceCell_kUninitialized;
+  cell->value_ = NULL;
+}
+
+void Mdc_OnceCell_Deinit(struct Mdc_OnceCell* cell) {
+  (void) cell;
+}
+
+void* Mdc_OnceCell_Get(
+    struct Mdc_OnceCell* cell,
+    void* (*init)(void* context),
+    void* context
+) {
+  void* value;
+
+  if (!Mdc_OnceCell_BeginInit(cell)) {
+    return cell->value_;
+  }
+
+  value = init(context);
+  if (value == NULL) {
+    Mdc_OnceCell_AbortInit(cell);
+    return NULL;
+  }
+
+  Mdc_OnceCell_CommitInit(cell, value);
+
+  return value;
+}
+
+void* Mdc_OnceCell_TryGet(struct Mdc_OnceCell* cell) {
+  if (LoadState(cell) != Mdc_OnceCell_kReady) {
+    return NULL;
+  }
+
+  return cell->value_;
+}
+
+int Mdc_OnceCell_IsReady(struct Mdc_OnceCell* cell) {
+  return LoadState(cell) == Mdc_OnceCell_kReady;
+}
+
+int Mdc_OnceCell_BeginInit(struct Mdc_OnceCell* cell) {
+  int state;
+
+  state = LoadState(cell);
+
+  for (;;) {
+    switch (state) {
+      case Mdc_OnceCell_kReady: {
+        return 0;
+      }
+
+      case Mdc_OnceCell_kUninitialized: {
+        if (CompareExchangeState(cell, &state, Mdc_OnceCell_kRunning)) {
+          return 1;
+        }
+
+        break;
+      }
+
+      case Mdc_OnceCell_kRunning: {
+        /* The initializer only wakes waiters if it is told of them. */
+        if (CompareExchangeState(
+            cell,
+            &state,
+            Mdc_OnceCell_kRunningWithWaiters
+        )) {
+          state = Mdc_OnceCell_kRunningWithWaiters;
+        }
+
+        break;
+      }
+
+      default: {
+        WaitWhileRunning(cell);
+        state = LoadState(cell);
+
+        break;
+      }
+    }
+  }
+}
+
+void Mdc_OnceCell_CommitInit(struct Mdc_OnceCell* cell, void* value) {
+  cell->value_ = value;
+
+  if (ExchangeState(cell, Mdc_OnceCell_kReady)
+      == Mdc_OnceCell_kRunningWithWaiters) {
+    WakeWaiters(cell);
+  }
+}
+
+void Mdc_OnceCell_AbortInit(struct Mdc_OnceCell* cell) {
+  if (ExchangeState(cell, Mdc_OnceCell_kUninitialized)
+      == Mdc_OnceCell_kRunningWithWaiters) {
+    WakeWaiters(cell);
+  }
+}
@@ -0,0 +1,46 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_POWER_OF_TWO_H_
+#define MDC_C_CONCURRENCY_POWER_OF_TWO_H_
+
+#include <stddef.h>
+
+/*
+* Ring and queue capacities are kept to powers of two, so that an
+* index is wrapped with a mask instead of a division.
+*/
+
+/**
+ * Returns the smallest power of two that is at least the value, or 0
+ * if that power of two does not fit in a size_t.
+ */
+size_t Mdc_PowerOfTwo_RoundUp(size_t value);
+
+#endif /* MDC_C_CONCURRENCY_POWER_OF_TWO_H_ */
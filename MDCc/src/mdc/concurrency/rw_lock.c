@@ -0,0 +1,351 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/rw_lock.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+/*
+* Windows XP has no native reader-writer lock, so the lock is built
+* on the threads shim. Readers wait while a writer is active or
+* waiting, which gives writers preference.
+*/
+
+int Mdc_RwLock_Init(struct Mdc_RwLock* rw_lock) {
+  int result;
+
+  rw_lock->readers_count_ = 0;
+  rw_lock->waiting_writers_count_ = 0;
+  rw_lock->is_writer_active_ = 0;
+
+  result = mtx_init(&rw_lock->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = cnd_init(&rw_lock->readers_cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  result = cnd_init(&rw_lock->writers_cond_);
+  if (result != thrd_success) {
+    goto destroy_readers_cond;
+  }
+
+  return thrd_success;
+
+destroy_readers_cond:
+  cnd_destroy(&rw_lock->readers_cond_);
+
+destroy_mutex:
+  mtx_destroy(&rw_lock->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_RwLock_Deinit(struct Mdc_RwLock* rw_lock) {
+  cnd_destroy(&rw_lock->writers_cond_);
+  cnd_destroy(&rw_lock->readers_cond_);
+  mtx_destroy(&rw_lock->mutex_);
+}
+
+static int IsReaderBlocked(const struct Mdc_RwLock* rw_lock) {
+  return rw_lock->is_writer_active_ || rw_lock->waiting_writers_count_ > 0;
+}
+
+static int IsWriterBlocked(const struct Mdc_RwLock* rw_lock) {
+  return rw_lock->is_writer_active_ || rw_lock->readers_count_ > 0;
+}
+
+static int LockSharedUntil(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  wait_result = thrd_success;
+  while (IsReaderBlocked(rw_lock) && wait_result == thrd_success) {
+    if (time_point == NULL) {
+      wait_result = cnd_wait(&rw_lock->readers_cond_, &rw_lock->mutex_);
+    } else {
+      wait_result = cnd_timedwait(
+          &rw_lock->readers_cond_,
+          &rw_lock->mutex_,
+          time_point
+      );
+    }
+  }
+
+  if (wait_result == thrd_success) {
+    rw_lock->readers_count_ += 1;
+  }
+
+  mtx_unlock(&rw_lock->mutex_);
+
+  return wait_result;
+}
+
+static int LockUntil(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  rw_lock->waiting_writers_count_ += 1;
+
+  wait_result = thrd_success;
+  while (IsWriterBlocked(rw_lock) && wait_result == thrd_success) {
+    if (time_point == NULL) {
+      wait_result = cnd_wait(&rw_lock->writers_cond_, &rw_lock->mutex_);
+    } else {
+      wait_result = cnd_timedwait(
+          &rw_lock->writers_cond_,
+          &rw_lock->mutex_,
+          time_point
+      );
+    }
+  }
+
+  rw_lock->waiting_writers_count_ -= 1;
+
+  if (wait_result == thrd_success) {
+    rw_lock->is_writer_active_ = 1;
+  } else if (!IsReaderBlocked(rw_lock)) {
+    /* Readers held back by this writer may now proceed. */
+    cnd_broadcast(&rw_lock->readers_cond_);
+  }
+
+  mtx_unlock(&rw_lock->mutex_);
+
+  return wait_result;
+}
+
+int Mdc_RwLock_LockShared(struct Mdc_RwLock* rw_lock) {
+  return LockSharedUntil(rw_lock, NULL);
+}
+
+int Mdc_RwLock_TryLockShared(struct Mdc_RwLock* rw_lock) {
+  int result;
+
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  if (IsReaderBlocked(rw_lock)) {
+    result = thrd_busy;
+  } else {
+    rw_lock->readers_count_ += 1;
+    result = thrd_success;
+  }
+
+  mtx_unlock(&rw_lock->mutex_);
+
+  return result;
+}
+
+int Mdc_RwLock_TimedLockShared(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  return LockSharedUntil(rw_lock, time_point);
+}
+
+int Mdc_RwLock_UnlockShared(struct Mdc_RwLock* rw_lock) {
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  rw_lock->readers_count_ -= 1;
+
+  if (rw_lock->readers_count_ == 0
+      && rw_lock->waiting_writers_count_ > 0) {
+    cnd_signal(&rw_lock->writers_cond_);
+  }
+
+  return mtx_unlock(&rw_lock->mutex_);
+}
+
+int Mdc_RwLock_Lock(struct Mdc_RwLock* rw_lock) {
+  return LockUntil(rw_lock, NULL);
+}
+
+int Mdc_RwLock_TryLock(struct Mdc_RwLock* rw_lock) {
+  int result;
+
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  if (IsWriterBlocked(rw_lock)) {
+    result = thrd_busy;
+  } else {
+    rw_lock->is_writer_active_ = 1;
+    result = thrd_success;
+  }
+
+  mtx_unlock(&rw_lock->mutex_);
+
+  return result;
+}
+
+int Mdc_RwLock_TimedLock(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  return LockUntil(rw_lock, time_point);
+}
+
+int Mdc_RwLock_Unlock(struct Mdc_RwLock* rw_lock) {
+  if (mtx_lock(&rw_lock->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  rw_lock->is_writer_active_ = 0;
+
+  if (rw_lock->waiting_writers_count_ > 0) {
+    cnd_signal(&rw_lock->writers_cond_);
+  } else {
+    cnd_broadcast(&rw_lock->readers_cond_);
+  }
+
+  return mtx_unlock(&rw_lock->mutex_);
+}
+
+#elif defined(__GNUC__)
+
+#include <errno.h>
+
+static int ToThreadsResult(int result) {
+  switch (result) {
+    case 0: {
+      return thrd_success;
+    }
+
+    case EBUSY: {
+      return thrd_busy;
+    }
+
+    case ETIMEDOUT: {
+      return thrd_timedout;
+    }
+
+    case ENOMEM: {
+      return thrd_nomem;
+    }
+
+    default: {
+      return thrd_error;
+    }
+  }
+}
+
+int Mdc_RwLock_Init(struct Mdc_RwLock* rw_lock) {
+  pthread_rwlockattr_t attr;
+  int result;
+
+  result = pthread_rwlockattr_init(&attr);
+  if (result != 0) {
+    return ToThreadsResult(result);
+  }
+
+#if defined(__GLIBC__)
+  /*
+  * glibc prefers readers by default, which lets a steady stream of
+  * readers starve writers.
+  */
+  pthread_rwlockattr_setkind_np(
+      &attr,
+      PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP
+  );
+#endif
+
+  result = pthread_rwlock_init(&rw_lock->rwlock_, &attr);
+
+  pthread_rwlockattr_destroy(&attr);
+
+  return ToThreadsResult(result);
+}
+
+void Mdc_RwLock_Deinit(struct Mdc_RwLock* rw_lock) {
+  pthread_rwlock_destroy(&rw_lock->rwlock_);
+}
+
+int Mdc_RwLock_LockShared(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_rdlock(&rw_lock->rwlock_));
+}
+
+int Mdc_RwLock_TryLockShared(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_tryrdlock(&rw_lock->rwlock_));
+}
+
+int Mdc_RwLock_TimedLockShared(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  return ToThreadsResult(
+      pthread_rwlock_timedrdlock(&rw_lock->rwlock_, time_point)
+  );
+}
+
+int Mdc_RwLock_UnlockShared(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_unlock(&rw_lock->rwlock_));
+}
+
+int Mdc_RwLock_Lock(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_wrlock(&rw_lock->rwlock_));
+}
+
+int Mdc_RwLock_TryLock(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_trywrlock(&rw_lock->rwlock_));
+}
+
+int Mdc_RwLock_TimedLock(
+    struct Mdc_RwLock* rw_lock,
+    const struct timespec* time_point
+) {
+  return ToThreadsResult(
+      pthread_rwlock_timedwrlock(&rw_lock->rwlock_, time_point)
+  );
+}
+
+int Mdc_RwLock_Unlock(struct Mdc_RwLock* rw_lock) {
+  return ToThreadsResult(pthread_rwlock_unlock(&rw_lock->rwlock_));
+}
+
+#endif
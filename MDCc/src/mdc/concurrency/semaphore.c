@@ -0,0 +1,293 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/semaphore.h"
+
+#if defined(__linux__)
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "../std/threads/futex.h"
+
+static int TryDecrement(struct Mdc_Semaphore* semaphore) {
+  int count;
+
+  count = (int) atomic_load_explicit(
+      &semaphore->count_,
+      memory_order_relaxed
+  );
+
+  while (count > 0) {
+    /* On failure, the count is updated to the current one. */
+    if (atomic_compare_exchange_weak_explicit(
+        &semaphore->count_,
+        &count,
+        count - 1,
+        memory_order_acquire,
+        memory_order_relaxed
+    )) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*
+* A waiter counts itself and then checks the count, while a releaser
+* adds to the count and then checks the waiters. The fences ensure
+* that at least one of them sees the other's write. A release that
+* lands between the check and the futex wait changes the futex word,
+* so the wait returns immediately.
+*/
+
+static int AcquireUntil(
+    struct Mdc_Semaphore* semaphore,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (TryDecrement(semaphore)) {
+    return thrd_success;
+  }
+
+  atomic_fetch_add_explicit(
+      &semaphore->waiting_count_,
+      1,
+      memory_order_relaxed
+  );
+  atomic_thread_fence(memory_order_seq_cst);
+
+  wait_result = thrd_success;
+  while (!TryDecrement(semaphore)) {
+    if (time_point == NULL) {
+      wait_result = Mdc_Futex_Wait(&semaphore->count_, 0);
+    } else {
+      wait_result = Mdc_Futex_WaitUntil(
+          &semaphore->count_,
+          0,
+          time_point,
+          CLOCK_REALTIME
+      );
+    }
+
+    if (wait_result != thrd_success) {
+      if (wait_result == thrd_timedout && TryDecrement(semaphore)) {
+        wait_result = thrd_success;
+      }
+
+      break;
+    }
+  }
+
+  atomic_fetch_sub_explicit(
+      &semaphore->waiting_count_,
+      1,
+      memory_order_relaxed
+  );
+
+  return wait_result;
+}
+
+int Mdc_Semaphore_Init(struct Mdc_Semaphore* semaphore, int count) {
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  semaphore->count_ = count;
+  semaphore->waiting_count_ = 0;
+
+  return thrd_success;
+}
+
+void Mdc_Semaphore_Deinit(struct Mdc_Semaphore* semaphore) {
+  (void) semaphore;
+}
+
+int Mdc_Semaphore_Acquire(struct Mdc_Semaphore* semaphore) {
+  return AcquireUntil(semaphore, NULL);
+}
+
+int Mdc_Semaphore_TryAcquire(struct Mdc_Semaphore* semaphore) {
+  return TryDecrement(semaphore) ? thrd_success : thrd_busy;
+}
+
+int Mdc_Semaphore_TimedAcquire(
+    struct Mdc_Semaphore* semaphore,
+    const struct timespec* time_point
+) {
+  return AcquireUntil(semaphore, time_point);
+}
+
+int Mdc_Semaphore_Release(struct Mdc_Semaphore* semaphore, int count) {
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  atomic_fetch_add_explicit(&semaphore->count_, count, memory_order_release);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (atomic_load_explicit(&semaphore->waiting_count_, memory_order_relaxed)
+      == 0) {
+    return thrd_success;
+  }
+
+  return Mdc_Futex_Wake(&semaphore->count_, count);
+}
+
+#else
+
+int Mdc_Semaphore_Init(struct Mdc_Semaphore* semaphore, int count) {
+  int result;
+
+  if (count < 0) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  semaphore->count_ = count;
+  semaphore->waiting_count_ = 0;
+
+  result = mtx_init(&semaphore->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = cnd_init(&semaphore->cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  return thrd_success;
+
+destroy_mutex:
+  mtx_destroy(&semaphore->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_Semaphore_Deinit(struct Mdc_Semaphore* semaphore) {
+  cnd_destroy(&semaphore->cond_);
+  mtx_destroy(&semaphore->mutex_);
+}
+
+static int AcquireUntil(
+    struct Mdc_Semaphore* semaphore,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (mtx_lock(&semaphore->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  semaphore->waiting_count_ += 1;
+
+  wait_result = thrd_success;
+  while (semaphore->count_ == 0 && wait_result == thrd_success) {
+    if (time_point == NULL) {
+      wait_result = cnd_wait(&semaphore->cond_, &semaphore->mutex_);
+    } else {
+      wait_result = cnd_timedwait(
+          &semaphore->cond_,
+          &semaphore->mutex_,
+          time_point
+      );
+    }
+  }
+
+  semaphore->waiting_count_ -= 1;
+
+  if (semaphore->count_ > 0) {
+    semaphore->count_ -= 1;
+    wait_result = thrd_success;
+  }
+
+  mtx_unlock(&semaphore->mutex_);
+
+  return wait_result;
+}
+
+int Mdc_Semaphore_Acquire(struct Mdc_Semaphore* semaphore) {
+  return AcquireUntil(semaphore, NULL);
+}
+
+int Mdc_Semaphore_TryAcquire(struct Mdc_Semaphore* semaphore) {
+  int result;
+
+  if (mtx_lock(&semaphore->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  if (semaphore->count_ > 0) {
+    semaphore->count_ -= 1;
+    result = thrd_success;
+  } else {
+    result = thrd_busy;
+  }
+
+  mtx_unlock(&semaphore->mutex_);
+
+  return result;
+}
+
+int Mdc_Semaphore_TimedAcquire(
+    struct Mdc_Semaphore* semaphore,
+    const struct timespec* time_point
+) {
+  return AcquireUntil(semaphore, time_point);
+}
+
+int Mdc_Semaphore_Release(struct Mdc_Semaphore* semaphore, int count) {
+  int result;
+
+  if (count < 0) {
+    return thrd_error;
+  }
+
+  if (mtx_lock(&semaphore->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  semaphore->count_ += count;
+
+  if (semaphore->waiting_count_ == 0) {
+    result = thrd_success;
+  } else if (count == 1) {
+    result = cnd_signal(&semaphore->cond_);
+  } else {
+    result = cnd_broadcast(&semaphore->cond_);
+  }
+
+  mtx_unlock(&semaphore->mutex_);
+
+  return result;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "sharded_counter.h"
+
+#include "../../../include/mdc/concurrency/thread_local.h"
+#include "../../../include/mdc/std/stdatomic.h"
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+
+static atomic_uint next_shard_index;
+
+/* Holds the index plus one, so that 0 means not yet assigned. */
+static MDC_THREAD_LOCAL unsigned int current_shard_index = 0;
+
+size_t Mdc_ShardedCounter_GetShardIndex(void) {
+  if (current_shard_index == 0) {
+    current_shard_index = (unsigned int) atomic_fetch_add_explicit(
+        &next_shard_index,
+        1,
+        memory_order_relaxed
+    ) % Mdc_ShardedCounter_kShardsCount + 1;
+  }
+
+  return current_shard_index - 1;
+}
+
+#else
+
+size_t Mdc_ShardedCounter_GetShardIndex(void) {
+  /*
+  * Threads run on separate stacks, so a local's address tells them
+  * apart. Stacks are usually placed a power of two apart, which
+  * leaves the low bits of the stack's address the same for every
+  * thread, so the shard is taken from the top bits of a multiplicative
+  * hash of the address.
+  */
+  char local;
+  uint32_t hash;
+
+  hash = (uint32_t) ((uintptr_t) &local >> 16) * 0x9E3779B1u;
+
+  return (size_t) (hash >> (32 - Mdc_ShardedCounter_kShardIndexBits));
+}
+
+#endif
+
+void Mdc_ShardedCounter_Add(
+    struct Mdc_ShardedCounter* counter,
+    uint64_t value
+) {
+  size_t word_value;
+  size_t old_low;
+
+  word_value = (value > (size_t) -1) ? (size_t) -1 : (size_t) value;
+
+  old_low = (size_t) atomic_fetch_add_explicit(
+      &counter->low_,
+      word_value,
+      memory_order_relaxed
+  );
+
+  if ((size_t) (old_low + word_value) < old_low) {
+    atomic_fetch_add_explicit(&counter->high_, 1, memory_order_relaxed);
+  }
+}
+
+uint64_t Mdc_ShardedCounter_Load(struct Mdc_ShardedCounter* counter) {
+  size_t high;
+  size_t low;
+
+  do {
+    high = (size_t) atomic_load_explicit(
+        &counter->high_,
+        memory_order_relaxed
+    );
+    low = (size_t) atomic_load_explicit(
+        &counter->low_,
+        memory_order_relaxed
+    );
+  } while (high != (size_t) atomic_load_explicit(
+      &counter->high_,
+      memory_order_relaxed
+  ));
+
+  if (sizeof(size_t) >= sizeof(uint64_t)) {
+    return low;
+  }
+
+  return ((uint64_t) high << 32) | low;
+}
+
+void Mdc_ShardedCounter_Reset(struct Mdc_ShardedCounter* counter) {
+  atomic_store_explicit(&counter->high_, 0, memory_order_relaxed);
+  atomic_store_explicit(&counter->low_, 0, memory_order_relaxed);
+}
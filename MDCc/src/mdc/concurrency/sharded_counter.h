@@ -0,0 +1,96 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_SHARDED_COUNTER_H_
+#define MDC_C_CONCURRENCY_SHARDED_COUNTER_H_
+
+#include <stddef.h>
+
+#include "../../../include/mdc/std/stdint.h"
+
+/*
+* Statistics counters that are spread over shards, so that threads
+* recording at the same time mostly update different cache lines.
+* A user keeps an array of Mdc_ShardedCounter_kShardsCount shards,
+* each holding its own counters, and records into the shard of the
+* current thread. Readers sum the counters of every shard.
+*/
+
+enum {
+  Mdc_ShardedCounter_kCacheLineSize = 64,
+  Mdc_ShardedCounter_kShardIndexBits = 4,
+  Mdc_ShardedCounter_kShardsCount = 1 << Mdc_ShardedCounter_kShardIndexBits
+};
+
+/*
+* The number of padding bytes after counters of the specified size, so
+* that each shard of an array starts on its own cache line.
+*/
+#define MDC_C_CONCURRENCY_SHARDED_COUNTER_PADDING_SIZE_(size) \
+    (Mdc_ShardedCounter_kCacheLineSize \
+        - (size) % Mdc_ShardedCounter_kCacheLineSize)
+
+/*
+* Counters are word-sized so that every platform can update them with
+* its atomic operations. When the low word wraps, which only happens
+* on 32-bit targets, it carries into the high word. A reader racing a
+* carry may briefly see a value that is too low.
+*/
+struct Mdc_ShardedCounter {
+  size_t low_;
+  size_t high_;
+};
+
+/**
+ * Returns the index of the shard that the current thread records
+ * into. The index is the same for every array of shards.
+ */
+size_t Mdc_ShardedCounter_GetShardIndex(void);
+
+/**
+ * Adds the value to the counter. A value that does not fit in a word
+ * is clamped to the largest word value.
+ */
+void Mdc_ShardedCounter_Add(
+    struct Mdc_ShardedCounter* counter,
+    uint64_t value
+);
+
+/**
+ * Returns the value of the counter.
+ */
+uint64_t Mdc_ShardedCounter_Load(struct Mdc_ShardedCounter* counter);
+
+/**
+ * Sets the counter to zero. Additions that race the reset may be
+ * partly lost.
+ */
+void Mdc_ShardedCounter_Reset(struct Mdc_ShardedCounter* counter);
+
+#endif /* MDC_C_CONCURRENCY_SHARDED_COUNTER_H_ */
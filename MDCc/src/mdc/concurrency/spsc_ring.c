@@ -0,0 +1,405 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/spsc_ring.h"
+
+#include <string.h>
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+#include "power_of_two.h"
+
+/*
+* The indices grow without bound and wrap around. The number of
+* elements in the ring is always their unsigned difference.
+*/
+
+static void CopyIn(
+    struct Mdc_SpscRing* ring,
+    size_t index,
+    const unsigned char* elements,
+    size_t count
+) {
+  size_t offset;
+  size_t first_count;
+
+  offset = index & ring->mask_;
+  first_count = (ring->mask_ + 1) - offset;
+  if (first_count > count) {
+    first_count = count;
+  }
+
+  memcpy(
+      &ring->elements_[offset * ring->element_size_],
+      elements,
+      first_count * ring->element_size_
+  );
+  memcpy(
+      ring->elements_,
+      &elements[first_count * ring->element_size_],
+      (count - first_count) * ring->element_size_
+  );
+}
+
+static void CopyOut(
+    const struct Mdc_SpscRing* ring,
+    size_t index,
+    unsigned char* elements,
+    size_t count
+) {
+  size_t offset;
+  size_t first_count;
+
+  offset = index & ring->mask_;
+  first_count = (ring->mask_ + 1) - offset;
+  if (first_count > count) {
+    first_count = count;
+  }
+
+  memcpy(
+      elements,
+      &ring->elements_[offset * ring->element_size_],
+      first_count * ring->element_size_
+  );
+  memcpy(
+      &elements[first_count * ring->element_size_],
+      ring->elements_,
+      (count - first_count) * ring->element_size_
+  );
+}
+
+/*
+* A waiter sets its flag and then checks the ring, while the other
+* side updates its index and then checks the flag. The fences ensure
+* that at least one of them sees the other's write, so a wakeup is
+* never lost.
+*/
+
+static void WakeWaiter(
+    struct Mdc_SpscRing* ring,
+    long* is_waiting,
+    cnd_t* cond
+) {
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (!atomic_load_explicit(is_waiting, memory_order_relaxed)) {
+    return;
+  }
+
+  mtx_lock(&ring->mutex_);
+  cnd_signal(cond);
+  mtx_unlock(&ring->mutex_);
+}
+
+static int IsEmpty(struct Mdc_SpscRing* ring) {
+  return (size_t) atomic_load_explicit(&ring->tail_, memory_order_acquire)
+      == ring->head_;
+}
+
+static int IsFull(struct Mdc_SpscRing* ring) {
+  size_t head;
+
+  head = (size_t) atomic_load_explicit(&ring->head_, memory_order_acquire);
+
+  return ring->tail_ - head > ring->mask_;
+}
+
+static int Wait(
+    struct Mdc_SpscRing* ring,
+    long* is_waiting,
+    cnd_t* cond,
+    int (*is_blocked)(struct Mdc_SpscRing*)
+) {
+  int wait_result;
+
+  if (!(ring->flags_ & Mdc_SpscRing_kBlocking)) {
+    return thrd_error;
+  }
+
+  if (mtx_lock(&ring->mutex_) != thrd_success) {
+    return thrd_error;
+  }
+
+  atomic_store_explicit(is_waiting, 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  wait_result = thrd_success;
+  while (is_blocked(ring) && wait_result == thrd_success) {
+    wait_result = cnd_wait(cond, &ring->mutex_);
+  }
+
+  atomic_store_explicit(is_waiting, 0, memory_order_relaxed);
+
+  mtx_unlock(&ring->mutex_);
+
+  return wait_result;
+}
+
+int Mdc_SpscRing_Init(
+    struct Mdc_SpscRing* ring,
+    size_t element_size,
+    size_t capacity,
+    int flags
+) {
+  int result;
+
+  /* Reject capacities that cannot be rounded up or allocated. */
+  capacity = Mdc_PowerOfTwo_RoundUp(capacity);
+  if (capacity == 0) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  if (element_size != 0 && capacity > (size_t) -1 / element_size) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  ring->elements_ = Mdc_malloc(capacity * element_size);
+  if (ring->elements_ == NULL) {
+    result = thrd_nomem;
+    goto return_bad;
+  }
+
+  ring->head_ = 0;
+  ring->cached_tail_ = 0;
+  ring->tail_ = 0;
+  ring->cached_head_ = 0;
+
+  ring->element_size_ = element_size;
+  ring->mask_ = capacity - 1;
+
+  ring->flags_ = flags;
+  ring->is_consumer_waiting_ = 0;
+  ring->is_producer_waiting_ = 0;
+
+  if (!(flags & Mdc_SpscRing_kBlocking)) {
+    return thrd_success;
+  }
+
+  result = mtx_init(&ring->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto free_elements;
+  }
+
+  result = cnd_init(&ring->not_empty_cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  result = cnd_init(&ring->not_full_cond_);
+  if (result != thrd_success) {
+    goto destroy_not_empty_cond;
+  }
+
+  return thrd_success;
+
+destroy_not_empty_cond:
+  cnd_destroy(&ring->not_empty_cond_);
+
+destroy_mutex:
+  mtx_destroy(&ring->mutex_);
+
+free_elements:
+  Mdc_free(ring->elements_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_SpscRing_Deinit(struct Mdc_SpscRing* ring) {
+  if (ring->flags_ & Mdc_SpscRing_kBlocking) {
+    cnd_destroy(&ring->not_full_cond_);
+    cnd_destroy(&ring->not_empty_cond_);
+    mtx_destroy(&ring->mutex_);
+  }
+
+  Mdc_free(ring->elements_);
+}
+
+size_t Mdc_SpscRing_GetCapacity(const struct Mdc_SpscRing* ring) {
+  return ring->mask_ + 1;
+}
+
+size_t Mdc_SpscRing_TryPushBatch(
+    struct Mdc_SpscRing* ring,
+    const void* elements,
+    size_t count
+) {
+  size_t tail;
+  size_t free_count;
+
+  tail = ring->tail_;
+
+  /* Only look at the consumer's index if the cached one is too old. */
+  free_count = (ring->mask_ + 1) - (tail - ring->cached_head_);
+  if (free_count < count) {
+    ring->cached_head_ = (size_t) atomic_load_explicit(
+        &ring->head_,
+        memory_order_acquire
+    );
+    free_count = (ring->mask_ + 1) - (tail - ring->cached_head_);
+  }
+
+  if (count > free_count) {
+    count = free_count;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  CopyIn(ring, tail, elements, count);
+  atomic_store_explicit(&ring->tail_, tail + count, memory_order_release);
+
+  if (ring->flags_ & Mdc_SpscRing_kBlocking) {
+    WakeWaiter(ring, &ring->is_consumer_waiting_, &ring->not_empty_cond_);
+  }
+
+  return count;
+}
+
+size_t Mdc_SpscRing_TryPopBatch(
+    struct Mdc_SpscRing* ring,
+    void* elements,
+    size_t max_count
+) {
+  size_t head;
+  size_t count;
+
+  head = ring->head_;
+
+  /* Only look at the producer's index if the cached one is too old. */
+  count = ring->cached_tail_ - head;
+  if (count < max_count) {
+    ring->cached_tail_ = (size_t) atomic_load_explicit(
+        &ring->tail_,
+        memory_order_acquire
+    );
+    count = ring->cached_tail_ - head;
+  }
+
+  if (count > max_count) {
+    count = max_count;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  CopyOut(ring, head, elements, count);
+  atomic_store_explicit(&ring->head_, head + count, memory_order_release);
+
+  if (ring->flags_ & Mdc_SpscRing_kBlocking) {
+    WakeWaiter(ring, &ring->is_producer_waiting_, &ring->not_full_cond_);
+  }
+
+  return count;
+}
+
+int Mdc_SpscRing_TryPush(struct Mdc_SpscRing* ring, const void* element) {
+  return Mdc_SpscRing_TryPushBatch(ring, element, 1) != 0;
+}
+
+int Mdc_SpscRing_TryPop(struct Mdc_SpscRing* ring, void* element) {
+  return Mdc_SpscRing_TryPopBatch(ring, element, 1) != 0;
+}
+
+int Mdc_SpscRing_PushBatch(
+    struct Mdc_SpscRing* ring,
+    const void* elements,
+    size_t count
+) {
+  const unsigned char* remaining_elements;
+  size_t pushed_count;
+  int wait_result;
+
+  remaining_elements = elements;
+
+  for (;;) {
+    pushed_count = Mdc_SpscRing_TryPushBatch(
+        ring,
+        remaining_elements,
+        count
+    );
+
+    remaining_elements += pushed_count * ring->element_size_;
+    count -= pushed_count;
+
+    if (count == 0) {
+      return thrd_success;
+    }
+
+    wait_result = Wait(
+        ring,
+        &ring->is_producer_waiting_,
+        &ring->not_full_cond_,
+        &IsFull
+    );
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+}
+
+int Mdc_SpscRing_PopBatch(
+    struct Mdc_SpscRing* ring,
+    void* elements,
+    size_t max_count,
+    size_t* popped_count
+) {
+  int wait_result;
+
+  for (;;) {
+    *popped_count = Mdc_SpscRing_TryPopBatch(ring, elements, max_count);
+    if (*popped_count != 0 || max_count == 0) {
+      return thrd_success;
+    }
+
+    wait_result = Wait(
+        ring,
+        &ring->is_consumer_waiting_,
+        &ring->not_empty_cond_,
+        &IsEmpty
+    );
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+  }
+}
+
+int Mdc_SpscRing_Push(struct Mdc_SpscRing* ring, const void* element) {
+  return Mdc_SpscRing_PushBatch(ring, element, 1);
+}
+
+int Mdc_SpscRing_Pop(struct Mdc_SpscRing* ring, void* element) {
+  size_t popped_count;
+
+  return Mdc_SpscRing_PopBatch(ring, element, 1, &popped_count);
+}
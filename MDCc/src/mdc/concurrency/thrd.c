@@ -0,0 +1,617 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "../../../include/mdc/concurrency/thrd.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <windows.h>
+#elif defined(__GNUC__)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "../../../include/mdc/concurrency/thread_local.h"
+#include "../../../include/mdc/std/stdint.h"
+#include "cpu_pause.h"
+#include "monotonic_clock.h"
+
+void Mdc_ThrdAttributes_Init(struct Mdc_ThrdAttributes* attributes) {
+  attributes->stack_size = 0;
+  attributes->name = NULL;
+  attributes->affinity_mask = 0;
+}
+
+size_t Mdc_Thrd_GetHardwareConcurrency(void) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  SYSTEM_INFO system_info;
+
+  GetSystemInfo(&system_info);
+
+  return system_info.dwNumberOfProcessors;
+#elif defined(__GNUC__)
+  long processors_count;
+
+  processors_count = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return (processors_count > 0) ? (size_t) processors_count : 1;
+#endif
+}
+
+enum {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  /* Sleep rounds up to the system timer tick, 1 to 15.6 ms. */
+  kInitialSpinMarginNanoseconds = 2000000,
+  kMaxSpinMarginNanoseconds = 4000000
+#elif defined(__GNUC__)
+  /* Covers the default 50 us timer slack plus the wakeup latency. */
+  kInitialSpinMarginNanoseconds = 100000,
+  kMaxSpinMarginNanoseconds = 500000
+#endif
+};
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+/* The spin margin carried over from the previous call on the thread. */
+static MDC_THREAD_LOCAL uint64_t learned_spin_margin = 0;
+#endif
+
+void Mdc_Thrd_PreciseSleep(const struct timespec* duration) {
+  uint64_t now;
+  uint64_t deadline;
+  uint64_t wake_time;
+  uint64_t sleep_time;
+  uint64_t spin_margin;
+  struct timespec sleep_duration;
+
+  if (duration->tv_sec < 0 || duration->tv_nsec < 0) {
+    return;
+  }
+
+  now = Mdc_MonotonicClock_GetNanoseconds();
+  deadline = now
+      + (uint64_t) duration->tv_sec * 1000000000
+      + (uint64_t) duration->tv_nsec;
+  spin_margin = kInitialSpinMarginNanoseconds;
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+  if (learned_spin_margin > spin_margin) {
+    spin_margin = learned_spin_margin;
+  }
+#endif
+
+  /*
+  * Sleep through all but the margin, then spin out the rest. A late
+  * wakeup widens the margin, up to a cap so that a preemption does
+  * not turn later calls into long busy waits.
+  */
+  if (deadline - now > spin_margin) {
+    sleep_time = deadline - now - spin_margin;
+
+    sleep_duration.tv_sec = (time_t) (sleep_time / 1000000000);
+    sleep_duration.tv_nsec = (long) (sleep_time % 1000000000);
+
+    wake_time = now + sleep_time;
+
+    /* Resume with the remaining time if interrupted by a signal. */
+    while (thrd_sleep(&sleep_duration, &sleep_duration) == -1) {
+    }
+
+    now = Mdc_MonotonicClock_GetNanoseconds();
+
+    if (now > wake_time && now - wake_time > spin_margin) {
+      spin_margin = now - wake_time;
+    }
+
+    if (spin_margin > kMaxSpinMarginNanoseconds) {
+      spin_margin = kMaxSpinMarginNanoseconds;
+    }
+  }
+
+  while (now < deadline) {
+    MDC_CPU_PAUSE();
+    now = Mdc_MonotonicClock_GetNanoseconds();
+  }
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+  /* Decay, so that a one-off late wakeup is not paid for forever. */
+  learned_spin_margin = spin_margin - spin_margin / 8;
+#endif
+}
+
+#if __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__)
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+
+/*
+* The function and argument are passed to the new thread through a
+* start block. Blocks are claimed from a fixed pool and released by
+* the new thread as soon as it has copied them, so spawning does not
+* touch the heap unless more threads than the pool holds are starting
+* at once.
+*/
+
+enum {
+  kStartBlocksCount = 64,
+
+  /* Linux thread names are limited to 16 bytes, including the null. */
+  kMaxThreadNameLength = 15
+};
+
+struct ThreadStartBlock {
+  thrd_start_t func_;
+  void* arg_;
+
+#if defined(__linux__)
+  /* Set by the new thread, so that it never runs without its name. */
+  char name_[kMaxThreadNameLength + 1];
+#endif
+
+  atomic_int is_in_use_;
+};
+
+static struct ThreadStartBlock start_blocks[kStartBlocksCount];
+static atomic_size_t next_start_block_index = 0;
+
+static int IsPooledStartBlock(const struct ThreadStartBlock* start_block) {
+  return start_block >= &start_blocks[0]
+      && start_block < &start_blocks[kStartBlocksCount];
+}
+
+static struct ThreadStartBlock* AcquireStartBlock(void) {
+  size_t i;
+  size_t start_index;
+  struct ThreadStartBlock* start_block;
+  int is_in_use;
+
+  /* Start each search at a different block to spread out contention. */
+  start_index = (size_t) atomic_fetch_add_explicit(
+      &next_start_block_index,
+      1,
+      memory_order_relaxed
+  );
+
+  for (i = 0; i < kStartBlocksCount; i += 1) {
+    start_block = &start_blocks[(start_index + i) % kStartBlocksCount];
+
+    is_in_use = 0;
+    if (atomic_compare_exchange_strong_explicit(
+        &start_block->is_in_use_,
+        &is_in_use,
+        1,
+        memory_order_acquire,
+        memory_order_relaxed
+    )) {
+      return start_block;
+    }
+  }
+
+  return Mdc_malloc(sizeof(*start_block));
+}
+
+static void ReleaseStartBlock(struct ThreadStartBlock* start_block) {
+  if (!IsPooledStartBlock(start_block)) {
+    Mdc_free(start_block);
+    return;
+  }
+
+  atomic_store_explicit(&start_block->is_in_use_, 0, memory_order_release);
+}
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+#include <process.h>
+
+#include "../../../include/mdc/wchar_t/wide_decoding.h"
+#include "../std/threads/tss.h"
+
+#ifndef STACK_SIZE_PARAM_IS_A_RESERVATION
+#define STACK_SIZE_PARAM_IS_A_RESERVATION 0x00010000
+#endif
+
+typedef HRESULT (WINAPI *SetThreadDescriptionFunc)(HANDLE, const wchar_t*);
+typedef DWORD (WINAPI *GetThreadIdFunc)(HANDLE);
+
+static unsigned int __stdcall RunThreadFuncShim(void* start_block_ptr) {
+  struct ThreadStartBlock* start_block;
+  thrd_start_t func;
+  void* arg;
+  int result;
+
+  /* Copy field by field, since the in-use flag is atomic. */
+  start_block = start_block_ptr;
+  func = start_block->func_;
+  arg = start_block->arg_;
+  ReleaseStartBlock(start_block);
+
+  if (func == NULL) {
+    return 0;
+  }
+
+  result = func(arg);
+
+  Mdc_Tss_RunDestructors();
+
+  return result;
+}
+
+/*
+* SetThreadDescription is only available on Windows 10 1607 and
+* later, so it is looked up at runtime. Naming is skipped on older
+* versions.
+*/
+static void SetThreadName(HANDLE thread, const char* name) {
+  HMODULE kernel32;
+  SetThreadDescriptionFunc set_thread_description;
+  wchar_t* wide_name;
+  size_t wide_name_length;
+
+  kernel32 = GetModuleHandleA("kernel32.dll");
+  if (kernel32 == NULL) {
+    return;
+  }
+
+  set_thread_description = (SetThreadDescriptionFunc) GetProcAddress(
+      kernel32,
+      "SetThreadDescription"
+  );
+  if (set_thread_description == NULL) {
+    return;
+  }
+
+  wide_name_length = Mdc_Wide_DecodeUtf8Length(name);
+  wide_name = Mdc_malloc((wide_name_length + 1) * sizeof(wide_name[0]));
+  if (wide_name == NULL) {
+    return;
+  }
+
+  if (Mdc_Wide_DecodeUtf8(wide_name, name) != NULL) {
+    set_thread_description(thread, wide_name);
+  }
+
+  Mdc_free(wide_name);
+}
+
+int Mdc_Thrd_CreateEx(
+    thrd_t* thr,
+    thrd_start_t func,
+    void* arg,
+    const struct Mdc_ThrdAttributes* attributes
+) {
+  struct ThreadStartBlock* start_block;
+  unsigned int stack_size;
+  unsigned int init_flags;
+  DWORD_PTR set_affinity_result;
+  DWORD resume_thread_result;
+
+  start_block = AcquireStartBlock();
+  if (start_block == NULL) {
+    return thrd_nomem;
+  }
+
+  start_block->func_ = func;
+  start_block->arg_ = arg;
+
+  stack_size = 0;
+  init_flags = 0;
+
+  if (attributes != NULL) {
+    if (attributes->stack_size != 0) {
+      stack_size = (unsigned int) attributes->stack_size;
+      init_flags |= STACK_SIZE_PARAM_IS_A_RESERVATION;
+    }
+
+    /*
+    * Suspend the thread so that it never runs on the wrong CPU or
+    * without its name.
+    */
+    if (attributes->affinity_mask != 0 || attributes->name != NULL) {
+      init_flags |= CREATE_SUSPENDED;
+    }
+  }
+
+  *thr = (HANDLE) _beginthreadex(
+      NULL,
+      stack_size,
+      &RunThreadFuncShim,
+      start_block,
+      init_flags,
+      NULL
+  );
+
+  if (*thr == NULL) {
+    ReleaseStartBlock(start_block);
+
+    return thrd_error;
+  }
+
+  if (attributes == NULL) {
+    return thrd_success;
+  }
+
+  if (attributes->name != NULL) {
+    SetThreadName(*thr, attributes->name);
+  }
+
+  set_affinity_result = 1;
+  if (attributes->affinity_mask != 0) {
+    set_affinity_result = SetThreadAffinityMask(
+        *thr,
+        (DWORD_PTR) attributes->affinity_mask
+    );
+
+    /* Let the thread exit without running the function. */
+    if (set_affinity_result == 0) {
+      start_block->func_ = NULL;
+    }
+  }
+
+  if (init_flags & CREATE_SUSPENDED) {
+    resume_thread_result = ResumeThread(*thr);
+    if (resume_thread_result == (DWORD) -1) {
+      goto terminate_thread;
+    }
+  }
+
+  if (set_affinity_result == 0) {
+    goto join_thread;
+  }
+
+  return thrd_success;
+
+terminate_thread:
+  /* The thread never ran, so its start block is still claimed. */
+  TerminateThread(*thr, 0);
+  WaitForSingleObject(*thr, INFINITE);
+  CloseHandle(*thr);
+  ReleaseStartBlock(start_block);
+
+  return thrd_error;
+
+join_thread:
+  WaitForSingleObject(*thr, INFINITE);
+  CloseHandle(*thr);
+
+  return thrd_error;
+}
+
+/*
+* GetThreadId is only available on Windows Vista and later, so it is
+* looked up at runtime.
+*/
+unsigned long Mdc_Thrd_GetId(thrd_t thr) {
+  HMODULE kernel32;
+  GetThreadIdFunc get_thread_id;
+
+  kernel32 = GetModuleHandleA("kernel32.dll");
+  if (kernel32 == NULL) {
+    return 0;
+  }
+
+  get_thread_id = (GetThreadIdFunc) GetProcAddress(kernel32, "GetThreadId");
+  if (get_thread_id == NULL) {
+    return 0;
+  }
+
+  return get_thread_id(thr);
+}
+
+unsigned long Mdc_Thrd_GetCurrentId(void) {
+  return GetCurrentThreadId();
+}
+
+#elif defined(__GNUC__)
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+static void* RunThreadFuncShim(void* start_block_ptr) {
+  struct ThreadStartBlock* start_block;
+  thrd_start_t func;
+  void* arg;
+
+  /* Copy field by field, since the in-use flag is atomic. */
+  start_block = start_block_ptr;
+  func = start_block->func_;
+  arg = start_block->arg_;
+
+#if defined(__linux__)
+  if (start_block->name_[0] != '\0') {
+    pthread_setname_np(pthread_self(), start_block->name_);
+  }
+#endif
+
+  ReleaseStartBlock(start_block);
+
+  return (void*) (ptrdiff_t) func(arg);
+}
+
+static int InitPthreadAttributes(
+    pthread_attr_t* pthread_attributes,
+    const struct Mdc_ThrdAttributes* attributes
+) {
+  int result;
+  size_t stack_size;
+
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  size_t i;
+#endif
+
+  if (attributes->stack_size != 0) {
+    stack_size = attributes->stack_size;
+    if (stack_size < (size_t) PTHREAD_STACK_MIN) {
+      stack_size = (size_t) PTHREAD_STACK_MIN;
+    }
+
+    result = pthread_attr_setstacksize(pthread_attributes, stack_size);
+    if (result != 0) {
+      return result;
+    }
+  }
+
+#if defined(__linux__)
+  if (attributes->affinity_mask != 0) {
+    CPU_ZERO(&cpu_set);
+
+    for (i = 0; i < sizeof(attributes->affinity_mask) * CHAR_BIT; i += 1) {
+      if (attributes->affinity_mask & ((size_t) 1 << i)) {
+        CPU_SET(i, &cpu_set);
+      }
+    }
+
+    result = pthread_attr_setaffinity_np(
+        pthread_attributes,
+        sizeof(cpu_set),
+        &cpu_set
+    );
+    if (result != 0) {
+      return result;
+    }
+  }
+#endif
+
+  return 0;
+}
+
+int Mdc_Thrd_CreateEx(
+    thrd_t* thr,
+    thrd_start_t func,
+    void* arg,
+    const struct Mdc_ThrdAttributes* attributes
+) {
+  struct ThreadStartBlock* start_block;
+  pthread_attr_t pthread_attributes;
+  int result;
+
+  start_block = AcquireStartBlock();
+  if (start_block == NULL) {
+    return thrd_nomem;
+  }
+
+  start_block->func_ = func;
+  start_block->arg_ = arg;
+
+#if defined(__linux__)
+  start_block->name_[0] = '\0';
+  if (attributes != NULL && attributes->name != NULL) {
+    strncpy(start_block->name_, attributes->name, kMaxThreadNameLength);
+    start_block->name_[kMaxThreadNameLength] = '\0';
+  }
+#endif
+
+  if (attributes == NULL) {
+    result = pthread_create(thr, NULL, &RunThreadFuncShim, start_block);
+  } else {
+    result = pthread_attr_init(&pthread_attributes);
+    if (result != 0) {
+      goto release_start_block;
+    }
+
+    result = InitPthreadAttributes(&pthread_attributes, attributes);
+    if (result == 0) {
+      result = pthread_create(
+          thr,
+          &pthread_attributes,
+          &RunThreadFuncShim,
+          start_block
+      );
+    }
+
+    pthread_attr_destroy(&pthread_attributes);
+  }
+
+  if (result != 0) {
+    goto release_start_block;
+  }
+
+  return thrd_success;
+
+release_start_block:
+  ReleaseStartBlock(start_block);
+
+  return (result == ENOMEM) ? thrd_nomem : thrd_error;
+}
+
+unsigned long Mdc_Thrd_GetId(thrd_t thr) {
+  /* pthread_t is an integer or a pointer on supported platforms. */
+  return (unsigned long) thr;
+}
+
+unsigned long Mdc_Thrd_GetCurrentId(void) {
+  return Mdc_Thrd_GetId(pthread_self());
+}
+
+#endif
+
+#else
+
+int Mdc_Thrd_CreateEx(
+    thrd_t* thr,
+    thrd_start_t func,
+    void* arg,
+    const struct Mdc_ThrdAttributes* attributes
+) {
+  /* The standard library offers no control over thread attributes. */
+  (void) attributes;
+
+  return thrd_create(thr, func, arg);
+}
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+unsigned long Mdc_Thrd_GetId(thrd_t thr) {
+  /* The standard library offers no way to get the ID of a thrd_t. */
+  (void) thr;
+
+  return 0;
+}
+
+unsigned long Mdc_Thrd_GetCurrentId(void) {
+  return GetCurrentThreadId();
+}
+
+#elif defined(__GNUC__)
+
+unsigned long Mdc_Thrd_GetId(thrd_t thr) {
+  /* thrd_t is a pthread_t in glibc and musl. */
+  return (unsigned long) thr;
+}
+
+unsigned long Mdc_Thrd_GetCurrentId(void) {
+  return Mdc_Thrd_GetId(thrd_current());
+}
+
+#endif
+
+#endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__) */
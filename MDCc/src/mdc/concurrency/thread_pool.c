@@ -0,0 +1,554 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/thread_pool.h"
+
+#include "../../../include/mdc/concurrency/thrd.h"
+#include "../../../include/mdc/concurrency/thread_local.h"
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+#include "work_stealing_deque.h"
+
+enum {
+  kDequeCapacity = 1024,
+  kInitialInjectedCapacity = 64,
+  kStealAttemptsPerWorker = 2
+};
+
+struct Mdc_ThreadPoolWorker {
+  struct Mdc_WorkStealingDeque deque;
+
+  struct Mdc_ThreadPool* pool;
+  thrd_t thread;
+  unsigned long random_state;
+};
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+static MDC_THREAD_LOCAL struct Mdc_ThreadPoolWorker* current_worker = NULL;
+#endif
+
+/**
+ * Returns the calling thread's worker if it belongs to the pool, or
+ * NULL otherwise. Without thread-local storage, every thread is
+ * treated as external to the pool.
+ */
+static struct Mdc_ThreadPoolWorker* GetCurrentWorker(
+    const struct Mdc_ThreadPool* pool
+) {
+#if defined(MDC_HAS_THREAD_LOCAL)
+  if (current_worker != NULL && current_worker->pool == pool) {
+    return current_worker;
+  }
+#endif
+
+  return NULL;
+}
+
+/**
+ * Returns the next value of the worker's xorshift generator, used to
+ * pick steal victims.
+ */
+static unsigned long NextRandom(struct Mdc_ThreadPoolWorker* worker) {
+  unsigned long x;
+
+  x = worker->random_state;
+  x ^= (x << 13) & 0xFFFFFFFFUL;
+  x ^= x >> 17;
+  x ^= (x << 5) & 0xFFFFFFFFUL;
+  worker->random_state = x;
+
+  return x;
+}
+
+/*
+* The injection queue is a growable ring buffer that is guarded by
+* the pool mutex. Its count is also published atomically so that
+* workers can skip locking when it is empty.
+*/
+
+static int ReserveInjectedTasks(struct Mdc_ThreadPool* pool, size_t count) {
+  struct Mdc_ThreadPoolTask* new_tasks;
+  size_t new_capacity;
+  size_t injected_count;
+  size_t i;
+
+  injected_count = (size_t) pool->injected_count_;
+  if (injected_count + count <= pool->injected_capacity_) {
+    return thrd_success;
+  }
+
+  new_capacity = pool->injected_capacity_ * 2;
+  while (new_capacity < injected_count + count) {
+    new_capacity *= 2;
+  }
+
+  new_tasks = Mdc_malloc(new_capacity * sizeof(new_tasks[0]));
+  if (new_tasks == NULL) {
+    return thrd_nomem;
+  }
+
+  for (i = 0; i < injected_count; i += 1) {
+    new_tasks[i] = pool->injected_tasks_[
+        (pool->injected_front_ + i) % pool->injected_capacity_
+    ];
+  }
+
+  Mdc_free(pool->injected_tasks_);
+
+  pool->injected_tasks_ = new_tasks;
+  pool->injected_capacity_ = new_capacity;
+  pool->injected_front_ = 0;
+
+  return thrd_success;
+}
+
+static void PushInjectedTask(
+    struct Mdc_ThreadPool* pool,
+    const struct Mdc_ThreadPoolTask* task
+) {
+  size_t injected_count;
+
+  injected_count = (size_t) pool->injected_count_;
+
+  pool->injected_tasks_[
+      (pool->injected_front_ + injected_count) % pool->injected_capacity_
+  ] = *task;
+
+  atomic_store_explicit(
+      &pool->injected_count_,
+      (long) (injected_count + 1),
+      memory_order_release
+  );
+}
+
+static int PopInjectedTask(
+    struct Mdc_ThreadPool* pool,
+    struct Mdc_ThreadPoolTask* task
+) {
+  int is_pop_success;
+
+  if (atomic_load_explicit(&pool->injected_count_, memory_order_acquire)
+      == 0) {
+    return 0;
+  }
+
+  mtx_lock(&pool->mutex_);
+
+  is_pop_success = (pool->injected_count_ > 0);
+  if (is_pop_success) {
+    *task = pool->injected_tasks_[pool->injected_front_];
+
+    pool->injected_front_ =
+        (pool->injected_front_ + 1) % pool->injected_capacity_;
+    atomic_store_explicit(
+        &pool->injected_count_,
+        pool->injected_count_ - 1,
+        memory_order_release
+    );
+  }
+
+  mtx_unlock(&pool->mutex_);
+
+  return is_pop_success;
+}
+
+static int StealTask(
+    struct Mdc_ThreadPoolWorker* worker,
+    struct Mdc_ThreadPoolTask* task
+) {
+  struct Mdc_ThreadPool* pool;
+  struct Mdc_ThreadPoolWorker* victim;
+  size_t attempts_count;
+  size_t i;
+  int steal_result;
+
+  pool = worker->pool;
+  attempts_count = pool->workers_count_ * kStealAttemptsPerWorker;
+
+  for (i = 0; i < attempts_count; i += 1) {
+    victim = &pool->workers_[NextRandom(worker) % pool->workers_count_];
+    if (victim == worker) {
+      continue;
+    }
+
+    steal_result = Mdc_WorkStealingDeque_Steal(&victim->deque, task);
+    if (steal_result == Mdc_WorkStealingDeque_kStealSuccess) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static int FindTask(
+    struct Mdc_ThreadPoolWorker* worker,
+    struct Mdc_ThreadPoolTask* task
+) {
+  if (Mdc_WorkStealingDeque_Pop(&worker->deque, task)) {
+    return 1;
+  }
+
+  if (PopInjectedTask(worker->pool, task)) {
+    return 1;
+  }
+
+  return StealTask(worker, task);
+}
+
+/**
+ * Removes finished or abandoned tasks from the pending count, waking
+ * any threads waiting for the pool to become idle.
+ */
+static void ReleasePendingTasks(struct Mdc_ThreadPool* pool, long count) {
+  long pending_count;
+
+  pending_count = (long) atomic_fetch_add_explicit(
+      &pool->pending_count_,
+      -count,
+      memory_order_seq_cst
+  );
+  if (pending_count != count) {
+    return;
+  }
+
+  mtx_lock(&pool->mutex_);
+  cnd_broadcast(&pool->idle_cond_);
+  mtx_unlock(&pool->mutex_);
+}
+
+static void NotifyWorkers(struct Mdc_ThreadPool* pool, size_t count) {
+  /*
+  * Pairs with the fence in WaitForWork: either the sleeping worker
+  * sees the new epoch, or this thread sees the sleeper.
+  */
+  atomic_fetch_add_explicit(&pool->work_epoch_, 1, memory_order_seq_cst);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (atomic_load_explicit(&pool->sleepers_count_, memory_order_relaxed) == 0) {
+    return;
+  }
+
+  mtx_lock(&pool->mutex_);
+
+  if (count == 1) {
+    cnd_signal(&pool->work_cond_);
+  } else {
+    cnd_broadcast(&pool->work_cond_);
+  }
+
+  mtx_unlock(&pool->mutex_);
+}
+
+static void WaitForWork(struct Mdc_ThreadPool* pool, long work_epoch) {
+  mtx_lock(&pool->mutex_);
+
+  atomic_fetch_add_explicit(&pool->sleepers_count_, 1, memory_order_seq_cst);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (atomic_load_explicit(&pool->work_epoch_, memory_order_relaxed)
+          == work_epoch
+      && !atomic_load_explicit(&pool->is_stopping_, memory_order_relaxed)) {
+    cnd_wait(&pool->work_cond_, &pool->mutex_);
+  }
+
+  atomic_fetch_add_explicit(&pool->sleepers_count_, -1, memory_order_seq_cst);
+
+  mtx_unlock(&pool->mutex_);
+}
+
+static int RunWorker(void* arg) {
+  struct Mdc_ThreadPoolWorker* worker;
+  struct Mdc_ThreadPool* pool;
+  struct Mdc_ThreadPoolTask task;
+  long work_epoch;
+
+  worker = arg;
+  pool = worker->pool;
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+  current_worker = worker;
+#endif
+
+  for (;;) {
+    work_epoch = (long) atomic_load_explicit(
+        &pool->work_epoch_,
+        memory_order_acquire
+    );
+
+    if (FindTask(worker, &task)) {
+      task.func(task.arg);
+      ReleasePendingTasks(pool, 1);
+
+      continue;
+    }
+
+    if (atomic_load_explicit(&pool->is_stopping_, memory_order_acquire)) {
+      break;
+    }
+
+    WaitForWork(pool, work_epoch);
+  }
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+  current_worker = NULL;
+#endif
+
+  return 0;
+}
+
+static void StopWorkers(struct Mdc_ThreadPool* pool, size_t count) {
+  size_t i;
+
+  mtx_lock(&pool->mutex_);
+
+  atomic_store_explicit(&pool->is_stopping_, 1, memory_order_release);
+  atomic_fetch_add_explicit(&pool->work_epoch_, 1, memory_order_seq_cst);
+  cnd_broadcast(&pool->work_cond_);
+
+  mtx_unlock(&pool->mutex_);
+
+  for (i = 0; i < count; i += 1) {
+    thrd_join(pool->workers_[i].thread, NULL);
+  }
+}
+
+int Mdc_ThreadPool_Init(
+    struct Mdc_ThreadPool* pool,
+    size_t workers_count
+) {
+  struct Mdc_ThrdAttributes attributes;
+  struct Mdc_ThreadPoolWorker* worker;
+  size_t i;
+  size_t deques_count;
+  size_t threads_count;
+  int result;
+
+  if (workers_count == 0) {
+    workers_count = Mdc_Thrd_GetHardwareConcurrency();
+  }
+
+  pool->workers_count_ = workers_count;
+  pool->injected_capacity_ = kInitialInjectedCapacity;
+  pool->injected_front_ = 0;
+  pool->injected_count_ = 0;
+  pool->pending_count_ = 0;
+  pool->work_epoch_ = 0;
+  pool->sleepers_count_ = 0;
+  pool->is_stopping_ = 0;
+
+  result = mtx_init(&pool->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = cnd_init(&pool->work_cond_);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  result = cnd_init(&pool->idle_cond_);
+  if (result != thrd_success) {
+    goto destroy_work_cond;
+  }
+
+  pool->injected_tasks_ = Mdc_malloc(
+      pool->injected_capacity_ * sizeof(pool->injected_tasks_[0])
+  );
+  if (pool->injected_tasks_ == NULL) {
+    result = thrd_nomem;
+    goto destroy_idle_cond;
+  }
+
+  pool->workers_ = Mdc_malloc(workers_count * sizeof(pool->workers_[0]));
+  if (pool->workers_ == NULL) {
+    result = thrd_nomem;
+    goto free_injected_tasks;
+  }
+
+  for (deques_count = 0; deques_count < workers_count; deques_count += 1) {
+    worker = &pool->workers_[deques_count];
+
+    result = Mdc_WorkStealingDeque_Init(&worker->deque, kDequeCapacity);
+    if (result != thrd_success) {
+      goto deinit_deques;
+    }
+
+    worker->pool = pool;
+    worker->random_state = (unsigned long) deques_count + 1;
+  }
+
+  Mdc_ThrdAttributes_Init(&attributes);
+  attributes.name = "mdc-pool-worker";
+
+  for (threads_count = 0; threads_count < workers_count; threads_count += 1) {
+    worker = &pool->workers_[threads_count];
+
+    result = Mdc_Thrd_CreateEx(
+        &worker->thread,
+        &RunWorker,
+        worker,
+        &attributes
+    );
+    if (result != thrd_success) {
+      goto stop_workers;
+    }
+  }
+
+  return thrd_success;
+
+stop_workers:
+  StopWorkers(pool, threads_count);
+
+deinit_deques:
+  for (i = 0; i < deques_count; i += 1) {
+    Mdc_WorkStealingDeque_Deinit(&pool->workers_[i].deque);
+  }
+
+  Mdc_free(pool->workers_);
+
+free_injected_tasks:
+  Mdc_free(pool->injected_tasks_);
+
+destroy_idle_cond:
+  cnd_destroy(&pool->idle_cond_);
+
+destroy_work_cond:
+  cnd_destroy(&pool->work_cond_);
+
+destroy_mutex:
+  mtx_destroy(&pool->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_ThreadPool_Deinit(struct Mdc_ThreadPool* pool) {
+  size_t i;
+
+  Mdc_ThreadPool_WaitIdle(pool);
+  StopWorkers(pool, pool->workers_count_);
+
+  for (i = 0; i < pool->workers_count_; i += 1) {
+    Mdc_WorkStealingDeque_Deinit(&pool->workers_[i].deque);
+  }
+
+  Mdc_free(pool->workers_);
+  Mdc_free(pool->injected_tasks_);
+
+  cnd_destroy(&pool->idle_cond_);
+  cnd_destroy(&pool->work_cond_);
+  mtx_destroy(&pool->mutex_);
+}
+
+int Mdc_ThreadPool_Submit(
+    struct Mdc_ThreadPool* pool,
+    void (*func)(void* arg),
+    void* arg
+) {
+  struct Mdc_ThreadPoolTask task;
+
+  task.func = func;
+  task.arg = arg;
+
+  return Mdc_ThreadPool_SubmitBatch(pool, &task, 1);
+}
+
+int Mdc_ThreadPool_SubmitBatch(
+    struct Mdc_ThreadPool* pool,
+    const struct Mdc_ThreadPoolTask* tasks,
+    size_t count
+) {
+  struct Mdc_ThreadPoolWorker* worker;
+  size_t local_count;
+  size_t i;
+  int reserve_result;
+
+  if (count == 0) {
+    return thrd_success;
+  }
+
+  /* Count the tasks as pending before any worker can finish them. */
+  atomic_fetch_add_explicit(
+      &pool->pending_count_,
+      (long) count,
+      memory_order_seq_cst
+  );
+
+  /*
+  * A worker keeps as many tasks as fit in its own deque. The rest go
+  * to the injection queue, which is reserved first so that a failed
+  * allocation leaves nothing submitted.
+  */
+  worker = GetCurrentWorker(pool);
+  if (worker == NULL) {
+    local_count = 0;
+  } else {
+    local_count = Mdc_WorkStealingDeque_GetFreeCount(&worker->deque);
+    if (local_count > count) {
+      local_count = count;
+    }
+  }
+
+  if (local_count < count) {
+    mtx_lock(&pool->mutex_);
+
+    reserve_result = ReserveInjectedTasks(pool, count - local_count);
+    if (reserve_result != thrd_success) {
+      mtx_unlock(&pool->mutex_);
+      ReleasePendingTasks(pool, (long) count);
+
+      return reserve_result;
+    }
+
+    for (i = local_count; i < count; i += 1) {
+      PushInjectedTask(pool, &tasks[i]);
+    }
+
+    mtx_unlock(&pool->mutex_);
+  }
+
+  for (i = 0; i < local_count; i += 1) {
+    Mdc_WorkStealingDeque_Push(&worker->deque, &tasks[i]);
+  }
+
+  NotifyWorkers(pool, count);
+
+  return thrd_success;
+}
+
+void Mdc_ThreadPool_WaitIdle(struct Mdc_ThreadPool* pool) {
+  mtx_lock(&pool->mutex_);
+
+  while (atomic_load_explicit(&pool->pending_count_, memory_order_acquire)
+      != 0) {
+    cnd_wait(&pool->idle_cond_, &pool->mutex_);
+  }
+
+  mtx_unlock(&pool->mutex_);
+}
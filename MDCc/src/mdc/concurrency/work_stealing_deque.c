@@ -0,0 +1,180 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "work_stealing_deque.h"
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdatomic.h"
+
+/*
+* Indices grow without bound and wrap around, so they are compared
+* through their unsigned difference.
+*/
+static long AddToIndex(long index, long value) {
+  return (long) ((unsigned long) index + (unsigned long) value);
+}
+
+static long GetDistance(long top, long bottom) {
+  return (long) ((unsigned long) bottom - (unsigned long) top);
+}
+
+int Mdc_WorkStealingDeque_Init(
+    struct Mdc_WorkStealingDeque* deque,
+    size_t capacity
+) {
+  deque->tasks_ = Mdc_malloc(capacity * sizeof(deque->tasks_[0]));
+  if (deque->tasks_ == NULL) {
+    return thrd_nomem;
+  }
+
+  deque->top_ = 0;
+  deque->bottom_ = 0;
+  deque->mask_ = (unsigned long) capacity - 1;
+
+  return thrd_success;
+}
+
+void Mdc_WorkStealingDeque_Deinit(struct Mdc_WorkStealingDeque* deque) {
+  Mdc_free(deque->tasks_);
+}
+
+size_t Mdc_WorkStealingDeque_GetFreeCount(
+    const struct Mdc_WorkStealingDeque* deque
+) {
+  long top;
+  long bottom;
+
+  bottom = (long) atomic_load_explicit(&deque->bottom_, memory_order_relaxed);
+  top = (long) atomic_load_explicit(&deque->top_, memory_order_acquire);
+
+  return (deque->mask_ + 1) - (size_t) GetDistance(top, bottom);
+}
+
+int Mdc_WorkStealingDeque_Push(
+    struct Mdc_WorkStealingDeque* deque,
+    const struct Mdc_ThreadPoolTask* task
+) {
+  long top;
+  long bottom;
+
+  bottom = (long) atomic_load_explicit(&deque->bottom_, memory_order_relaxed);
+  top = (long) atomic_load_explicit(&deque->top_, memory_order_acquire);
+
+  if ((unsigned long) GetDistance(top, bottom) > deque->mask_) {
+    return 0;
+  }
+
+  deque->tasks_[(unsigned long) bottom & deque->mask_] = *task;
+  atomic_store_explicit(
+      &deque->bottom_,
+      AddToIndex(bottom, 1),
+      memory_order_release
+  );
+
+  return 1;
+}
+
+int Mdc_WorkStealingDeque_Pop(
+    struct Mdc_WorkStealingDeque* deque,
+    struct Mdc_ThreadPoolTask* task
+) {
+  long top;
+  long bottom;
+  long new_bottom;
+  long count;
+  int is_take_success;
+
+  /*
+  * Claim the bottom task before looking at the top, so that a thief
+  * either sees the claim or the owner sees the thief's increment.
+  */
+  bottom = (long) atomic_load_explicit(&deque->bottom_, memory_order_relaxed);
+  new_bottom = AddToIndex(bottom, -1);
+  atomic_store_explicit(&deque->bottom_, new_bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  top = (long) atomic_load_explicit(&deque->top_, memory_order_relaxed);
+
+  count = GetDistance(top, bottom);
+  if (count <= 0) {
+    atomic_store_explicit(&deque->bottom_, bottom, memory_order_relaxed);
+    return 0;
+  }
+
+  *task = deque->tasks_[(unsigned long) new_bottom & deque->mask_];
+  if (count > 1) {
+    return 1;
+  }
+
+  /* The last task is contested by thieves through the top index. */
+  is_take_success = atomic_compare_exchange_strong_explicit(
+      &deque->top_,
+      &top,
+      AddToIndex(top, 1),
+      memory_order_seq_cst,
+      memory_order_relaxed
+  );
+  atomic_store_explicit(&deque->bottom_, bottom, memory_order_relaxed);
+
+  return is_take_success;
+}
+
+int Mdc_WorkStealingDeque_Steal(
+    struct Mdc_WorkStealingDeque* deque,
+    struct Mdc_ThreadPoolTask* task
+) {
+  long top;
+  long bottom;
+  int is_take_success;
+
+  top = (long) atomic_load_explicit(&deque->top_, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  bottom = (long) atomic_load_explicit(&deque->bottom_, memory_order_acquire);
+
+  if (GetDistance(top, bottom) <= 0) {
+    return Mdc_WorkStealingDeque_kStealEmpty;
+  }
+
+  /*
+  * The slot cannot be overwritten before the top index moves past it,
+  * so the copy is valid if the exchange succeeds.
+  */
+  *task = deque->tasks_[(unsigned long) top & deque->mask_];
+
+  is_take_success = atomic_compare_exchange_strong_explicit(
+      &deque->top_,
+      &top,
+      AddToIndex(top, 1),
+      memory_order_seq_cst,
+      memory_order_relaxed
+  );
+
+  return is_take_success
+      ? Mdc_WorkStealingDeque_kStealSuccess
+      : Mdc_WorkStealingDeque_kStealAbort;
+}
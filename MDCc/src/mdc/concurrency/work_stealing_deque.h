@@ -0,0 +1,124 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_CONCURRENCY_WORK_STEALING_DEQUE_H_
+#define MDC_C_CONCURRENCY_WORK_STEALING_DEQUE_H_
+
+#include <stddef.h>
+
+#include "../../../include/mdc/concurrency/thread_pool.h"
+
+enum {
+  Mdc_WorkStealingDeque_kCacheLineSize = 64
+};
+
+enum {
+  Mdc_WorkStealingDeque_kStealEmpty,
+  Mdc_WorkStealingDeque_kStealSuccess,
+  Mdc_WorkStealingDeque_kStealAbort
+};
+
+/**
+ * A fixed-capacity Chase-Lev deque of tasks. Only the owning thread
+ * may push and pop at the bottom, while any thread may steal from the
+ * top. The indices are kept on separate cache lines so that thieves
+ * do not invalidate the owner's line on every push and pop.
+ */
+struct Mdc_WorkStealingDeque {
+  long top_;
+  char top_padding_[Mdc_WorkStealingDeque_kCacheLineSize - sizeof(long)];
+
+  long bottom_;
+  char bottom_padding_[
+      Mdc_WorkStealingDeque_kCacheLineSize - sizeof(long)
+  ];
+
+  struct Mdc_ThreadPoolTask* tasks_;
+  unsigned long mask_;
+};
+
+/**
+ * Initializes the deque with the specified capacity.
+ *
+ * @param deque the deque to initialize
+ * @param capacity the maximum number of tasks, as a power of two
+ * @return thrd_success on success, or thrd_nomem if out of memory
+ */
+int Mdc_WorkStealingDeque_Init(
+    struct Mdc_WorkStealingDeque* deque,
+    size_t capacity
+);
+
+void Mdc_WorkStealingDeque_Deinit(struct Mdc_WorkStealingDeque* deque);
+
+/**
+ * Returns the number of tasks that can currently be pushed. May only
+ * be called by the owning thread. The result only grows until the
+ * owner pushes again.
+ */
+size_t Mdc_WorkStealingDeque_GetFreeCount(
+    const struct Mdc_WorkStealingDeque* deque
+);
+
+/**
+ * Pushes a task onto the bottom of the deque. May only be called by
+ * the owning thread.
+ *
+ * @return nonzero if pushed, or zero if the deque is full
+ */
+int Mdc_WorkStealingDeque_Push(
+    struct Mdc_WorkStealingDeque* deque,
+    const struct Mdc_ThreadPoolTask* task
+);
+
+/**
+ * Pops the most recently pushed task from the bottom of the deque.
+ * May only be called by the owning thread.
+ *
+ * @return nonzero if a task was popped, or zero if the deque is empty
+ */
+int Mdc_WorkStealingDeque_Pop(
+    struct Mdc_WorkStealingDeque* deque,
+    struct Mdc_ThreadPoolTask* task
+);
+
+/**
+ * Steals the oldest task from the top of the deque.
+ *
+ * @return Mdc_WorkStealingDeque_kStealSuccess if a task was stolen,
+ *    Mdc_WorkStealingDeque_kStealEmpty if the deque is empty, or
+ *    Mdc_WorkStealingDeque_kStealAbort if another thread took the
+ *    task first
+ */
+int Mdc_WorkStealingDeque_Steal(
+    struct Mdc_WorkStealingDeque* deque,
+    struct Mdc_ThreadPoolTask* task
+);
+
+#endif /* MDC_C_CONCURRENCY_WORK_STEALING_DEQUE_H_ */
@@ -0,0 +1,65 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_MALLOC_ALLOCATOR_H_
+#define MDC_C_MALLOC_ALLOCATOR_H_
+
+#include <stddef.h>
+
+#include "../../../include/mdc/malloc/malloc.h"
+
+/*
+* Direct access to an allocator vtable, for MDC allocators that manage
+* their own blocks and accounting. Such an allocator gets the vtable
+* from Mdc_GetAllocator and keeps it, so that each block is freed
+* through the allocator that allocated it.
+*/
+
+/**
+ * Allocates an uncounted block with the specified alignment, which
+ * must be a power of two.
+ *
+ * @return the allocated block, or NULL if out of memory
+ */
+void* Mdc_Allocator_AllocateAligned(
+    const struct Mdc_AllocatorVTable* allocator,
+    size_t size,
+    size_t alignment
+);
+
+/**
+ * Frees a block allocated from the same allocator with
+ * Mdc_Allocator_AllocateAligned.
+ */
+void Mdc_Allocator_FreeAligned(
+    const struct Mdc_AllocatorVTable* allocator,
+    void* ptr
+);
+
+#endif /* MDC_C_MALLOC_ALLOCATOR_H_ */
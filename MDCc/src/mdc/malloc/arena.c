@@ -0,0 +1,262 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/malloc/arena.h"
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "../../../include/mdc/std/stdint.h"
+
+/* A union of the types with the strictest alignment, like malloc. */
+union MaxAlign {
+  long double alignment_long_double;
+  double alignment_double;
+  long alignment_long;
+  void* alignment_pointer;
+  void (*alignment_function)(void);
+};
+
+struct MaxAlignProbe {
+  char c;
+  union MaxAlign max_align;
+};
+
+struct Mdc_ArenaBlock {
+  struct Mdc_ArenaBlock* next;
+  size_t capacity;
+
+  /* The usable memory starts here and runs for capacity bytes. */
+  union MaxAlign data[1];
+};
+
+enum {
+  kMaxAlignment = offsetof(struct MaxAlignProbe, max_align),
+  kBlockHeaderSize = offsetof(struct Mdc_ArenaBlock, data)
+};
+
+static unsigned char* GetBlockData(struct Mdc_ArenaBlock* block) {
+  return (unsigned char*) block->data;
+}
+
+static struct Mdc_ArenaBlock* CreateBlock(size_t capacity) {
+  struct Mdc_ArenaBlock* block;
+
+  if (capacity > (size_t) -1 - kBlockHeaderSize) {
+    return NULL;
+  }
+
+  block = Mdc_malloc(kBlockHeaderSize + capacity);
+  if (block == NULL) {
+    return NULL;
+  }
+
+  block->next = NULL;
+  block->capacity = capacity;
+
+  return block;
+}
+
+static void EnterBlock(
+    struct Mdc_Arena* arena,
+    struct Mdc_ArenaBlock* block
+) {
+  arena->current_block_ = block;
+  arena->position_ = GetBlockData(block);
+  arena->end_ = arena->position_ + block->capacity;
+}
+
+/*
+* Bumps the position if the allocation fits in the rest of the current
+* block, or returns NULL otherwise.
+*/
+static void* AllocateInCurrentBlock(
+    struct Mdc_Arena* arena,
+    size_t size,
+    size_t alignment
+) {
+  size_t padding;
+  size_t available;
+  unsigned char* result;
+
+  if (arena->position_ == NULL) {
+    return NULL;
+  }
+
+  padding = (alignment - ((uintptr_t) arena->position_ & (alignment - 1)))
+      & (alignment - 1);
+  available = (size_t) (arena->end_ - arena->position_);
+
+  if (padding > available || size > available - padding) {
+    return NULL;
+  }
+
+  result = arena->position_ + padding;
+  arena->position_ = result + size;
+
+  return result;
+}
+
+/*
+* Moves to the block after the current one, which is reused if it is
+* large enough. Otherwise, a new block is inserted before it.
+*/
+static int AdvanceBlock(
+    struct Mdc_Arena* arena,
+    size_t size,
+    size_t alignment
+) {
+  struct Mdc_ArenaBlock* next_block;
+  struct Mdc_ArenaBlock* new_block;
+  size_t required_capacity;
+
+  /* Block data is already aligned to kMaxAlignment. */
+  required_capacity = size;
+  if (alignment > kMaxAlignment) {
+    if (required_capacity > (size_t) -1 - (alignment - 1)) {
+      return 0;
+    }
+
+    required_capacity += alignment - 1;
+  }
+
+  next_block = (arena->current_block_ == NULL)
+      ? arena->first_block_
+      : arena->current_block_->next;
+
+  if (next_block != NULL && next_block->capacity >= required_capacity) {
+    EnterBlock(arena, next_block);
+    return 1;
+  }
+
+  new_block = CreateBlock(
+      (required_capacity > arena->block_size_)
+          ? required_capacity
+          : arena->block_size_
+  );
+  if (new_block == NULL) {
+    return 0;
+  }
+
+  new_block->next = next_block;
+  if (arena->current_block_ == NULL) {
+    arena->first_block_ = new_block;
+  } else {
+    arena->current_block_->next = new_block;
+  }
+
+  EnterBlock(arena, new_block);
+
+  return 1;
+}
+
+void Mdc_Arena_Init(struct Mdc_Arena* arena, size_t block_size) {
+  arena->first_block_ = NULL;
+  arena->current_block_ = NULL;
+  arena->position_ = NULL;
+  arena->end_ = NULL;
+  arena->block_size_ = (block_size == 0)
+      ? Mdc_Arena_kDefaultBlockSize
+      : block_size;
+}
+
+void Mdc_Arena_Deinit(struct Mdc_Arena* arena) {
+  struct Mdc_ArenaBlock* block;
+  struct Mdc_ArenaBlock* next_block;
+
+  for (block = arena->first_block_; block != NULL; block = next_block) {
+    next_block = block->next;
+    Mdc_free(block);
+  }
+
+  arena->first_block_ = NULL;
+  arena->current_block_ = NULL;
+  arena->position_ = NULL;
+  arena->end_ = NULL;
+}
+
+void* Mdc_Arena_Allocate(struct Mdc_Arena* arena, size_t size) {
+  return Mdc_Arena_AllocateAligned(arena, size, kMaxAlignment);
+}
+
+void* Mdc_Arena_AllocateAligned(
+    struct Mdc_Arena* arena,
+    size_t size,
+    size_t alignment
+) {
+  void* result;
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    return NULL;
+  }
+
+  result = AllocateInCurrentBlock(arena, size, alignment);
+  if (result != NULL) {
+    return result;
+  }
+
+  /*
+  * Blocks past the current one are either reused or large enough, so
+  * one advance always makes room.
+  */
+  if (!AdvanceBlock(arena, size, alignment)) {
+    return NULL;
+  }
+
+  return AllocateInCurrentBlock(arena, size, alignment);
+}
+
+void Mdc_Arena_GetMark(
+    const struct Mdc_Arena* arena,
+    struct Mdc_ArenaMark* mark
+) {
+  mark->block_ = arena->current_block_;
+  mark->position_ = arena->position_;
+}
+
+void Mdc_Arena_Rewind(
+    struct Mdc_Arena* arena,
+    const struct Mdc_ArenaMark* mark
+) {
+  /* The arena had no block when the mark was taken. */
+  if (mark->block_ == NULL) {
+    Mdc_Arena_Reset(arena);
+    return;
+  }
+
+  arena->current_block_ = mark->block_;
+  arena->position_ = mark->position_;
+  arena->end_ = GetBlockData(mark->block_) + mark->block_->capacity;
+}
+
+void Mdc_Arena_Reset(struct Mdc_Arena* arena) {
+  if (arena->first_block_ == NULL) {
+    return;
+  }
+
+  EnterBlock(arena, arena->first_block_);
+}
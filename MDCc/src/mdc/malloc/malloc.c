@@ -29,68 +29,554 @@
 
 #include "../../../include/mdc/malloc/malloc.h"
 
-#if !defined(NDEBUG)
-
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "../../../include/mdc/std/stdatomic.h"
+#include "../concurrency/sharded_counter.h"
+#include "allocator.h"
+#include "malloc_accounting.h"
+
+enum {
+  kShardsCount = Mdc_ShardedCounter_kShardsCount,
+  kPeakGranularityBytes = Mdc_Malloc_kPeakGranularityBytes
+};
+
+/*
+* Precedes every block. The union keeps the block that follows it
+* aligned for any type, as malloc does. An aligned block is preceded
+* by padding, then the address of the underlying block, then the
+* header. The block is always freed through the allocator that
+* allocated it, even if another one has been set since.
+*/
+union BlockHeader {
+  struct {
+    const struct Mdc_AllocatorVTable* allocator;
+    size_t size;
+    int is_counted;
+    int is_aligned;
+  } info;
+
+  long double alignment_long_double;
+  void* alignment_pointer;
+};
+
+struct BlockHeaderAlignmentProbe {
+  char c;
+  union BlockHeader header;
+};
+
+struct ShardCounters {
+  struct Mdc_ShardedCounter malloc_count;
+  struct Mdc_ShardedCounter free_count;
+  struct Mdc_ShardedCounter allocated_bytes;
+  struct Mdc_ShardedCounter freed_bytes;
+
+  /* The change in bytes in use not yet added to published_bytes. */
+  ptrdiff_t unpublished_bytes;
+};
+
+struct Shard {
+  struct ShardCounters counters;
+
+  unsigned char padding[
+      MDC_C_CONCURRENCY_SHARDED_COUNTER_PADDING_SIZE_(
+          sizeof(struct ShardCounters)
+      )
+  ];
+};
+
+static void* DefaultMalloc(void* context, size_t size) {
+  (void) context;
+
+  return malloc(size);
+}
+
+static void* DefaultCalloc(void* context, size_t num, size_t size) {
+  (void) context;
+
+  return calloc(num, size);
+}
+
+static void* DefaultRealloc(void* context, void* ptr, size_t new_size) {
+  (void) context;
+
+  return realloc(ptr, new_size);
+}
+
+static void DefaultFree(void* context, void* ptr) {
+  (void) context;
+
+  free(ptr);
+}
+
+/*
+* The C library is only guaranteed to have aligned allocation from
+* C11 onwards, so the default allocator leaves it to emulation.
+*/
+static const struct Mdc_AllocatorVTable default_allocator = {
+  &DefaultMalloc,
+  &DefaultCalloc,
+  &DefaultRealloc,
+  &DefaultFree,
+  NULL,
+  NULL,
+  NULL
+};
+
+/* Holds the address of the vtable, or 0 for the default allocator. */
+static atomic_uintptr_t current_allocator;
+
+static struct Shard shards[kShardsCount];
+
+static atomic_int is_accounting_enabled =
+#if defined(NDEBUG)
+    0;
+#else
+    1;
+#endif
+
+/* The bytes in use, as of the last batch published by each shard. */
+static atomic_ptrdiff_t published_bytes;
+static atomic_size_t peak_bytes;
+
+static void UpdatePeak(size_t bytes) {
+  size_t peak;
+
+  peak = (size_t) atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+
+  /* On failure, the peak is updated to the current one. */
+  while (bytes > peak) {
+    if (atomic_compare_exchange_weak_explicit(
+        &peak_bytes,
+        &peak,
+        bytes,
+        memory_order_relaxed,
+        memory_order_relaxed
+    )) {
+      break;
+    }
+  }
+}
+
+/*
+* Bytes in use are batched per shard, so that the shared total is only
+* touched once the shard's change exceeds the peak granularity.
+*/
+static void AddBytesInUse(struct ShardCounters* counters, ptrdiff_t bytes) {
+  ptrdiff_t unpublished;
+  ptrdiff_t published;
+
+  unpublished = (ptrdiff_t) atomic_fetch_add_explicit(
+      &counters->unpublished_bytes,
+      bytes,
+      memory_order_relaxed
+  ) + bytes;
+
+  if (unpublished < kPeakGranularityBytes
+      && unpublished > -kPeakGranularityBytes) {
+    return;
+  }
+
+  unpublished = (ptrdiff_t) atomic_exchange_explicit(
+      &counters->unpublished_bytes,
+      0,
+      memory_order_relaxed
+  );
+
+  published = (ptrdiff_t) atomic_fetch_add_explicit(
+      &published_bytes,
+      unpublished,
+      memory_order_relaxed
+  ) + unpublished;
+
+  if (published > 0) {
+    UpdatePeak((size_t) published);
+  }
+}
+
+void Mdc_MallocAccounting_RecordMalloc(size_t size) {
+  struct ShardCounters* counters;
+
+  counters = &shards[Mdc_ShardedCounter_GetShardIndex()].counters;
+
+  Mdc_ShardedCounter_Add(&counters->malloc_count, 1);
+  Mdc_ShardedCounter_Add(&counters->allocated_bytes, size);
+  AddBytesInUse(counters, (ptrdiff_t) size);
+}
+
+void Mdc_MallocAccounting_RecordFree(size_t size) {
+  struct ShardCounters* counters;
+
+  counters = &shards[Mdc_ShardedCounter_GetShardIndex()].counters;
+
+  Mdc_ShardedCounter_Add(&counters->free_count, 1);
+  Mdc_ShardedCounter_Add(&counters->freed_bytes, size);
+  AddBytesInUse(counters, -(ptrdiff_t) size);
+}
+
+static void RecordMalloc(
+    union BlockHeader* header,
+    const struct Mdc_AllocatorVTable* allocator,
+    size_t size,
+    int is_aligned
+) {
+  header->info.allocator = allocator;
+  header->info.size = size;
+  header->info.is_aligned = is_aligned;
+  header->info.is_counted = (int) atomic_load_explicit(
+      &is_accounting_enabled,
+      memory_order_relaxed
+  );
+
+  if (header->info.is_counted) {
+    Mdc_MallocAccounting_RecordMalloc(size);
+  }
+}
+
+static void RecordFree(size_t size, int is_counted) {
+  if (is_counted) {
+    Mdc_MallocAccounting_RecordFree(size);
+  }
+}
+
+static const struct Mdc_AllocatorVTable* GetAllocator(void) {
+  uintptr_t allocator;
+
+  allocator = (uintptr_t) atomic_load_explicit(
+      &current_allocator,
+      memory_order_acquire
+  );
+
+  return (allocator == 0)
+      ? &default_allocator
+      : (const struct Mdc_AllocatorVTable*) allocator;
+}
+
+/*
+* Over-allocates with malloc_func, and stores the address of the
+* underlying block just before the aligned block.
+*/
+static void* EmulateAlignedAlloc(
+    const struct Mdc_AllocatorVTable* allocator,
+    size_t size,
+    size_t alignment
+) {
+  void* block;
+  uintptr_t aligned_block;
+
+  if (alignment < sizeof(void*)) {
+    alignment = sizeof(void*);
+  }
+
+  if (size > (size_t) -1 - (alignment - 1) - sizeof(void*)) {
+    return NULL;
+  }
+
+  block = allocator->malloc_func(
+      allocator->context,
+      size + (alignment - 1) + sizeof(void*)
+  );
+  if (block == NULL) {
+    return NULL;
+  }
+
+  aligned_block = ((uintptr_t) block + sizeof(void*) + (alignment - 1))
+      & ~(uintptr_t) (alignment - 1);
+  ((void**) aligned_block)[-1] = block;
+
+  return (void*) aligned_block;
+}
+
+static void EmulateAlignedFree(
+    const struct Mdc_AllocatorVTable* allocator,
+    void* ptr
+) {
+  allocator->free_func(allocator->context, ((void**) ptr)[-1]);
+}
+
+void* Mdc_Allocator_AllocateAligned(
+    const struct Mdc_AllocatorVTable* allocator,
+    size_t size,
+    size_t alignment
+) {
+  if (allocator->aligned_alloc_func == NULL) {
+    return EmulateAlignedAlloc(allocator, size, alignment);
+  }
+
+  return allocator->aligned_alloc_func(allocator->context, size, alignment);
+}
+
+void Mdc_Allocator_FreeAligned(
+    const struct Mdc_AllocatorVTable* allocator,
+    void* ptr
+) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (allocator->aligned_free_func == NULL) {
+    EmulateAlignedFree(allocator, ptr);
+    return;
+  }
 
-static int malloc_count = 0;
-static int free_count = 0;
+  allocator->aligned_free_func(allocator->context, ptr);
+}
+
+static union BlockHeader* GetHeader(void* ptr) {
+  return (union BlockHeader*) ptr - 1;
+}
+
+static int IsSizeTooLarge(size_t size) {
+  return size > (size_t) -1 - sizeof(union BlockHeader);
+}
 
 void* Mdc_malloc(size_t size) {
-  void* result;
+  const struct Mdc_AllocatorVTable* allocator;
+  union BlockHeader* header;
 
-  result = malloc(size);
+  if (IsSizeTooLarge(size)) {
+    return NULL;
+  }
 
-  if (result != NULL) {
-    malloc_count += 1;
+  allocator = GetAllocator();
+  header = allocator->malloc_func(
+      allocator->context,
+      sizeof(*header) + size
+  );
+  if (header == NULL) {
+    return NULL;
   }
 
-  return result;
+  RecordMalloc(header, allocator, size, 0);
+
+  return header + 1;
 }
 
 void* Mdc_calloc(size_t num, size_t size) {
-  void* result;
+  const struct Mdc_AllocatorVTable* allocator;
+  union BlockHeader* header;
+  size_t total_size;
 
-  result = calloc(num, size);
+  if (size != 0 && num > (size_t) -1 / size) {
+    return NULL;
+  }
+
+  total_size = num * size;
+  if (IsSizeTooLarge(total_size)) {
+    return NULL;
+  }
 
-  if (result != NULL) {
-    malloc_count += 1;
+  allocator = GetAllocator();
+  header = allocator->calloc_func(
+      allocator->context,
+      1,
+      sizeof(*header) + total_size
+  );
+  if (header == NULL) {
+    return NULL;
   }
 
-  return result;
+  RecordMalloc(header, allocator, total_size, 0);
+
+  return header + 1;
 }
 
 void* Mdc_realloc(void* ptr, size_t new_size) {
-  void* result;
+  const struct Mdc_AllocatorVTable* allocator;
+  union BlockHeader* header;
+  size_t old_size;
+  int is_old_counted;
 
-  result = realloc(ptr, new_size);
+  if (ptr == NULL) {
+    return Mdc_malloc(new_size);
+  }
 
-  if (result != NULL) {
-    if (ptr != NULL) {
-      free_count += 1;
-    }
+  if (IsSizeTooLarge(new_size)) {
+    return NULL;
+  }
 
-    malloc_count += 1;
+  header = GetHeader(ptr);
+  if (header->info.is_aligned) {
+    return NULL;
   }
 
-  return result;
+  allocator = header->info.allocator;
+  old_size = header->info.size;
+  is_old_counted = header->info.is_counted;
+
+  header = allocator->realloc_func(
+      allocator->context,
+      header,
+      sizeof(*header) + new_size
+  );
+  if (header == NULL) {
+    return NULL;
+  }
+
+  /* Accounted as freeing the old block and allocating a new one. */
+  RecordFree(old_size, is_old_counted);
+  RecordMalloc(header, allocator, new_size, 0);
+
+  return header + 1;
 }
 
 void Mdc_free(void* ptr) {
-  free(ptr);
+  const struct Mdc_AllocatorVTable* allocator;
+  union BlockHeader* header;
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  header = GetHeader(ptr);
+  RecordFree(header->info.size, header->info.is_counted);
+
+  allocator = header->info.allocator;
+  if (header->info.is_aligned) {
+    Mdc_Allocator_FreeAligned(allocator, ((void**) header)[-1]);
+    return;
+  }
+
+  allocator->free_func(allocator->context, header);
+}
+
+void* Mdc_AlignedAlloc(size_t alignment, size_t size) {
+  const struct Mdc_AllocatorVTable* allocator;
+  union BlockHeader* header;
+  unsigned char* block;
+  size_t offset;
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    return NULL;
+  }
+
+  /* The header must itself be aligned, just before the block. */
+  if (alignment < offsetof(struct BlockHeaderAlignmentProbe, header)) {
+    alignment = offsetof(struct BlockHeaderAlignmentProbe, header);
+  }
+
+  if (alignment > (size_t) -1 / 2) {
+    return NULL;
+  }
+
+  offset = (sizeof(*header) + sizeof(void*) + (alignment - 1))
+      & ~(alignment - 1);
+  if (size > (size_t) -1 - offset) {
+    return NULL;
+  }
+
+  allocator = GetAllocator();
+  block = Mdc_Allocator_AllocateAligned(allocator, offset + size, alignment);
+  if (block == NULL) {
+    return NULL;
+  }
+
+  header = GetHeader(block + offset);
+  ((void**) header)[-1] = block;
+
+  RecordMalloc(header, allocator, size, 1);
+
+  return header + 1;
+}
+
+void Mdc_AlignedFree(void* ptr) {
+  Mdc_free(ptr);
+}
+
+void Mdc_FreeSized(void* ptr, size_t size) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  assert(GetHeader(ptr)->info.size == size);
+  (void) size;
+
+  Mdc_free(ptr);
+}
+
+size_t Mdc_AllocUsableSize(const void* ptr) {
+  if (ptr == NULL) {
+    return 0;
+  }
+
+  return GetHeader((void*) ptr)->info.size;
+}
+
+void Mdc_SetAllocator(const struct Mdc_AllocatorVTable* vtable) {
+  atomic_store_explicit(
+      &current_allocator,
+      (uintptr_t) vtable,
+      memory_order_release
+  );
+}
 
-  free_count += 1;
+const struct Mdc_AllocatorVTable* Mdc_GetAllocator(void) {
+  return GetAllocator();
+}
+
+int Mdc_IsMallocAccountingEnabled(void) {
+  return (int) atomic_load_explicit(
+      &is_accounting_enabled,
+      memory_order_relaxed
+  );
+}
+
+void Mdc_SetMallocAccountingEnabled(int is_enabled) {
+  atomic_store_explicit(
+      &is_accounting_enabled,
+      is_enabled != 0,
+      memory_order_relaxed
+  );
+}
+
+void Mdc_GetMallocStats(struct Mdc_MallocStats* stats) {
+  struct ShardCounters* counters;
+  size_t i;
+
+  memset(stats, 0, sizeof(*stats));
+
+  for (i = 0; i < kShardsCount; ++i) {
+    counters = &shards[i].counters;
+
+    stats->malloc_count += Mdc_ShardedCounter_Load(&counters->malloc_count);
+    stats->free_count += Mdc_ShardedCounter_Load(&counters->free_count);
+    stats->allocated_bytes +=
+        Mdc_ShardedCounter_Load(&counters->allocated_bytes);
+    stats->freed_bytes += Mdc_ShardedCounter_Load(&counters->freed_bytes);
+  }
+
+  stats->current_bytes = (stats->allocated_bytes > stats->freed_bytes)
+      ? (size_t) (stats->allocated_bytes - stats->freed_bytes)
+      : 0;
+
+  stats->peak_bytes = (size_t) atomic_load_explicit(
+      &peak_bytes,
+      memory_order_relaxed
+  );
+  if (stats->peak_bytes < stats->current_bytes) {
+    stats->peak_bytes = stats->current_bytes;
+  }
 }
 
 int Mdc_GetMallocDifference(void) {
-  return malloc_count - free_count;
+  struct Mdc_MallocStats stats;
+
+  Mdc_GetMallocStats(&stats);
+
+  return (int) (stats.malloc_count - stats.free_count);
 }
 
 void Mdc_PrintMallocLeaks(void) {
-  printf("Number of mallocs: %d \n", malloc_count);
-  printf("Number of frees: %d \n", free_count);
-  printf("Difference: %d \n", Mdc_GetMallocDifference());
-}
+  struct Mdc_MallocStats stats;
 
-#endif
+  Mdc_GetMallocStats(&stats);
+
+  printf("Number of mallocs: %d \n", (int) stats.malloc_count);
+  printf("Number of frees: %d \n", (int) stats.free_count);
+  printf("Difference: %d \n", (int) (stats.malloc_count - stats.free_count));
+  printf("Bytes in use: %lu \n", (unsigned long) stats.current_bytes);
+  printf("Peak bytes in use: %lu \n", (unsigned long) stats.peak_bytes);
+}
@@ -0,0 +1,53 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_MALLOC_MALLOC_ACCOUNTING_H_
+#define MDC_C_MALLOC_MALLOC_ACCOUNTING_H_
+
+#include <stddef.h>
+
+/*
+* Hooks through which allocators that do not go through Mdc_malloc,
+* such as Mdc_Pool, record their allocations in the malloc
+* accounting. The caller decides whether an allocation is counted,
+* and must record the free of every counted allocation.
+*/
+
+/**
+ * Records an allocation of the specified number of bytes.
+ */
+void Mdc_MallocAccounting_RecordMalloc(size_t size);
+
+/**
+ * Records the free of a counted allocation of the specified number of
+ * bytes.
+ */
+void Mdc_MallocAccounting_RecordFree(size_t size);
+
+#endif /* MDC_C_MALLOC_MALLOC_ACCOUNTING_H_ */
@@ -0,0 +1,416 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/malloc/pool.h"
+
+#include "../../../include/mdc/malloc/malloc.h"
+#include "allocator.h"
+#include "malloc_accounting.h"
+
+enum {
+  kCacheLineSize = 64,
+  kMagazineCapacity = Mdc_Pool_kMagazineCapacity,
+  kSlabSize = Mdc_Pool_kSlabSize
+};
+
+struct Mdc_PoolSlab {
+  struct Mdc_PoolSlab* next;
+  const struct Mdc_AllocatorVTable* allocator;
+};
+
+/*
+* Overlays every free slot. A magazine is a list of slots linked by
+* next. In the depot, the first slot of each magazine also links to
+* the next magazine and records the magazine's count.
+*/
+struct Mdc_PoolSlot {
+  struct Mdc_PoolSlot* next;
+
+  struct Mdc_PoolSlot* next_magazine;
+  size_t magazine_count;
+};
+
+/*
+* The objects cached by one thread. Allocations pop from the loaded
+* magazine. When it runs out, it is swapped with the previous
+* magazine, so that a thread alternating between allocating and
+* freeing around a magazine boundary does not hit the depot.
+*/
+struct Mdc_PoolCache {
+  struct Mdc_Pool* pool;
+
+  struct Mdc_PoolCache* previous_cache;
+  struct Mdc_PoolCache* next_cache;
+
+  struct Mdc_PoolSlot* loaded;
+  size_t loaded_count;
+
+  struct Mdc_PoolSlot* previous;
+  size_t previous_count;
+};
+
+static size_t RoundUpToCacheLine(size_t size) {
+  return (size + (kCacheLineSize - 1)) & ~(size_t) (kCacheLineSize - 1);
+}
+
+/*
+* Slabs bypass Mdc_malloc, since the objects carved out of them are
+* counted instead. The slab header takes up the first cache line.
+*/
+static int AddSlab(struct Mdc_Pool* pool) {
+  const struct Mdc_AllocatorVTable* allocator;
+  struct Mdc_PoolSlab* slab;
+
+  allocator = Mdc_GetAllocator();
+  slab = Mdc_Allocator_AllocateAligned(
+      allocator,
+      kCacheLineSize + pool->slots_per_slab_ * pool->slot_size_,
+      kCacheLineSize
+  );
+  if (slab == NULL) {
+    return 0;
+  }
+
+  slab->next = pool->slabs_;
+  slab->allocator = allocator;
+  pool->slabs_ = slab;
+
+  pool->carve_position_ = (unsigned char*) slab + kCacheLineSize;
+  pool->carve_slots_count_ = pool->slots_per_slab_;
+
+  return 1;
+}
+
+static void PushMagazine(
+    struct Mdc_Pool* pool,
+    struct Mdc_PoolSlot* magazine,
+    size_t count
+) {
+  if (count == 0) {
+    return;
+  }
+
+  magazine->next_magazine = pool->depot_;
+  magazine->magazine_count = count;
+  pool->depot_ = magazine;
+}
+
+/*
+* Loads the cache with a magazine from the depot, or with new slots
+* carved from a slab if the depot is empty. The pool must be locked.
+*/
+static int LoadMagazine(struct Mdc_Pool* pool, struct Mdc_PoolCache* cache) {
+  struct Mdc_PoolSlot* magazine;
+  struct Mdc_PoolSlot* slot;
+  size_t count;
+  size_t i;
+
+  if (pool->depot_ != NULL) {
+    magazine = pool->depot_;
+    pool->depot_ = magazine->next_magazine;
+
+    cache->loaded = magazine;
+    cache->loaded_count = magazine->magazine_count;
+
+    return 1;
+  }
+
+  if (pool->carve_slots_count_ == 0 && !AddSlab(pool)) {
+    return 0;
+  }
+
+  count = (pool->carve_slots_count_ < kMagazineCapacity)
+      ? pool->carve_slots_count_
+      : kMagazineCapacity;
+
+  magazine = NULL;
+  for (i = 0; i < count; ++i) {
+    slot = (struct Mdc_PoolSlot*) pool->carve_position_;
+    slot->next = magazine;
+    magazine = slot;
+
+    pool->carve_position_ += pool->slot_size_;
+  }
+
+  pool->carve_slots_count_ -= count;
+
+  cache->loaded = magazine;
+  cache->loaded_count = count;
+
+  return 1;
+}
+
+/*
+* Moves both magazines of the cache to the depot. The pool must be
+* locked.
+*/
+static void UnloadCache(struct Mdc_Pool* pool, struct Mdc_PoolCache* cache) {
+  PushMagazine(pool, cache->loaded, cache->loaded_count);
+  PushMagazine(pool, cache->previous, cache->previous_count);
+
+  cache->loaded = NULL;
+  cache->loaded_count = 0;
+  cache->previous = NULL;
+  cache->previous_count = 0;
+}
+
+static void DestroyCache(void* value) {
+  struct Mdc_PoolCache* cache;
+  struct Mdc_Pool* pool;
+
+  cache = value;
+  pool = cache->pool;
+
+  mtx_lock(&pool->mutex_);
+
+  UnloadCache(pool, cache);
+
+  if (cache->previous_cache == NULL) {
+    pool->caches_ = cache->next_cache;
+  } else {
+    cache->previous_cache->next_cache = cache->next_cache;
+  }
+
+  if (cache->next_cache != NULL) {
+    cache->next_cache->previous_cache = cache->previous_cache;
+  }
+
+  mtx_unlock(&pool->mutex_);
+
+  Mdc_AlignedFree(cache);
+}
+
+/*
+* Returns the cache of the calling thread, creating it on first use.
+* Returns NULL if out of memory.
+*/
+static struct Mdc_PoolCache* GetCache(struct Mdc_Pool* pool) {
+  struct Mdc_PoolCache* cache;
+
+  cache = tss_get(pool->cache_key_);
+  if (cache != NULL) {
+    return cache;
+  }
+
+  /* Caches of different threads must not share a cache line. */
+  cache = Mdc_AlignedAlloc(
+      kCacheLineSize,
+      RoundUpToCacheLine(sizeof(*cache))
+  );
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  cache->pool = pool;
+  cache->previous_cache = NULL;
+  cache->loaded = NULL;
+  cache->loaded_count = 0;
+  cache->previous = NULL;
+  cache->previous_count = 0;
+
+  if (tss_set(pool->cache_key_, cache) != thrd_success) {
+    Mdc_AlignedFree(cache);
+    return NULL;
+  }
+
+  mtx_lock(&pool->mutex_);
+
+  cache->next_cache = pool->caches_;
+  if (pool->caches_ != NULL) {
+    pool->caches_->previous_cache = cache;
+  }
+  pool->caches_ = cache;
+
+  mtx_unlock(&pool->mutex_);
+
+  return cache;
+}
+
+int Mdc_Pool_Init(struct Mdc_Pool* pool, size_t object_size) {
+  int result;
+
+  if (object_size < sizeof(struct Mdc_PoolSlot)) {
+    object_size = sizeof(struct Mdc_PoolSlot);
+  }
+
+  if (object_size > (size_t) -1 / 2) {
+    result = thrd_error;
+    goto return_bad;
+  }
+
+  pool->object_size_ = object_size;
+  pool->slot_size_ = RoundUpToCacheLine(object_size);
+  pool->slots_per_slab_ = (pool->slot_size_ < kSlabSize)
+      ? kSlabSize / pool->slot_size_
+      : 1;
+  pool->is_counted_ = Mdc_IsMallocAccountingEnabled();
+
+  pool->slabs_ = NULL;
+  pool->carve_position_ = NULL;
+  pool->carve_slots_count_ = 0;
+  pool->depot_ = NULL;
+  pool->caches_ = NULL;
+
+  result = mtx_init(&pool->mutex_, mtx_plain);
+  if (result != thrd_success) {
+    goto return_bad;
+  }
+
+  result = tss_create(&pool->cache_key_, &DestroyCache);
+  if (result != thrd_success) {
+    goto destroy_mutex;
+  }
+
+  return thrd_success;
+
+destroy_mutex:
+  mtx_destroy(&pool->mutex_);
+
+return_bad:
+  return result;
+}
+
+void Mdc_Pool_Deinit(struct Mdc_Pool* pool) {
+  struct Mdc_PoolCache* cache;
+  struct Mdc_PoolCache* next_cache;
+  struct Mdc_PoolSlab* slab;
+  struct Mdc_PoolSlab* next_slab;
+
+  /*
+  * Deleting the key first keeps the destructor from running on caches
+  * that are freed here.
+  */
+  tss_delete(pool->cache_key_);
+
+  for (cache = pool->caches_; cache != NULL; cache = next_cache) {
+    next_cache = cache->next_cache;
+    Mdc_AlignedFree(cache);
+  }
+
+  for (slab = pool->slabs_; slab != NULL; slab = next_slab) {
+    next_slab = slab->next;
+    Mdc_Allocator_FreeAligned(slab->allocator, slab);
+  }
+
+  mtx_destroy(&pool->mutex_);
+}
+
+void* Mdc_Pool_Allocate(struct Mdc_Pool* pool) {
+  struct Mdc_PoolCache* cache;
+  struct Mdc_PoolSlot* slot;
+  int is_load_success;
+
+  cache = GetCache(pool);
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  if (cache->loaded_count == 0) {
+    if (cache->previous_count != 0) {
+      cache->loaded = cache->previous;
+      cache->loaded_count = cache->previous_count;
+      cache->previous = NULL;
+      cache->previous_count = 0;
+    } else {
+      mtx_lock(&pool->mutex_);
+      is_load_success = LoadMagazine(pool, cache);
+      mtx_unlock(&pool->mutex_);
+
+      if (!is_load_success) {
+        return NULL;
+      }
+    }
+  }
+
+  slot = cache->loaded;
+  cache->loaded = slot->next;
+  cache->loaded_count -= 1;
+
+  if (pool->is_counted_) {
+    Mdc_MallocAccounting_RecordMalloc(pool->object_size_);
+  }
+
+  return slot;
+}
+
+void Mdc_Pool_Free(struct Mdc_Pool* pool, void* ptr) {
+  struct Mdc_PoolCache* cache;
+  struct Mdc_PoolSlot* slot;
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (pool->is_counted_) {
+    Mdc_MallocAccounting_RecordFree(pool->object_size_);
+  }
+
+  slot = ptr;
+
+  cache = GetCache(pool);
+  if (cache == NULL) {
+    /* Without a cache, the object goes straight to the depot. */
+    mtx_lock(&pool->mutex_);
+    slot->next = NULL;
+    PushMagazine(pool, slot, 1);
+    mtx_unlock(&pool->mutex_);
+
+    return;
+  }
+
+  if (cache->loaded_count == kMagazineCapacity) {
+    if (cache->previous_count != 0) {
+      mtx_lock(&pool->mutex_);
+      PushMagazine(pool, cache->previous, cache->previous_count);
+      mtx_unlock(&pool->mutex_);
+    }
+
+    cache->previous = cache->loaded;
+    cache->previous_count = cache->loaded_count;
+    cache->loaded = NULL;
+    cache->loaded_count = 0;
+  }
+
+  slot->next = cache->loaded;
+  cache->loaded = slot;
+  cache->loaded_count += 1;
+}
+
+void Mdc_Pool_FlushThreadCache(struct Mdc_Pool* pool) {
+  struct Mdc_PoolCache* cache;
+
+  cache = tss_get(pool->cache_key_);
+  if (cache == NULL) {
+    return;
+  }
+
+  mtx_lock(&pool->mutex_);
+  UnloadCache(pool, cache);
+  mtx_unlock(&pool->mutex_);
+}
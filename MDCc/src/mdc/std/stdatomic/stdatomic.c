@@ -0,0 +1,201 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../../include/mdc/std/stdatomic.h"
+
+#if __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+
+#if defined(_MSC_VER)
+
+#include <windows.h>
+
+void Mdc_Atomic_ThreadFence(enum Mdc_MemoryOrder order) {
+  if (order == memory_order_relaxed) {
+    return;
+  }
+
+  MemoryBarrier();
+}
+
+void Mdc_Atomic_SignalFence(enum Mdc_MemoryOrder order) {
+  if (order == memory_order_relaxed) {
+    return;
+  }
+
+  _ReadWriteBarrier();
+}
+
+long Mdc_Atomic_Exchange32(volatile long* obj, long desired) {
+  return InterlockedExchange(obj, desired);
+}
+
+int Mdc_Atomic_CompareExchange32(
+    volatile long* obj,
+    long* expected,
+    long desired
+) {
+  long old_value;
+
+  old_value = InterlockedCompareExchange(obj, desired, *expected);
+  if (old_value == *expected) {
+    return 1;
+  }
+
+  *expected = old_value;
+  return 0;
+}
+
+long Mdc_Atomic_FetchAdd32(volatile long* obj, long arg) {
+  return InterlockedExchangeAdd(obj, arg);
+}
+
+/*
+* The interlocked bitwise functions are not available in older
+* compilers, so the bitwise operations loop on a compare-exchange.
+*/
+
+long Mdc_Atomic_FetchOr32(volatile long* obj, long arg) {
+  long old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange32(obj, &old_value, old_value | arg)) {
+  }
+
+  return old_value;
+}
+
+long Mdc_Atomic_FetchAnd32(volatile long* obj, long arg) {
+  long old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange32(obj, &old_value, old_value & arg)) {
+  }
+
+  return old_value;
+}
+
+long Mdc_Atomic_FetchXor32(volatile long* obj, long arg) {
+  long old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange32(obj, &old_value, old_value ^ arg)) {
+  }
+
+  return old_value;
+}
+
+#if defined(_WIN64)
+
+__int64 Mdc_Atomic_Exchange64(volatile __int64* obj, __int64 desired) {
+  return InterlockedExchange64(obj, desired);
+}
+
+int Mdc_Atomic_CompareExchange64(
+    volatile __int64* obj,
+    __int64* expected,
+    __int64 desired
+) {
+  __int64 old_value;
+
+  old_value = InterlockedCompareExchange64(obj, desired, *expected);
+  if (old_value == *expected) {
+    return 1;
+  }
+
+  *expected = old_value;
+  return 0;
+}
+
+__int64 Mdc_Atomic_FetchAdd64(volatile __int64* obj, __int64 arg) {
+  return InterlockedExchangeAdd64(obj, arg);
+}
+
+__int64 Mdc_Atomic_FetchOr64(volatile __int64* obj, __int64 arg) {
+  __int64 old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange64(obj, &old_value, old_value | arg)) {
+  }
+
+  return old_value;
+}
+
+__int64 Mdc_Atomic_FetchAnd64(volatile __int64* obj, __int64 arg) {
+  __int64 old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange64(obj, &old_value, old_value & arg)) {
+  }
+
+  return old_value;
+}
+
+__int64 Mdc_Atomic_FetchXor64(volatile __int64* obj, __int64 arg) {
+  __int64 old_value;
+
+  old_value = *obj;
+  while (!Mdc_Atomic_CompareExchange64(obj, &old_value, old_value ^ arg)) {
+  }
+
+  return old_value;
+}
+
+#endif /* defined(_WIN64) */
+
+#elif defined(__GNUC__) && defined(__ATOMIC_RELAXED)
+
+void Mdc_Atomic_ThreadFence(enum Mdc_MemoryOrder order) {
+  __atomic_thread_fence(order);
+}
+
+void Mdc_Atomic_SignalFence(enum Mdc_MemoryOrder order) {
+  __atomic_signal_fence(order);
+}
+
+#elif defined(__GNUC__)
+
+void Mdc_Atomic_ThreadFence(enum Mdc_MemoryOrder order) {
+  if (order == memory_order_relaxed) {
+    return;
+  }
+
+  __sync_synchronize();
+}
+
+void Mdc_Atomic_SignalFence(enum Mdc_MemoryOrder order) {
+  if (order == memory_order_relaxed) {
+    return;
+  }
+
+  __asm__ __volatile__("" : : : "memory");
+}
+
+#endif
+
+#endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__) */
@@ -29,6 +29,8 @@
 
 #include "../../../../include/mdc/std/threads.h"
 
+#include "deadline.h"
+
 #if __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__)
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -130,14 +132,229 @@ return_bad:
   return thrd_error;
 }
 
+int cnd_timedwait(
+    cnd_t* cond,
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
+  DWORD wait_result;
+  LONG has_signal_pass;
+  int mtx_unlock_result;
+  int mtx_lock_result;
+  int result;
+
+  mtx_unlock_result = mtx_unlock(mutex);
+  if (mtx_unlock_result != thrd_success) {
+    goto return_bad;
+  }
+
+  /*
+  * Same as cnd_wait, except that the wait is bounded by the time
+  * remaining until the deadline.
+  */
+  result = thrd_success;
+  do {
+    wait_result = WaitForSingleObject(
+        cond->waiter_event_,
+        Mdc_Deadline_GetRemainingMilliseconds(time_point)
+    );
+
+    if (wait_result == WAIT_TIMEOUT) {
+      result = thrd_timedout;
+      break;
+    } else if (wait_result == WAIT_FAILED) {
+      result = thrd_error;
+      break;
+    }
+
+    has_signal_pass = InterlockedExchange(&cond->has_signal_pass, 1);
+  } while (has_signal_pass && cond->is_broadcast);
+
+  mtx_lock_result = mtx_lock(mutex);
+  if (mtx_lock_result != thrd_success) {
+    goto return_bad;
+  }
+
+  return result;
+
+return_bad:
+  return thrd_error;
+}
+
+#elif defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+
+#include <limits.h>
+#include <stddef.h>
+
+#include "../../../../include/mdc/std/stdatomic.h"
+#include "futex.h"
+#include "mutex.h"
+
+/*
+* Waiters block on the sequence word, which is advanced on every
+* signal and broadcast so that a wakeup between the unlock of the
+* mutex and the futex wait is never lost.
+*
+* A broadcast wakes only one waiter and requeues the rest onto the
+* mutex's futex word, where the kernel hands them the mutex one at a
+* time as it is unlocked. Waking all of them would only have them
+* stampede on the mutex. Woken waiters lock the mutex as contended so
+* that each unlock wakes the next requeued waiter.
+*/
+
+int cnd_init(cnd_t* cond) {
+  cond->sequence_ = 0;
+  cond->mutex_ = NULL;
+
+  return thrd_success;
+}
+
+void cnd_destroy(cnd_t* cond) {
+  /* The futex word holds no kernel resources. */
+  (void) cond;
+}
+
+int cnd_signal(cnd_t* cond) {
+  atomic_fetch_add_explicit(&cond->sequence_, 1, memory_order_release);
+
+  return Mdc_Futex_Wake(&cond->sequence_, 1);
+}
+
+int cnd_broadcast(cnd_t* cond) {
+  mtx_t* mutex;
+  int sequence;
+  int requeue_result;
+
+  mutex = atomic_load_explicit(&cond->mutex_, memory_order_relaxed);
+  sequence = (int) atomic_fetch_add_explicit(
+      &cond->sequence_,
+      1,
+      memory_order_release
+  ) + 1;
+
+  if (mutex == NULL) {
+    return Mdc_Futex_Wake(&cond->sequence_, INT_MAX);
+  }
+
+  requeue_result = Mdc_Futex_Requeue(
+      &cond->sequence_,
+      sequence,
+      1,
+      &mutex->state_,
+      INT_MAX
+  );
+
+  /*
+  * Another signal or broadcast advanced the sequence in the meantime.
+  * Waking everyone is always correct.
+  */
+  if (requeue_result == thrd_busy) {
+    return Mdc_Futex_Wake(&cond->sequence_, INT_MAX);
+  }
+
+  return requeue_result;
+}
+
+static int WaitUntil(
+    cnd_t* cond,
+    mtx_t* mutex,
+    const struct timespec* monotonic_time_point
+) {
+  int sequence;
+  int wait_result;
+  int mtx_unlock_result;
+  int mtx_lock_result;
+
+  atomic_store_explicit(&cond->mutex_, mutex, memory_order_relaxed);
+  sequence = (int) atomic_load_explicit(
+      &cond->sequence_,
+      memory_order_relaxed
+  );
+
+  mtx_unlock_result = mtx_unlock(mutex);
+  if (mtx_unlock_result != thrd_success) {
+    return thrd_error;
+  }
+
+  wait_result = Mdc_Futex_WaitUntil(
+      &cond->sequence_,
+      sequence,
+      monotonic_time_point,
+      CLOCK_MONOTONIC
+  );
+
+  mtx_lock_result = Mdc_Mutex_LockContended(mutex);
+  if (mtx_lock_result != thrd_success) {
+    return thrd_error;
+  }
+
+  /*
+  * A requeued waiter can time out while waiting for the mutex, after
+  * it was already woken by the broadcast.
+  */
+  if (wait_result == thrd_timedout
+      && atomic_load_explicit(&cond->sequence_, memory_order_relaxed)
+          != sequence) {
+    return thrd_success;
+  }
+
+  return wait_result;
+}
+
+int cnd_wait(cnd_t* cond, mtx_t* mutex) {
+  int wait_result;
+
+  wait_result = WaitUntil(cond, mutex, NULL);
+
+  return (wait_result == thrd_success) ? thrd_success : thrd_error;
+}
+
+int cnd_timedwait(
+    cnd_t* cond,
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
+  struct timespec monotonic_time_point;
+
+  Mdc_Deadline_ToMonotonic(&monotonic_time_point, time_point);
+
+  return WaitUntil(cond, mutex, &monotonic_time_point);
+}
+
 #elif defined(__GNUC__)
 
 #include <errno.h>
 
+#include "mutex.h"
+
+/*
+* On Linux, condition variables wait against CLOCK_MONOTONIC so that
+* timed waits are not stretched or cut short by changes to the system
+* clock. The TIME_UTC deadline is converted when the wait starts.
+*/
+#if defined(__linux__)
+#define MDC_COND_MONOTONIC_CLOCK
+#endif
+
 int cnd_init(cnd_t* cond) {
   int result;
 
+#if defined(MDC_COND_MONOTONIC_CLOCK)
+  pthread_condattr_t attr;
+
+  result = pthread_condattr_init(&attr);
+  if (result == 0) {
+    result = pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    if (result == 0) {
+      result = pthread_cond_init(cond, &attr);
+    }
+
+    pthread_condattr_destroy(&attr);
+  }
+#else
   result = pthread_cond_init(cond, NULL);
+#endif
 
   if (result == 0) {
     return thrd_success;
@@ -171,11 +388,45 @@ int cnd_broadcast(cnd_t* cond) {
 int cnd_wait(cnd_t* cond, mtx_t* mutex) {
   int result;
 
+  Mdc_Mutex_ProfileUnlock(mutex);
   result = pthread_cond_wait(cond, mutex);
+  Mdc_Mutex_ProfileRelock(mutex);
 
   return (result == 0) ? thrd_success : thrd_error;
 }
 
+int cnd_timedwait(
+    cnd_t* cond,
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
+  int result;
+
+#if defined(MDC_COND_MONOTONIC_CLOCK)
+  struct timespec monotonic_time_point;
+#endif
+
+  Mdc_Mutex_ProfileUnlock(mutex);
+
+#if defined(MDC_COND_MONOTONIC_CLOCK)
+  Mdc_Deadline_ToMonotonic(&monotonic_time_point, time_point);
+
+  result = pthread_cond_timedwait(cond, mutex, &monotonic_time_point);
+#else
+  result = pthread_cond_timedwait(cond, mutex, time_point);
+#endif
+
+  Mdc_Mutex_ProfileRelock(mutex);
+
+  if (result == 0) {
+    return thrd_success;
+  } else if (result == ETIMEDOUT) {
+    return thrd_timedout;
+  } else {
+    return thrd_error;
+  }
+}
+
 #endif
 
 #endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__) */
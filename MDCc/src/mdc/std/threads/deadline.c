@@ -0,0 +1,107 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "deadline.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+enum {
+  kMillisecondsPerSecond = 1000,
+  kNanosecondsPerMillisecond = 1000000
+};
+
+DWORD Mdc_Deadline_GetRemainingMilliseconds(
+    const struct timespec* time_point
+) {
+  const DWORD kMaxMilliseconds = INFINITE - 1;
+
+  struct timespec now;
+  time_t remaining_seconds;
+  long remaining_nanoseconds;
+
+  timespec_get(&now, TIME_UTC);
+
+  remaining_seconds = time_point->tv_sec - now.tv_sec;
+  remaining_nanoseconds = time_point->tv_nsec - now.tv_nsec;
+
+  if (remaining_nanoseconds < 0) {
+    remaining_seconds -= 1;
+    remaining_nanoseconds += kMillisecondsPerSecond
+        * kNanosecondsPerMillisecond;
+  }
+
+  if (remaining_seconds < 0) {
+    return 0;
+  }
+
+  if (remaining_seconds >= kMaxMilliseconds / kMillisecondsPerSecond) {
+    return kMaxMilliseconds;
+  }
+
+  return (DWORD) remaining_seconds * kMillisecondsPerSecond
+      + (remaining_nanoseconds + kNanosecondsPerMillisecond - 1)
+          / kNanosecondsPerMillisecond;
+}
+
+#elif defined(__GNUC__)
+
+enum {
+  kNanosecondsPerSecond = 1000000000
+};
+
+void Mdc_Deadline_ToMonotonic(
+    struct timespec* monotonic_time_point,
+    const struct timespec* time_point
+) {
+  struct timespec now;
+  struct timespec monotonic_now;
+
+  clock_gettime(CLOCK_REALTIME, &now);
+  clock_gettime(CLOCK_MONOTONIC, &monotonic_now);
+
+  monotonic_time_point->tv_sec = monotonic_now.tv_sec
+      + (time_point->tv_sec - now.tv_sec);
+  monotonic_time_point->tv_nsec = monotonic_now.tv_nsec
+      + (time_point->tv_nsec - now.tv_nsec);
+
+  if (monotonic_time_point->tv_nsec < 0) {
+    monotonic_time_point->tv_sec -= 1;
+    monotonic_time_point->tv_nsec += kNanosecondsPerSecond;
+  } else if (monotonic_time_point->tv_nsec >= kNanosecondsPerSecond) {
+    monotonic_time_point->tv_sec += 1;
+    monotonic_time_point->tv_nsec -= kNanosecondsPerSecond;
+  }
+
+  if (monotonic_time_point->tv_sec < 0) {
+    monotonic_time_point->tv_sec = 0;
+    monotonic_time_point->tv_nsec = 0;
+  }
+}
+
+#endif
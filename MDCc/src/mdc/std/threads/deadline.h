@@ -0,0 +1,67 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_STD_THREADS_DEADLINE_H_
+#define MDC_C_STD_THREADS_DEADLINE_H_
+
+#include "../../../../include/mdc/std/threads.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+/**
+ * Returns the number of milliseconds remaining until the specified
+ * TIME_UTC based time point, rounded up. Returns 0 if the time point
+ * has already passed.
+ *
+ * @param time_point the absolute TIME_UTC based deadline
+ * @return the remaining milliseconds, never INFINITE
+ */
+DWORD Mdc_Deadline_GetRemainingMilliseconds(
+    const struct timespec* time_point
+);
+
+#elif defined(__GNUC__)
+
+/**
+ * Converts an absolute TIME_UTC time point into the equivalent
+ * CLOCK_MONOTONIC time point, measured from the current time. Waiting
+ * on the monotonic time point is unaffected by changes to the system
+ * clock.
+ *
+ * @param monotonic_time_point the destination monotonic time point
+ * @param time_point the source TIME_UTC time point
+ */
+void Mdc_Deadline_ToMonotonic(
+    struct timespec* monotonic_time_point,
+    const struct timespec* time_point
+);
+
+#endif
+
+#endif /* MDC_C_STD_THREADS_DEADLINE_H_ */
@@ -0,0 +1,153 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "futex.h"
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../../../../include/mdc/concurrency/thread_local.h"
+
+static MDC_THREAD_LOCAL int current_thread_id = 0;
+
+int Mdc_Futex_Wait(int* address, int expected) {
+  long result;
+
+  result = syscall(
+      SYS_futex,
+      address,
+      FUTEX_WAIT_PRIVATE,
+      expected,
+      NULL,
+      NULL,
+      0
+  );
+
+  /*
+  * EAGAIN means that the value changed before the thread could
+  * block, and EINTR is a spurious wakeup. Both count as a wakeup.
+  */
+  if (result == -1 && errno != EAGAIN && errno != EINTR) {
+    return thrd_error;
+  }
+
+  return thrd_success;
+}
+
+int Mdc_Futex_WaitUntil(
+    int* address,
+    int expected,
+    const struct timespec* time_point,
+    clockid_t clock_id
+) {
+  int futex_op;
+  long result;
+
+  futex_op = FUTEX_WAIT_BITSET_PRIVATE;
+  if (clock_id == CLOCK_REALTIME) {
+    futex_op |= FUTEX_CLOCK_REALTIME;
+  }
+
+  result = syscall(
+      SYS_futex,
+      address,
+      futex_op,
+      expected,
+      time_point,
+      NULL,
+      FUTEX_BITSET_MATCH_ANY
+  );
+
+  if (result == -1) {
+    if (errno == ETIMEDOUT) {
+      return thrd_timedout;
+    } else if (errno != EAGAIN && errno != EINTR) {
+      return thrd_error;
+    }
+  }
+
+  return thrd_success;
+}
+
+int Mdc_Futex_Wake(int* address, int count) {
+  long result;
+
+  result = syscall(
+      SYS_futex,
+      address,
+      FUTEX_WAKE_PRIVATE,
+      count,
+      NULL,
+      NULL,
+      0
+  );
+
+  return (result == -1) ? thrd_error : thrd_success;
+}
+
+int Mdc_Futex_Requeue(
+    int* address,
+    int expected,
+    int wake_count,
+    int* requeue_address,
+    int requeue_count
+) {
+  long result;
+
+  /* The requeue count is passed in place of the timeout. */
+  result = syscall(
+      SYS_futex,
+      address,
+      FUTEX_CMP_REQUEUE_PRIVATE,
+      wake_count,
+      (unsigned long) requeue_count,
+      requeue_address,
+      expected
+  );
+
+  if (result == -1) {
+    return (errno == EAGAIN) ? thrd_busy : thrd_error;
+  }
+
+  return thrd_success;
+}
+
+int Mdc_Futex_GetThreadId(void) {
+  if (current_thread_id == 0) {
+    current_thread_id = (int) syscall(SYS_gettid);
+  }
+
+  return current_thread_id;
+}
+
+#endif /* defined(__linux__) */
@@ -0,0 +1,110 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_STD_THREADS_FUTEX_H_
+#define MDC_C_STD_THREADS_FUTEX_H_
+
+#include "../../../../include/mdc/std/threads.h"
+
+#if defined(__linux__)
+
+/**
+ * Blocks the calling thread until woken, as long as the value at the
+ * address is equal to the expected value. Spurious wakeups are
+ * possible.
+ *
+ * @param address the address of the futex word
+ * @param expected the value that the futex word must hold to block
+ * @return thrd_success on wakeup, or thrd_error on failure
+ */
+int Mdc_Futex_Wait(int* address, int expected);
+
+/**
+ * Blocks the calling thread until woken or until the absolute time
+ * point of the specified clock is reached, as long as the value at
+ * the address is equal to the expected value. Spurious wakeups are
+ * possible.
+ *
+ * @param address the address of the futex word
+ * @param expected the value that the futex word must hold to block
+ * @param time_point the absolute deadline, or NULL to wait forever
+ * @param clock_id CLOCK_REALTIME or CLOCK_MONOTONIC
+ * @return thrd_success on wakeup, thrd_timedout if the deadline was
+ *    reached, or thrd_error on failure
+ */
+int Mdc_Futex_WaitUntil(
+    int* address,
+    int expected,
+    const struct timespec* time_point,
+    clockid_t clock_id
+);
+
+/**
+ * Wakes up to the specified number of threads that are blocked on
+ * the futex word.
+ *
+ * @param address the address of the futex word
+ * @param count the maximum number of threads to wake
+ * @return thrd_success on success, or thrd_error on failure
+ */
+int Mdc_Futex_Wake(int* address, int count);
+
+/**
+ * Wakes up to the specified number of threads that are blocked on
+ * the futex word, and moves up to the specified number of the
+ * remaining threads to wait on the second futex word instead, as
+ * long as the value at the first address is equal to the expected
+ * value.
+ *
+ * @param address the address of the futex word
+ * @param expected the value that the futex word must hold
+ * @param wake_count the maximum number of threads to wake
+ * @param requeue_address the address of the futex word to move the
+ *    remaining threads to
+ * @param requeue_count the maximum number of threads to move
+ * @return thrd_success on success, thrd_busy if the futex word did
+ *    not hold the expected value, or thrd_error on failure
+ */
+int Mdc_Futex_Requeue(
+    int* address,
+    int expected,
+    int wake_count,
+    int* requeue_address,
+    int requeue_count
+);
+
+/**
+ * Returns the kernel thread ID of the calling thread. The value is
+ * cached per thread after the first call.
+ */
+int Mdc_Futex_GetThreadId(void);
+
+#endif /* defined(__linux__) */
+
+#endif /* MDC_C_STD_THREADS_FUTEX_H_ */
@@ -27,13 +27,162 @@
  *  to convey the resulting work.
  */
 
-#include "../../../../include/mdc/std/threads.h"
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "mutex.h"
 
 #if __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__)
 
+#include "../../../../include/mdc/concurrency/mtx.h"
+#include "../../concurrency/monotonic_clock.h"
+#include "../../concurrency/mtx_profile.h"
+
+/*
+* Valid types are mtx_plain or mtx_timed, optionally combined with
+* mtx_recursive and mtx_adaptive.
+*/
+static int IsValidMutexType(int type) {
+  int base_type;
+
+  base_type = type & ~(mtx_recursive | mtx_adaptive);
+
+  return base_type == mtx_plain || base_type == mtx_timed;
+}
+
+#if defined(_MSC_VER) || defined(__MINGW32__) \
+    || (defined(__linux__) && defined(MDC_C_FUTEX_THREADS))
+
+#include "../../../../include/mdc/std/stdatomic.h"
+#include "../../concurrency/cpu_pause.h"
+
+/*
+* An adaptive mutex spins before it sleeps. Each mutex learns a spin
+* budget from how long its recent contended acquisitions had to spin,
+* which follows how long the mutex is usually held. A mutex with short
+* critical sections keeps spinning, while one that is held for long
+* soon stops spinning and sleeps right away. The pause between
+* attempts doubles each time, so that spinning threads do not keep
+* pulling the mutex's cache line away from its owner.
+*/
+enum {
+  kMinSpinCount = 16,
+  kMaxBackoffCount = 64
+};
+
+static int IsTimedMutex(const mtx_t* mutex) {
+  return (mutex->type_ & mtx_timed) == mtx_timed;
+}
+
+static int SpinLock(mtx_t* mutex, int (*try_lock)(mtx_t*)) {
+  int spin_count;
+  int spin_limit;
+  unsigned int max_spin_limit;
+  int spins;
+  int backoff;
+  int i;
+
+  spin_count = (int) atomic_load_explicit(
+      &mutex->spin_count_,
+      memory_order_relaxed
+  );
+
+  /* Leave room to learn that a longer spin would have succeeded. */
+  spin_limit = spin_count * 2 + kMinSpinCount;
+
+  max_spin_limit = Mdc_Mtx_GetAdaptiveSpinLimit();
+  if ((unsigned int) spin_limit > max_spin_limit) {
+    spin_limit = (int) max_spin_limit;
+  }
+
+  spins = 0;
+  backoff = 1;
+  while (spins < spin_limit) {
+    for (i = 0; i < backoff; i += 1) {
+      MDC_CPU_PAUSE();
+    }
+
+    spins += backoff;
+
+    if (try_lock(mutex)) {
+      /* Move the budget an eighth of the way towards this spin. */
+      if (spins > spin_count) {
+        spin_count += (spins - spin_count + 7) / 8;
+      } else {
+        spin_count -= (spin_count - spins) / 8;
+      }
+
+      atomic_store_explicit(
+          &mutex->spin_count_,
+          spin_count,
+          memory_order_relaxed
+      );
+
+      return 1;
+    }
+
+    if (backoff < kMaxBackoffCount) {
+      backoff *= 2;
+    }
+  }
+
+  /* Spinning did not pay off, so spin less next time. */
+  atomic_store_explicit(
+      &mutex->spin_count_,
+      spin_count - (spin_count + 7) / 8,
+      memory_order_relaxed
+  );
+
+  return 0;
+}
+
+#endif
+
 #if defined(_MSC_VER) || defined(__MINGW32__)
 
+#include "deadline.h"
+
+static int TryLockMutex(mtx_t* mutex);
+
+static int LockWithTimeout(mtx_t* mutex, DWORD milliseconds) {
+  DWORD wait_result;
+  BOOL is_release_success;
+
+  wait_result = WaitForSingleObject(mutex->mutex_, milliseconds);
+
+  switch (wait_result) {
+    case WAIT_TIMEOUT: {
+      return thrd_timedout;
+    }
+
+    case WAIT_FAILED: {
+      return thrd_error;
+    }
+
+    default: {
+      break;
+    }
+  }
+
+  /*
+  * If the mutex is not recursive, then error on recursive locking.
+  */
+  if (!(mutex->type_ & mtx_recursive) && mutex->is_owned_) {
+    is_release_success = ReleaseMutex(mutex->mutex_);
+    return thrd_error;
+  }
+
+  atomic_store_explicit(&mutex->is_owned_, TRUE, memory_order_relaxed);
+
+  return thrd_success;
+}
+
 int mtx_init(mtx_t* mutex, int type) {
+  if (!IsValidMutexType(type)) {
+    goto return_bad;
+  }
+
   mutex->mutex_ = CreateMutexA(NULL, FALSE, NULL);
 
   if (mutex->mutex_ == NULL) {
@@ -42,6 +191,7 @@ int mtx_init(mtx_t* mutex, int type) {
 
   mutex->type_ = type;
   mutex->is_owned_ = FALSE;
+  mutex->spin_count_ = 0;
 
   return thrd_success;
 
@@ -49,36 +199,50 @@ return_bad:
   return thrd_error;
 }
 
-void mtx_destroy(mtx_t* mutex) {
+static void DestroyMutex(mtx_t* mutex) {
   BOOL close_handle_result;
 
   close_handle_result = CloseHandle(mutex->mutex_);
 }
 
-int mtx_lock(mtx_t* mutex) {
-  DWORD wait_result;
-  BOOL is_release_success;
+/*
+* Polling the mutex object costs a kernel call, so spin on the owned
+* flag instead and only try the mutex once it appears unlocked.
+*/
+static int TryLockForSpin(mtx_t* mutex) {
+  if (atomic_load_explicit(&mutex->is_owned_, memory_order_relaxed)) {
+    return 0;
+  }
 
-  wait_result = WaitForSingleObject(mutex->mutex_, INFINITE);
+  return TryLockMutex(mutex) == thrd_success;
+}
 
-  if (wait_result == WAIT_FAILED) {
-    return thrd_error;
+static int LockMutex(mtx_t* mutex) {
+  if ((mutex->type_ & mtx_adaptive) == mtx_adaptive) {
+    if (TryLockMutex(mutex) == thrd_success
+        || SpinLock(mutex, &TryLockForSpin)) {
+      return thrd_success;
+    }
   }
 
-  /*
-  * If the mutex is not recursive, then error on recursive locking.
-  */
-  if (!(mutex->type_ & mtx_recursive) && mutex->is_owned_) {
-    is_release_success = ReleaseMutex(mutex->mutex_);
+  return LockWithTimeout(mutex, INFINITE);
+}
+
+static int TimedLockMutex(
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
+  if (!IsTimedMutex(mutex)) {
     return thrd_error;
   }
 
-  mutex->is_owned_ = TRUE;
-
-  return thrd_success;
+  return LockWithTimeout(
+      mutex,
+      Mdc_Deadline_GetRemainingMilliseconds(time_point)
+  );
 }
 
-int mtx_trylock(mtx_t* mutex) {
+static int TryLockMutex(mtx_t* mutex) {
   DWORD wait_result;
   BOOL is_release_success;
 
@@ -112,18 +276,18 @@ int mtx_trylock(mtx_t* mutex) {
     return thrd_busy;
   }
 
-  mutex->is_owned_ = TRUE;
+  atomic_store_explicit(&mutex->is_owned_, TRUE, memory_order_relaxed);
 
   return thrd_success;
 }
 
-int mtx_unlock(mtx_t *mutex) {
+static int UnlockMutex(mtx_t* mutex) {
   BOOL is_release_success;
   BOOL was_owned;
 
   was_owned = mutex->is_owned_;
 
-  mutex->is_owned_ = FALSE;
+  atomic_store_explicit(&mutex->is_owned_, FALSE, memory_order_relaxed);
   is_release_success = ReleaseMutex(mutex->mutex_);
 
   if (!is_release_success) {
@@ -133,16 +297,264 @@ int mtx_unlock(mtx_t *mutex) {
   return thrd_success;
 
 return_bad:
-  mutex->is_owned_ = was_owned;
+  atomic_store_explicit(&mutex->is_owned_, was_owned, memory_order_relaxed);
 
   return thrd_error;
 }
 
+#elif defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+
+#include "futex.h"
+
+/*
+* The state word is 0 when unlocked, 1 when locked, and 2 when locked
+* with possible waiters blocked on the futex. Unlocking only enters
+* the kernel when the state word was 2.
+*/
+enum {
+  kMutexUnlocked = 0,
+  kMutexLocked = 1,
+  kMutexLockedContended = 2
+};
+
+static int LockContended(
+    mtx_t* mutex,
+    int state,
+    const struct timespec* time_point
+) {
+  int wait_result;
+
+  if (state != kMutexLockedContended) {
+    state = (int) atomic_exchange_explicit(
+        &mutex->state_,
+        kMutexLockedContended,
+        memory_order_acquire
+    );
+  }
+
+  while (state != kMutexUnlocked) {
+    wait_result = Mdc_Futex_WaitUntil(
+        &mutex->state_,
+        kMutexLockedContended,
+        time_point,
+        CLOCK_REALTIME
+    );
+
+    /*
+    * Besides timing out, the wait fails for an invalid time point.
+    * Retrying would never block again, so give up either way.
+    */
+    if (wait_result != thrd_success) {
+      return wait_result;
+    }
+
+    state = (int) atomic_exchange_explicit(
+        &mutex->state_,
+        kMutexLockedContended,
+        memory_order_acquire
+    );
+  }
+
+  return thrd_success;
+}
+
+static int TryLockForSpin(mtx_t* mutex) {
+  int state;
+
+  /*
+  * Only attempt the exchange once the mutex appears unlocked, so that
+  * spinning keeps the cache line in a shared state.
+  */
+  if (atomic_load_explicit(&mutex->state_, memory_order_relaxed)
+      != kMutexUnlocked) {
+    return 0;
+  }
+
+  state = kMutexUnlocked;
+  return atomic_compare_exchange_strong_explicit(
+      &mutex->state_,
+      &state,
+      kMutexLocked,
+      memory_order_acquire,
+      memory_order_relaxed
+  );
+}
+
+static int LockUntil(mtx_t* mutex, const struct timespec* time_point) {
+  int is_recursive;
+  int thread_id;
+  int state;
+  int lock_result;
+
+  is_recursive = (mutex->type_ & mtx_recursive) == mtx_recursive;
+
+  if (is_recursive) {
+    thread_id = Mdc_Futex_GetThreadId();
+
+    if (atomic_load_explicit(&mutex->owner_, memory_order_relaxed)
+        == thread_id) {
+      mutex->recursion_count_ += 1;
+      return thrd_success;
+    }
+  }
+
+  state = kMutexUnlocked;
+  if (!atomic_compare_exchange_strong_explicit(
+      &mutex->state_,
+      &state,
+      kMutexLocked,
+      memory_order_acquire,
+      memory_order_relaxed
+  ) && !((mutex->type_ & mtx_adaptive) == mtx_adaptive
+      && SpinLock(mutex, &TryLockForSpin))) {
+    lock_result = LockContended(mutex, state, time_point);
+    if (lock_result != thrd_success) {
+      return lock_result;
+    }
+  }
+
+  if (is_recursive) {
+    atomic_store_explicit(&mutex->owner_, thread_id, memory_order_relaxed);
+    mutex->recursion_count_ = 1;
+  }
+
+  return thrd_success;
+}
+
+int Mdc_Mutex_LockContended(mtx_t* mutex) {
+  int lock_result;
+
+  /* Passing an uncontended state forces the state word to 2. */
+  lock_result = LockContended(mutex, kMutexLocked, NULL);
+  if (lock_result != thrd_success) {
+    return lock_result;
+  }
+
+  if ((mutex->type_ & mtx_recursive) == mtx_recursive) {
+    atomic_store_explicit(
+        &mutex->owner_,
+        Mdc_Futex_GetThreadId(),
+        memory_order_relaxed
+    );
+    mutex->recursion_count_ = 1;
+  }
+
+  Mdc_Mutex_ProfileRelock(mutex);
+
+  return thrd_success;
+}
+
+int mtx_init(mtx_t* mutex, int type) {
+  if (!IsValidMutexType(type)) {
+    return thrd_error;
+  }
+
+  mutex->state_ = kMutexUnlocked;
+  mutex->type_ = type;
+
+  mutex->owner_ = 0;
+  mutex->recursion_count_ = 0;
+  mutex->spin_count_ = 0;
+
+  return thrd_success;
+}
+
+static void DestroyMutex(mtx_t* mutex) {
+  /* The futex word holds no kernel resources. */
+  (void) mutex;
+}
+
+static int LockMutex(mtx_t* mutex) {
+  return LockUntil(mutex, NULL);
+}
+
+static int TimedLockMutex(
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
+  if (!IsTimedMutex(mutex)) {
+    return thrd_error;
+  }
+
+  return LockUntil(mutex, time_point);
+}
+
+static int TryLockMutex(mtx_t* mutex) {
+  int is_recursive;
+  int thread_id;
+  int state;
+
+  is_recursive = (mutex->type_ & mtx_recursive) == mtx_recursive;
+
+  if (is_recursive) {
+    thread_id = Mdc_Futex_GetThreadId();
+
+    if (atomic_load_explicit(&mutex->owner_, memory_order_relaxed)
+        == thread_id) {
+      mutex->recursion_count_ += 1;
+      return thrd_success;
+    }
+  }
+
+  state = kMutexUnlocked;
+  if (!atomic_compare_exchange_strong_explicit(
+      &mutex->state_,
+      &state,
+      kMutexLocked,
+      memory_order_acquire,
+      memory_order_relaxed
+  )) {
+    return thrd_busy;
+  }
+
+  if (is_recursive) {
+    atomic_store_explicit(&mutex->owner_, thread_id, memory_order_relaxed);
+    mutex->recursion_count_ = 1;
+  }
+
+  return thrd_success;
+}
+
+static int UnlockMutex(mtx_t* mutex) {
+  int state;
+
+  if ((mutex->type_ & mtx_recursive) == mtx_recursive) {
+    if (atomic_load_explicit(&mutex->owner_, memory_order_relaxed)
+        != Mdc_Futex_GetThreadId()) {
+      return thrd_error;
+    }
+
+    mutex->recursion_count_ -= 1;
+    if (mutex->recursion_count_ > 0) {
+      return thrd_success;
+    }
+
+    atomic_store_explicit(&mutex->owner_, 0, memory_order_relaxed);
+  }
+
+  state = (int) atomic_exchange_explicit(
+      &mutex->state_,
+      kMutexUnlocked,
+      memory_order_release
+  );
+
+  if (state == kMutexLockedContended) {
+    Mdc_Futex_Wake(&mutex->state_, 1);
+  }
+
+  return thrd_success;
+}
+
 #elif defined(__GNUC__)
 
 #include <errno.h>
 
-/* TODO (Mir Drualga): In Linux, if an error occurs, define _GNU_SOURCE */
+/* pthread mutexes of every type support timed locking. */
+static int IsTimedMutex(const mtx_t* mutex) {
+  (void) mutex;
+
+  return 1;
+}
 
 int mtx_init(mtx_t* mutex, int type) {
   int init_attr_result;
@@ -151,6 +563,10 @@ int mtx_init(mtx_t* mutex, int type) {
   int mutex_attr_type;
   pthread_mutexattr_t attr;
 
+  if (!IsValidMutexType(type)) {
+    goto return_bad;
+  }
+
   init_attr_result = pthread_mutexattr_init(&attr);
   if (init_attr_result != 0) {
     goto return_bad;
@@ -158,6 +574,14 @@ int mtx_init(mtx_t* mutex, int type) {
 
   if ((type & mtx_recursive) == mtx_recursive) {
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+#if defined(PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP)
+  } else if ((type & mtx_adaptive) == mtx_adaptive) {
+    /*
+    * glibc's adaptive mutex already spins with a learned budget
+    * before it sleeps.
+    */
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#endif
   } else {
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_DEFAULT);
   }
@@ -178,11 +602,11 @@ return_bad:
   return thrd_error;
 }
 
-void mtx_destroy(mtx_t* mutex) {
+static void DestroyMutex(mtx_t* mutex) {
   pthread_mutex_destroy(mutex);
 }
 
-int mtx_lock(mtx_t* mutex) {
+static int LockMutex(mtx_t* mutex) {
   int result;
 
   result = pthread_mutex_lock(mutex);
@@ -190,10 +614,27 @@ int mtx_lock(mtx_t* mutex) {
   return (result == 0) ? thrd_success : thrd_error;
 }
 
-int mtx_trylock(mtx_t *mutex) {
+static int TimedLockMutex(
+    mtx_t* mutex,
+    const struct timespec* time_point
+) {
   int result;
 
-  result = pthread_mutex_lock(mutex);
+  result = pthread_mutex_timedlock(mutex, time_point);
+
+  if (result == 0) {
+    return thrd_success;
+  } else if (result == ETIMEDOUT) {
+    return thrd_timedout;
+  } else {
+    return thrd_error;
+  }
+}
+
+static int TryLockMutex(mtx_t* mutex) {
+  int result;
+
+  result = pthread_mutex_trylock(mutex);
 
   if (result == 0) {
     return thrd_success;
@@ -204,7 +645,7 @@ int mtx_trylock(mtx_t *mutex) {
   }
 }
 
-int mtx_unlock(mtx_t *mutex) {
+static int UnlockMutex(mtx_t* mutex) {
   int result;
 
   result = pthread_mutex_unlock(mutex);
@@ -214,4 +655,114 @@ int mtx_unlock(mtx_t *mutex) {
 
 #endif
 
+/*
+* The public functions add the hooks of Mdc_Mtx_RegisterProfile to
+* each implementation. While profiling is disabled, finding a mutex's
+* profile takes one atomic load.
+*/
+
+static int LockProfiled(
+    mtx_t* mutex,
+    struct Mdc_MtxProfile* profile,
+    const struct timespec* time_point
+) {
+  uint64_t wait_start_time;
+  int lock_result;
+
+  /* Only an acquisition that has to wait needs to read the clock. */
+  if (TryLockMutex(mutex) == thrd_success) {
+    Mdc_MtxProfile_RecordLock(profile, 0, 0);
+    return thrd_success;
+  }
+
+  wait_start_time = Mdc_MonotonicClock_GetNanoseconds();
+
+  if (time_point == NULL) {
+    lock_result = LockMutex(mutex);
+  } else {
+    lock_result = TimedLockMutex(mutex, time_point);
+  }
+
+  if (lock_result == thrd_success) {
+    Mdc_MtxProfile_RecordLock(profile, 1, wait_start_time);
+  }
+
+  return lock_result;
+}
+
+void mtx_destroy(mtx_t* mutex) {
+  if (Mdc_MtxProfile_HasRegistered()) {
+    Mdc_Mtx_UnregisterProfile(mutex);
+  }
+
+  DestroyMutex(mutex);
+}
+
+int mtx_lock(mtx_t* mutex) {
+  struct Mdc_MtxProfile* profile;
+
+  profile = Mdc_MtxProfile_Find(mutex);
+  if (profile == NULL) {
+    return LockMutex(mutex);
+  }
+
+  return LockProfiled(mutex, profile, NULL);
+}
+
+int mtx_timedlock(mtx_t* mutex, const struct timespec* time_point) {
+  struct Mdc_MtxProfile* profile;
+
+  profile = Mdc_MtxProfile_Find(mutex);
+  if (profile == NULL) {
+    return TimedLockMutex(mutex, time_point);
+  }
+
+  if (!IsTimedMutex(mutex)) {
+    return thrd_error;
+  }
+
+  return LockProfiled(mutex, profile, time_point);
+}
+
+int mtx_trylock(mtx_t* mutex) {
+  struct Mdc_MtxProfile* profile;
+  int trylock_result;
+
+  trylock_result = TryLockMutex(mutex);
+  if (trylock_result != thrd_success) {
+    return trylock_result;
+  }
+
+  profile = Mdc_MtxProfile_Find(mutex);
+  if (profile != NULL) {
+    Mdc_MtxProfile_RecordLock(profile, 0, 0);
+  }
+
+  return thrd_success;
+}
+
+int mtx_unlock(mtx_t* mutex) {
+  Mdc_Mutex_ProfileUnlock(mutex);
+
+  return UnlockMutex(mutex);
+}
+
+void Mdc_Mutex_ProfileUnlock(mtx_t* mutex) {
+  struct Mdc_MtxProfile* profile;
+
+  profile = Mdc_MtxProfile_Find(mutex);
+  if (profile != NULL) {
+    Mdc_MtxProfile_RecordUnlock(profile);
+  }
+}
+
+void Mdc_Mutex_ProfileRelock(mtx_t* mutex) {
+  struct Mdc_MtxProfile* profile;
+
+  profile = Mdc_MtxProfile_Find(mutex);
+  if (profile != NULL) {
+    Mdc_MtxProfile_RecordLock(profile, 0, 0);
+  }
+}
+
 #endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__) */
@@ -0,0 +1,69 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_C_STD_THREADS_MUTEX_H_
+#define MDC_C_STD_THREADS_MUTEX_H_
+
+#include "../../../../include/mdc/std/threads.h"
+
+#if __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__)
+
+/**
+ * Records, for a mutex registered with Mdc_Mtx_RegisterProfile, that
+ * the calling thread is about to release it. A condition variable
+ * must call this if it releases the mutex without mtx_unlock.
+ */
+void Mdc_Mutex_ProfileUnlock(mtx_t* mutex);
+
+/**
+ * Records, for a mutex registered with Mdc_Mtx_RegisterProfile, that
+ * the calling thread has locked it again after waiting on a condition
+ * variable without mtx_lock. The relock counts as an uncontended
+ * acquisition.
+ */
+void Mdc_Mutex_ProfileRelock(mtx_t* mutex);
+
+#if defined(__linux__) && defined(MDC_C_FUTEX_THREADS)
+
+/**
+ * Blocks until the mutex is locked, and leaves it marked as
+ * contended. A thread that waited on a condition variable must lock
+ * its mutex this way, because a broadcast may have requeued other
+ * waiters onto the mutex's futex word, and only a contended unlock
+ * wakes them.
+ *
+ * @return thrd_success on success, or thrd_error on failure
+ */
+int Mdc_Mutex_LockContended(mtx_t* mutex);
+
+#endif /* defined(__linux__) && defined(MDC_C_FUTEX_THREADS) */
+
+#endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__) */
+
+#endif /* MDC_C_STD_THREADS_MUTEX_H_ */
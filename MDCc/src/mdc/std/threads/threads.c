@@ -35,62 +35,58 @@
 
 #include <process.h>
 
-#include "../../../../include/mdc/malloc/malloc.h"
+#include "../../../../include/mdc/concurrency/thrd.h"
+#include "tss.h"
 
-struct ThreadArgsWrapper {
-  thrd_start_t func_;
-  void* arg_;
-};
-
-static unsigned int __stdcall RunThreadFuncShim(void* arg_wrapper) {
-  struct ThreadArgsWrapper args_wrapper_copy;
-  int result;
-
-  args_wrapper_copy = *(struct ThreadArgsWrapper*) arg_wrapper;
-  Mdc_free(arg_wrapper);
+int thrd_create(thrd_t* thr, thrd_start_t func, void* arg) {
+  return Mdc_Thrd_CreateEx(thr, func, arg, NULL);
+}
 
-  result = args_wrapper_copy.func_(args_wrapper_copy.arg_);
+int thrd_equal(thrd_t lhs, thrd_t rhs) {
+  /* TODO (Mir Duralga): This does not work if the pseudo-handle is used! */
+  return lhs == rhs;
+}
 
-  return result;
+thrd_t thrd_current(void) {
+  return GetCurrentThread();
 }
 
-int thrd_create(thrd_t* thrd, thrd_start_t func, void* arg) {
-  struct ThreadArgsWrapper* args_wrapper;
+int thrd_sleep(
+    const struct timespec* duration,
+    struct timespec* remaining
+) {
+  enum {
+    kMaxSleepSeconds = 24 * 60 * 60
+  };
 
-  args_wrapper = Mdc_malloc(sizeof(*args_wrapper));
+  time_t seconds;
+  DWORD milliseconds;
 
-  if (args_wrapper == NULL) {
-    return thrd_nomem;
+  if (duration->tv_sec < 0
+      || duration->tv_nsec < 0
+      || duration->tv_nsec >= 1000000000) {
+    return -2;
   }
 
-  args_wrapper->func_ = func;
-  args_wrapper->arg_ = arg;
-
-  *thrd = (HANDLE) _beginthreadex(
-      NULL,
-      0,
-      &RunThreadFuncShim,
-      args_wrapper,
-      0,
-      NULL
-  );
-
-  if (*thrd == NULL) {
-    Mdc_free(args_wrapper);
-
-    return thrd_error;
+  /* Split long sleeps so that the milliseconds never reach INFINITE. */
+  for (seconds = duration->tv_sec;
+      seconds > kMaxSleepSeconds;
+      seconds -= kMaxSleepSeconds) {
+    Sleep(kMaxSleepSeconds * 1000);
   }
 
-  return thrd_success;
-}
+  /* Round up, so that the sleep is never shorter than requested. */
+  milliseconds = (DWORD) seconds * 1000
+      + (DWORD) ((duration->tv_nsec + 999999) / 1000000);
+  Sleep(milliseconds);
 
-int thrd_equal(thrd_t lhs, thrd_t rhs) {
-  /* TODO (Mir Duralga): This does not work if the pseudo-handle is used! */
-  return lhs == rhs;
-}
+  /* Sleep cannot be interrupted, so no time ever remains. */
+  if (remaining != NULL) {
+    remaining->tv_sec = 0;
+    remaining->tv_nsec = 0;
+  }
 
-thrd_t thrd_current(void) {
-  return GetCurrentThread();
+  return 0;
 }
 
 void thrd_yield(void) {
@@ -98,6 +94,8 @@ void thrd_yield(void) {
 }
 
 void thrd_exit(int res) {
+  Mdc_Tss_RunDestructors();
+
   _endthreadex(res);
 }
 
@@ -128,11 +126,12 @@ int thrd_join(thrd_t thr, int *res) {
   }
 
   if (res != NULL) {
-    exit_code = *res;
     is_get_exit_code_success = GetExitCodeThread(thr, &exit_code);
     if (!is_get_exit_code_success) {
       goto return_bad;
     }
+
+    *res = (int) exit_code;
   }
 
   is_close_handle_success = CloseHandle(thr);
@@ -150,44 +149,13 @@ return_bad:
 
 #include <errno.h>
 #include <sched.h>
+#include <stddef.h>
+#include <time.h>
 
-#include "../../../../include/mdc/malloc/malloc.h"
-
-struct ThreadArgsWrapper {
-  thrd_start_t func_;
-  void* arg_;
-};
-
-static void* thrd_wrap_func(void* arg_wrapper) {
-  struct ThreadArgsWrapper args_wrapper_copy;
-
-  args_wrapper_copy = *(struct ThreadArgsWrapper*) arg_wrapper;
-  Mdc_free(arg_wrapper);
-
-  return (void*) args_wrapper_copy.func_(args_wrapper_copy.arg_);
-}
+#include "../../../../include/mdc/concurrency/thrd.h"
 
 int thrd_create(thrd_t* thr, thrd_start_t func, void* arg) {
-  struct ThreadArgsWrapper* arg_wrapper;
-  int result;
-
-  arg_wrapper = Mdc_malloc(sizeof(*arg_wrapper));
-  if (arg_wrapper == NULL) {
-    return ENOMEM;
-  }
-
-  arg_wrapper->func_ = func;
-  arg_wrapper->arg_ = arg;
-
-  result = pthread_create(thr, NULL, &thrd_wrap_func, arg_wrapper);
-
-  if (result == 0) {
-    return thrd_success;
-  } else if (result == ENOMEM) {
-    return thrd_nomem;
-  } else {
-    return thrd_error;
-  }
+  return Mdc_Thrd_CreateEx(thr, func, arg, NULL);
 }
 
 int thrd_equal(thrd_t lhs, thrd_t rhs) {
@@ -198,12 +166,23 @@ thrd_t thrd_current(void) {
   return pthread_self();
 }
 
+int thrd_sleep(
+    const struct timespec* duration,
+    struct timespec* remaining
+) {
+  if (nanosleep(duration, remaining) == 0) {
+    return 0;
+  }
+
+  return (errno == EINTR) ? -1 : -2;
+}
+
 void thrd_yield(void) {
   sched_yield();
 }
 
 void thrd_exit(int res) {
-  pthread_exit((void*) res);
+  pthread_exit((void*) (ptrdiff_t) res);
 }
 
 int thrd_detach(thrd_t thr) {
@@ -216,10 +195,22 @@ int thrd_detach(thrd_t thr) {
 
 int thrd_join(thrd_t thr, int *res) {
   int result;
+  void* thread_result;
+
+  /*
+  * The thread result is carried in a void*, which is wider than int
+  * on 64-bit platforms, so it cannot be written directly to res.
+  */
+  result = pthread_join(thr, &thread_result);
+  if (result != 0) {
+    return thrd_error;
+  }
 
-  result = pthread_join(thr, (void*) res);
+  if (res != NULL) {
+    *res = (int) (ptrdiff_t) thread_result;
+  }
 
-  return (result == 0) ? thrd_success : thrd_error;
+  return thrd_success;
 }
 
 #endif
@@ -0,0 +1,164 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "tss.h"
+
+#if __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__)
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+/*
+* TLS indices are limited to TLS_MINIMUM_AVAILABLE slots plus 1024
+* expansion slots, so the destructor of each index can be kept in a
+* fixed table.
+*/
+enum {
+  kMaxTssKeys = TLS_MINIMUM_AVAILABLE + 1024
+};
+
+static tss_dtor_t tss_dtors[kMaxTssKeys];
+
+int tss_create(tss_t* key, tss_dtor_t dtor) {
+  *key = TlsAlloc();
+  if (*key == TLS_OUT_OF_INDEXES) {
+    goto return_bad;
+  }
+
+  if (*key >= kMaxTssKeys) {
+    if (dtor != NULL) {
+      goto free_key;
+    }
+
+    return thrd_success;
+  }
+
+  tss_dtors[*key] = dtor;
+
+  return thrd_success;
+
+free_key:
+  TlsFree(*key);
+
+return_bad:
+  return thrd_error;
+}
+
+void tss_delete(tss_t key) {
+  if (key < kMaxTssKeys) {
+    tss_dtors[key] = NULL;
+  }
+
+  TlsFree(key);
+}
+
+void* tss_get(tss_t key) {
+  return TlsGetValue(key);
+}
+
+int tss_set(tss_t key, void* value) {
+  BOOL is_set_value_success;
+
+  is_set_value_success = TlsSetValue(key, value);
+
+  return is_set_value_success ? thrd_success : thrd_error;
+}
+
+void Mdc_Tss_RunDestructors(void) {
+  size_t i;
+  int iteration;
+  int has_called_dtor;
+  tss_dtor_t dtor;
+  void* value;
+
+  /*
+  * A destructor may set new values, so repeat until every value is
+  * cleared or the iteration limit is reached.
+  */
+  for (iteration = 0; iteration < TSS_DTOR_ITERATIONS; ++iteration) {
+    has_called_dtor = 0;
+
+    for (i = 0; i < kMaxTssKeys; ++i) {
+      dtor = tss_dtors[i];
+      if (dtor == NULL) {
+        continue;
+      }
+
+      value = TlsGetValue((DWORD) i);
+      if (value == NULL) {
+        continue;
+      }
+
+      TlsSetValue((DWORD) i, NULL);
+      dtor(value);
+      has_called_dtor = 1;
+    }
+
+    if (!has_called_dtor) {
+      break;
+    }
+  }
+}
+
+#elif defined(__GNUC__)
+
+#include <errno.h>
+
+int tss_create(tss_t* key, tss_dtor_t dtor) {
+  int result;
+
+  result = pthread_key_create(key, dtor);
+
+  if (result == 0) {
+    return thrd_success;
+  } else if (result == ENOMEM) {
+    return thrd_nomem;
+  } else {
+    return thrd_error;
+  }
+}
+
+void tss_delete(tss_t key) {
+  pthread_key_delete(key);
+}
+
+void* tss_get(tss_t key) {
+  return pthread_getspecific(key);
+}
+
+int tss_set(tss_t key, void* value) {
+  int result;
+
+  result = pthread_setspecific(key, value);
+
+  return (result == 0) ? thrd_success : thrd_error;
+}
+
+#endif
+
+#endif /* __STDC_VERSION__ < 201112L || defined(__STDC_NO_THREADS__) */
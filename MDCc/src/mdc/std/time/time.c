@@ -0,0 +1,89 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../../include/mdc/std/time.h"
+
+#if defined(MDC_INTERNAL_TIMESPEC_GET)
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+#include <windows.h>
+
+enum {
+  kNanosecondsPerFileTimeTick = 100,
+  kFileTimeTicksPerSecond = 10000000
+};
+
+int timespec_get(struct timespec* ts, int base) {
+  /* The FILETIME epoch starts 11644473600 seconds before Unix time. */
+  const ULONGLONG kUnixEpochFileTimeTicks =
+      (ULONGLONG) 116444736 * 100000000;
+
+  FILETIME file_time;
+  ULARGE_INTEGER file_time_ticks;
+  ULONGLONG unix_time_ticks;
+
+  if (base != TIME_UTC) {
+    return 0;
+  }
+
+  GetSystemTimeAsFileTime(&file_time);
+
+  file_time_ticks.LowPart = file_time.dwLowDateTime;
+  file_time_ticks.HighPart = file_time.dwHighDateTime;
+
+  unix_time_ticks = file_time_ticks.QuadPart - kUnixEpochFileTimeTicks;
+
+  ts->tv_sec = (time_t) (unix_time_ticks / kFileTimeTicksPerSecond);
+  ts->tv_nsec = (long) (unix_time_ticks % kFileTimeTicksPerSecond)
+      * kNanosecondsPerFileTimeTick;
+
+  return base;
+}
+
+#elif defined(__GNUC__)
+
+int timespec_get(struct timespec* ts, int base) {
+  int clock_gettime_result;
+
+  if (base != TIME_UTC) {
+    return 0;
+  }
+
+  clock_gettime_result = clock_gettime(CLOCK_REALTIME, ts);
+  if (clock_gettime_result != 0) {
+    return 0;
+  }
+
+  return base;
+}
+
+#endif
+
+#endif /* defined(MDC_INTERNAL_TIMESPEC_GET) */
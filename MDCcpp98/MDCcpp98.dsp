@@ -160,6 +160,26 @@ LINK32=link.exe
 # Begin Group "mdc_hpp"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency_hpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\adaptive_mutex.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\mcs_lock.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\mpmc_queue.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\concurrency\thread_pool.hpp
+# End Source File
+# End Group
 # Begin Group "error_hpp"
 
 # PROP Default_Filter ""
@@ -168,19 +188,51 @@ LINK32=link.exe
 SOURCE=.\include\mdc\error\exit_on_error.hpp
 # End Source File
 # End Group
+# Begin Group "malloc_hpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\include\mdc\malloc\arena.hpp
+# End Source File
+# End Group
 # Begin Group "std_hpp"
 
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\include\mdc\std\atomic.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\std\barrier.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\std\chrono.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\std\condition_variable.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\include\mdc\std\latch.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\std\mutex.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\include\mdc\std\semaphore.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\include\mdc\std\shared_mutex.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\include\mdc\std\threads.hpp
 # End Source File
 # End Group
@@ -204,6 +256,22 @@ SOURCE=.\include\mdc\wchar_t\wide_encoding.hpp
 # Begin Group "mdc_cpp"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency_cpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\adaptive_mutex.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\mcs_lock.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\concurrency\thread_pool.cpp
+# End Source File
+# End Group
 # Begin Group "error_cpp"
 
 # PROP Default_Filter ""
@@ -212,9 +280,25 @@ SOURCE=.\include\mdc\wchar_t\wide_encoding.hpp
 SOURCE=.\src\mdc\error\exit_on_error.cpp
 # End Source File
 # End Group
+# Begin Group "malloc_cpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\malloc\arena.cpp
+# End Source File
+# End Group
 # Begin Group "std_cpp"
 
 # PROP Default_Filter ""
+# Begin Group "chrono_cpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\std\chrono\chrono.cpp
+# End Source File
+# End Group
 # Begin Group "condition_variable_cpp"
 
 # PROP Default_Filter ""
@@ -227,6 +311,14 @@ SOURCE=.\src\mdc\std\condition_variable\condition_variable.cpp
 SOURCE=.\src\mdc\std\condition_variable\condition_variable_any.cpp
 # End Source File
 # End Group
+# Begin Group "latch_cpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\std\latch\latch.cpp
+# End Source File
+# End Group
 # Begin Group "mutex_cpp"
 
 # PROP Default_Filter ""
@@ -242,6 +334,26 @@ SOURCE=.\src\mdc\std\mutex\mutex.cpp
 
 SOURCE=.\src\mdc\std\mutex\recursive_mutex.cpp
 # End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\mutex\recursive_timed_mutex.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\mutex\timed_mutex.cpp
+# End Source File
+# End Group
+# Begin Group "shared_mutex_cpp"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\src\mdc\std\shared_mutex\shared_mutex.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\mdc\std\shared_mutex\shared_timed_mutex.cpp
+# End Source File
 # End Group
 # Begin Group "threads_cpp"
 
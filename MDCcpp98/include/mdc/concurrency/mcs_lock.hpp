@@ -0,0 +1,75 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_CONCURRENCY_MCS_LOCK_HPP_
+#define MDC_CPP98_CONCURRENCY_MCS_LOCK_HPP_
+
+#include <mdc/concurrency/mcs_lock.h>
+
+#include "../../../dllexport_define.inc"
+
+namespace mdc {
+
+/**
+ * A FIFO queue lock in which each waiter spins on its own cache line,
+ * backed by Mdc_McsLock. It scales better than std::mutex when many
+ * threads contend for short critical sections. It meets the Lockable
+ * requirements, so it works with std::lock_guard and std::unique_lock.
+ */
+class DLLEXPORT McsLock {
+ private:
+  typedef ::Mdc_McsLock native_type;
+
+ public:
+  typedef native_type* native_handle_type;
+
+  McsLock();
+
+  ~McsLock();
+
+  void lock();
+
+  bool try_lock();
+
+  void unlock();
+
+  native_handle_type native_handle();
+
+ private:
+  native_type lock_;
+
+  // Intentionally unimplemented to "delete" them.
+  McsLock(const McsLock&);
+  McsLock& operator=(const McsLock&);
+};
+
+} // namespace mdc
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_CPP98_CONCURRENCY_MCS_LOCK_HPP_ */
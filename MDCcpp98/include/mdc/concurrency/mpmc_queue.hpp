@@ -0,0 +1,192 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_CONCURRENCY_MPMC_QUEUE_HPP_
+#define MDC_CPP98_CONCURRENCY_MPMC_QUEUE_HPP_
+
+#include <stddef.h>
+
+#include <new>
+#include <stdexcept>
+
+#include <mdc/concurrency/mpmc_queue.h>
+#include <mdc/std/time.h>
+
+#include "../std/chrono.hpp"
+
+namespace mdc {
+
+/**
+ * A bounded, lock-free queue for any number of producers and
+ * consumers. See Mdc_MpmcQueue for the details. Elements are copied
+ * bytewise, so T must be a POD type.
+ */
+template <class T>
+class MpmcQueue {
+ public:
+  typedef T value_type;
+
+  /**
+   * Allocates space for at least the specified number of elements.
+   * Throws std::bad_alloc or std::runtime_error on failure.
+   */
+  explicit MpmcQueue(size_t capacity) {
+    int init_result = ::Mdc_MpmcQueue_Init(
+        &this->queue_,
+        sizeof(T),
+        capacity,
+        Mdc_MpmcQueue_kBlocking
+    );
+
+    if (init_result == thrd_nomem) {
+      throw ::std::bad_alloc();
+    }
+
+    if (init_result != thrd_success) {
+      throw ::std::runtime_error("::mdc::MpmcQueue::MpmcQueue failure");
+    }
+  }
+
+  ~MpmcQueue() {
+    ::Mdc_MpmcQueue_Deinit(&this->queue_);
+  }
+
+  bool TryPush(const T& value) {
+    return ::Mdc_MpmcQueue_TryPush(&this->queue_, &value) != 0;
+  }
+
+  bool TryPop(T& value) {
+    return ::Mdc_MpmcQueue_TryPop(&this->queue_, &value) != 0;
+  }
+
+  void Push(const T& value) {
+    int push_result = ::Mdc_MpmcQueue_Push(&this->queue_, &value);
+
+    if (push_result != thrd_success) {
+      throw ::std::runtime_error("::mdc::MpmcQueue::Push failure");
+    }
+  }
+
+  void Pop(T& value) {
+    int pop_result = ::Mdc_MpmcQueue_Pop(&this->queue_, &value);
+
+    if (pop_result != thrd_success) {
+      throw ::std::runtime_error("::mdc::MpmcQueue::Pop failure");
+    }
+  }
+
+  template <class Rep, class Period>
+  bool TryPushFor(
+      const T& value,
+      const ::std::chrono::duration<Rep, Period>& rel_time
+  ) {
+    return this->TryPushUntil(
+        value,
+        ::std::chrono::system_clock::now() + rel_time
+    );
+  }
+
+  template <class Clock, class Duration>
+  bool TryPushUntil(
+      const T& value,
+      const ::std::chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    ::timespec time_point = ::mdc::chrono_detail::ToTimespec(
+        ::std::chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+
+    int push_result = ::Mdc_MpmcQueue_TimedPush(
+        &this->queue_,
+        &value,
+        &time_point
+    );
+
+    if (push_result == thrd_timedout) {
+      return false;
+    }
+
+    if (push_result != thrd_success) {
+      throw ::std::runtime_error("::mdc::MpmcQueue::TryPushUntil failure");
+    }
+
+    return true;
+  }
+
+  template <class Rep, class Period>
+  bool TryPopFor(
+      T& value,
+      const ::std::chrono::duration<Rep, Period>& rel_time
+  ) {
+    return this->TryPopUntil(
+        value,
+        ::std::chrono::system_clock::now() + rel_time
+    );
+  }
+
+  template <class Clock, class Duration>
+  bool TryPopUntil(
+      T& value,
+      const ::std::chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    ::timespec time_point = ::mdc::chrono_detail::ToTimespec(
+        ::std::chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+
+    int pop_result = ::Mdc_MpmcQueue_TimedPop(
+        &this->queue_,
+        &value,
+        &time_point
+    );
+
+    if (pop_result == thrd_timedout) {
+      return false;
+    }
+
+    if (pop_result != thrd_success) {
+      throw ::std::runtime_error("::mdc::MpmcQueue::TryPopUntil failure");
+    }
+
+    return true;
+  }
+
+  size_t capacity() const throw() {
+    return ::Mdc_MpmcQueue_GetCapacity(&this->queue_);
+  }
+
+ private:
+  ::Mdc_MpmcQueue queue_;
+
+  // Intentionally unimplemented to "delete" them.
+  MpmcQueue(const MpmcQueue&);
+  MpmcQueue& operator=(const MpmcQueue&);
+};
+
+} // namespace mdc
+
+#endif /* MDC_CPP98_CONCURRENCY_MPMC_QUEUE_HPP_ */
@@ -0,0 +1,118 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_CONCURRENCY_THREAD_POOL_HPP_
+#define MDC_CPP98_CONCURRENCY_THREAD_POOL_HPP_
+
+#include <stddef.h>
+
+#include <exception>
+
+#include <mdc/concurrency/thread_pool.h>
+
+#include "../../../dllexport_define.inc"
+
+namespace mdc {
+
+/**
+ * A work-stealing thread pool. See Mdc_ThreadPool for the scheduling
+ * details. The destructor waits for every submitted task to finish.
+ *
+ * Tasks run inside the C worker loop and must not throw.
+ */
+class DLLEXPORT ThreadPool {
+ public:
+  typedef ::Mdc_ThreadPoolTask Task;
+
+  /**
+   * Starts the worker threads, using one worker per processor if the
+   * count is 0. Throws std::runtime_error on failure.
+   */
+  explicit ThreadPool(size_t workers_count = 0);
+
+  ~ThreadPool();
+
+  void Submit(void (*func)(void*), void* arg);
+
+  /**
+   * Submits a copy of the function object, which is called with no
+   * arguments. An exception that escapes the function object
+   * terminates the program.
+   */
+  template <class Func>
+  void Submit(Func func) {
+    FuncHolder<Func>* holder = new FuncHolder<Func>(func);
+
+    try {
+      this->Submit(&FuncHolder<Func>::Run, holder);
+    } catch (...) {
+      delete holder;
+      throw;
+    }
+  }
+
+  void SubmitBatch(const Task* tasks, size_t count);
+
+  void WaitIdle();
+
+  size_t workers_count() const throw();
+
+ private:
+  template <class Func>
+  struct FuncHolder {
+    explicit FuncHolder(const Func& func) : func(func) {
+    }
+
+    static void Run(void* arg) {
+      FuncHolder* holder = static_cast<FuncHolder*>(arg);
+
+      // Unwinding through the C worker loop is undefined behavior.
+      try {
+        holder->func();
+      } catch (...) {
+        ::std::terminate();
+      }
+
+      delete holder;
+    }
+
+    Func func;
+  };
+
+  ::Mdc_ThreadPool pool_;
+
+  // Intentionally unimplemented to "delete" them.
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator=(const ThreadPool&);
+};
+
+} // namespace mdc
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_CPP98_CONCURRENCY_THREAD_POOL_HPP_ */
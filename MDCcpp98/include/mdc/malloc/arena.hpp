@@ -0,0 +1,185 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_MALLOC_ARENA_HPP_
+#define MDC_CPP98_MALLOC_ARENA_HPP_
+
+#include <stddef.h>
+
+#include <new>
+
+#include <mdc/malloc/arena.h>
+
+#include "../../../dllexport_define.inc"
+
+namespace mdc {
+
+/**
+ * A bump-pointer region allocator, backed by Mdc_Arena. Memory is
+ * released in bulk by rewinding to a mark or resetting, and objects
+ * placed in it are never destroyed by the arena.
+ */
+class DLLEXPORT Arena {
+ private:
+  typedef ::Mdc_Arena native_type;
+
+ public:
+  typedef native_type* native_handle_type;
+  typedef ::Mdc_ArenaMark mark_type;
+
+  /**
+   * Creates an arena whose blocks have the specified usable size, or
+   * the default size if 0.
+   */
+  explicit Arena(size_t block_size = 0);
+
+  ~Arena();
+
+  /**
+   * Allocates memory that is suitably aligned for any type. Throws
+   * std::bad_alloc on failure.
+   */
+  void* Allocate(size_t size);
+
+  /**
+   * Allocates memory with the specified power of two alignment. Throws
+   * std::bad_alloc on failure.
+   */
+  void* AllocateAligned(size_t size, size_t alignment);
+
+  mark_type GetMark() const;
+
+  void Rewind(const mark_type& mark);
+
+  void Reset();
+
+  native_handle_type native_handle();
+
+ private:
+  native_type arena_;
+
+  // Intentionally unimplemented to "delete" them.
+  Arena(const Arena&);
+  Arena& operator=(const Arena&);
+};
+
+/**
+ * An allocator that meets the C++98 Allocator requirements by
+ * allocating from an Arena. Deallocation does nothing, so containers
+ * that use it should be discarded before the arena is rewound or
+ * reset. Copies and rebound copies allocate from the same arena.
+ */
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  explicit ArenaAllocator(Arena& arena) throw()
+      : arena_(&arena) {
+  }
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) throw()
+      : arena_(other.arena()) {
+  }
+
+  Arena* arena() const throw() {
+    return this->arena_;
+  }
+
+  pointer address(reference value) const {
+    return &value;
+  }
+
+  const_pointer address(const_reference value) const {
+    return &value;
+  }
+
+  pointer allocate(size_type n, const void* hint = NULL) {
+    (void) hint;
+
+    if (n > this->max_size()) {
+      throw ::std::bad_alloc();
+    }
+
+    return static_cast<pointer>(this->arena_->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(pointer p, size_type n) {
+    (void) p;
+    (void) n;
+  }
+
+  size_type max_size() const throw() {
+    return static_cast<size_type>(-1) / sizeof(T);
+  }
+
+  void construct(pointer p, const T& value) {
+    new (static_cast<void*>(p)) T(value);
+  }
+
+  void destroy(pointer p) {
+    p->~T();
+  }
+
+ private:
+  Arena* arena_;
+};
+
+template <class T, class U>
+inline bool operator==(
+    const ArenaAllocator<T>& lhs,
+    const ArenaAllocator<U>& rhs
+) throw() {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+inline bool operator!=(
+    const ArenaAllocator<T>& lhs,
+    const ArenaAllocator<U>& rhs
+) throw() {
+  return lhs.arena() != rhs.arena();
+}
+
+} // namespace mdc
+
+#include "../../../dllexport_undefine.inc"
+#endif /* MDC_CPP98_MALLOC_ARENA_HPP_ */
@@ -0,0 +1,577 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_ATOMIC_HPP_
+#define MDC_CPP98_STD_ATOMIC_HPP_
+
+#if __cplusplus >= 201103L || _MSVC_LANG >= 201103L
+
+#include <atomic>
+
+#else
+
+#include <stddef.h>
+
+#include <mdc/std/stdatomic.h>
+#include <mdc/std/stdint.h>
+
+namespace std {
+
+/**
+ * Order and consistency
+ */
+
+enum memory_order {
+  memory_order_relaxed = ::Mdc_MemoryOrder_kRelaxed,
+  memory_order_consume = ::Mdc_MemoryOrder_kConsume,
+  memory_order_acquire = ::Mdc_MemoryOrder_kAcquire,
+  memory_order_release = ::Mdc_MemoryOrder_kRelease,
+  memory_order_acq_rel = ::Mdc_MemoryOrder_kAcqRel,
+  memory_order_seq_cst = ::Mdc_MemoryOrder_kSeqCst
+};
+
+/**
+ * Atomic types. The operations are the C atomic operations, so on
+ * MSVC only 32-bit and, on x64, 64-bit integers and pointers are
+ * supported.
+ */
+
+template <class T>
+class atomic {
+ public:
+  typedef T value_type;
+
+  atomic() throw() {
+  }
+
+  atomic(T desired) throw()
+      : value_(desired) {
+  }
+
+  T operator=(T desired) throw() {
+    this->store(desired);
+    return desired;
+  }
+
+  bool is_lock_free() const throw() {
+    return true;
+  }
+
+  void store(T desired, memory_order order = memory_order_seq_cst) throw() {
+    MDC_ATOMIC_STORE_EXPLICIT(&this->value_, desired, order);
+  }
+
+  T load(memory_order order = memory_order_seq_cst) const throw() {
+    return (T) MDC_ATOMIC_LOAD_EXPLICIT(&this->value_, order);
+  }
+
+  operator T() const throw() {
+    return this->load();
+  }
+
+  T exchange(T desired, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_EXCHANGE_EXPLICIT(&this->value_, desired, order);
+  }
+
+  bool compare_exchange_weak(
+      T& expected,
+      T desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    return MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(
+        &this->value_,
+        &expected,
+        desired,
+        success,
+        failure
+    ) != 0;
+  }
+
+  bool compare_exchange_weak(
+      T& expected,
+      T desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_weak(
+        expected,
+        desired,
+        order,
+        ToFailureOrder(order)
+    );
+  }
+
+  bool compare_exchange_strong(
+      T& expected,
+      T desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    return MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(
+        &this->value_,
+        &expected,
+        desired,
+        success,
+        failure
+    ) != 0;
+  }
+
+  bool compare_exchange_strong(
+      T& expected,
+      T desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_strong(
+        expected,
+        desired,
+        order,
+        ToFailureOrder(order)
+    );
+  }
+
+  T fetch_add(T arg, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_FETCH_ADD_EXPLICIT(&this->value_, arg, order);
+  }
+
+  T fetch_sub(T arg, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_FETCH_SUB_EXPLICIT(&this->value_, arg, order);
+  }
+
+  T fetch_and(T arg, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_FETCH_AND_EXPLICIT(&this->value_, arg, order);
+  }
+
+  T fetch_or(T arg, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_FETCH_OR_EXPLICIT(&this->value_, arg, order);
+  }
+
+  T fetch_xor(T arg, memory_order order = memory_order_seq_cst) throw() {
+    return (T) MDC_ATOMIC_FETCH_XOR_EXPLICIT(&this->value_, arg, order);
+  }
+
+  T operator++() throw() {
+    return this->fetch_add(1) + 1;
+  }
+
+  T operator++(int) throw() {
+    return this->fetch_add(1);
+  }
+
+  T operator--() throw() {
+    return this->fetch_sub(1) - 1;
+  }
+
+  T operator--(int) throw() {
+    return this->fetch_sub(1);
+  }
+
+  T operator+=(T arg) throw() {
+    return this->fetch_add(arg) + arg;
+  }
+
+  T operator-=(T arg) throw() {
+    return this->fetch_sub(arg) - arg;
+  }
+
+  T operator&=(T arg) throw() {
+    return this->fetch_and(arg) & arg;
+  }
+
+  T operator|=(T arg) throw() {
+    return this->fetch_or(arg) | arg;
+  }
+
+  T operator^=(T arg) throw() {
+    return this->fetch_xor(arg) ^ arg;
+  }
+
+ private:
+  volatile T value_;
+
+  static memory_order ToFailureOrder(memory_order order) throw() {
+    switch (order) {
+      case memory_order_acq_rel: {
+        return memory_order_acquire;
+      }
+
+      case memory_order_release: {
+        return memory_order_relaxed;
+      }
+
+      default: {
+        return order;
+      }
+    }
+  }
+
+  // Intentionally unimplemented to "delete" them.
+  atomic(const atomic&);
+  atomic& operator=(const atomic&);
+};
+
+template <class T>
+class atomic<T*> {
+ public:
+  typedef T* value_type;
+
+  atomic() throw() {
+  }
+
+  atomic(T* desired) throw()
+      : value_(desired) {
+  }
+
+  T* operator=(T* desired) throw() {
+    this->store(desired);
+    return desired;
+  }
+
+  bool is_lock_free() const throw() {
+    return true;
+  }
+
+  void store(T* desired, memory_order order = memory_order_seq_cst) throw() {
+    MDC_ATOMIC_STORE_EXPLICIT(&this->value_, desired, order);
+  }
+
+  T* load(memory_order order = memory_order_seq_cst) const throw() {
+    return (T*) MDC_ATOMIC_LOAD_EXPLICIT(&this->value_, order);
+  }
+
+  operator T*() const throw() {
+    return this->load();
+  }
+
+  T* exchange(T* desired, memory_order order = memory_order_seq_cst) throw() {
+    return (T*) MDC_ATOMIC_EXCHANGE_EXPLICIT(&this->value_, desired, order);
+  }
+
+  bool compare_exchange_weak(
+      T*& expected,
+      T* desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    return MDC_ATOMIC_COMPARE_EXCHANGE_WEAK_EXPLICIT(
+        &this->value_,
+        &expected,
+        desired,
+        success,
+        failure
+    ) != 0;
+  }
+
+  bool compare_exchange_weak(
+      T*& expected,
+      T* desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_weak(
+        expected,
+        desired,
+        order,
+        ToFailureOrder(order)
+    );
+  }
+
+  bool compare_exchange_strong(
+      T*& expected,
+      T* desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    return MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(
+        &this->value_,
+        &expected,
+        desired,
+        success,
+        failure
+    ) != 0;
+  }
+
+  bool compare_exchange_strong(
+      T*& expected,
+      T* desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_strong(
+        expected,
+        desired,
+        order,
+        ToFailureOrder(order)
+    );
+  }
+
+  /*
+  * The C atomic operations add bytes to pointers, so the offsets are
+  * scaled here.
+  */
+
+  T* fetch_add(
+      ptrdiff_t arg,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return (T*) MDC_ATOMIC_FETCH_ADD_EXPLICIT(
+        &this->value_,
+        arg * static_cast<ptrdiff_t>(sizeof(T)),
+        order
+    );
+  }
+
+  T* fetch_sub(
+      ptrdiff_t arg,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return (T*) MDC_ATOMIC_FETCH_SUB_EXPLICIT(
+        &this->value_,
+        arg * static_cast<ptrdiff_t>(sizeof(T)),
+        order
+    );
+  }
+
+  T* operator++() throw() {
+    return this->fetch_add(1) + 1;
+  }
+
+  T* operator++(int) throw() {
+    return this->fetch_add(1);
+  }
+
+  T* operator--() throw() {
+    return this->fetch_sub(1) - 1;
+  }
+
+  T* operator--(int) throw() {
+    return this->fetch_sub(1);
+  }
+
+  T* operator+=(ptrdiff_t arg) throw() {
+    return this->fetch_add(arg) + arg;
+  }
+
+  T* operator-=(ptrdiff_t arg) throw() {
+    return this->fetch_sub(arg) - arg;
+  }
+
+ private:
+  T* volatile value_;
+
+  static memory_order ToFailureOrder(memory_order order) throw() {
+    switch (order) {
+      case memory_order_acq_rel: {
+        return memory_order_acquire;
+      }
+
+      case memory_order_release: {
+        return memory_order_relaxed;
+      }
+
+      default: {
+        return order;
+      }
+    }
+  }
+
+  // Intentionally unimplemented to "delete" them.
+  atomic(const atomic&);
+  atomic& operator=(const atomic&);
+};
+
+/*
+* bool is stored as an int, because MSVC has no interlocked functions
+* for single bytes.
+*/
+template <>
+class atomic<bool> {
+ public:
+  typedef bool value_type;
+
+  atomic() throw() {
+  }
+
+  atomic(bool desired) throw()
+      : value_(desired) {
+  }
+
+  bool operator=(bool desired) throw() {
+    this->store(desired);
+    return desired;
+  }
+
+  bool is_lock_free() const throw() {
+    return true;
+  }
+
+  void store(
+      bool desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    MDC_ATOMIC_STORE_EXPLICIT(&this->value_, desired, order);
+  }
+
+  bool load(memory_order order = memory_order_seq_cst) const throw() {
+    return MDC_ATOMIC_LOAD_EXPLICIT(&this->value_, order) != 0;
+  }
+
+  operator bool() const throw() {
+    return this->load();
+  }
+
+  bool exchange(
+      bool desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return MDC_ATOMIC_EXCHANGE_EXPLICIT(&this->value_, desired, order) != 0;
+  }
+
+  bool compare_exchange_weak(
+      bool& expected,
+      bool desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    return this->compare_exchange_strong(
+        expected,
+        desired,
+        success,
+        failure
+    );
+  }
+
+  bool compare_exchange_weak(
+      bool& expected,
+      bool desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_strong(expected, desired, order);
+  }
+
+  bool compare_exchange_strong(
+      bool& expected,
+      bool desired,
+      memory_order success,
+      memory_order failure
+  ) throw() {
+    int expected_value = expected;
+
+    bool is_exchanged = MDC_ATOMIC_COMPARE_EXCHANGE_STRONG_EXPLICIT(
+        &this->value_,
+        &expected_value,
+        static_cast<int>(desired),
+        success,
+        failure
+    ) != 0;
+
+    expected = (expected_value != 0);
+    return is_exchanged;
+  }
+
+  bool compare_exchange_strong(
+      bool& expected,
+      bool desired,
+      memory_order order = memory_order_seq_cst
+  ) throw() {
+    return this->compare_exchange_strong(
+        expected,
+        desired,
+        order,
+        ToFailureOrder(order)
+    );
+  }
+
+ private:
+  volatile int value_;
+
+  static memory_order ToFailureOrder(memory_order order) throw() {
+    switch (order) {
+      case memory_order_acq_rel: {
+        return memory_order_acquire;
+      }
+
+      case memory_order_release: {
+        return memory_order_relaxed;
+      }
+
+      default: {
+        return order;
+      }
+    }
+  }
+
+  // Intentionally unimplemented to "delete" them.
+  atomic(const atomic&);
+  atomic& operator=(const atomic&);
+};
+
+typedef atomic<bool> atomic_bool;
+typedef atomic<int> atomic_int;
+typedef atomic<unsigned int> atomic_uint;
+typedef atomic<long> atomic_long;
+typedef atomic<unsigned long> atomic_ulong;
+typedef atomic< ::intptr_t> atomic_intptr_t;
+typedef atomic< ::uintptr_t> atomic_uintptr_t;
+typedef atomic<size_t> atomic_size_t;
+typedef atomic<ptrdiff_t> atomic_ptrdiff_t;
+
+/**
+ * Flag type and operations
+ */
+
+// An aggregate, so that it can be initialized with ATOMIC_FLAG_INIT.
+struct atomic_flag {
+  bool test_and_set(memory_order order = memory_order_seq_cst) throw() {
+    return MDC_ATOMIC_FLAG_TEST_AND_SET_EXPLICIT(&this->flag_, order) != 0;
+  }
+
+  void clear(memory_order order = memory_order_seq_cst) throw() {
+    MDC_ATOMIC_FLAG_CLEAR_EXPLICIT(&this->flag_, order);
+  }
+
+  ::Mdc_AtomicFlag flag_;
+};
+
+/**
+ * Fences
+ */
+
+inline void atomic_thread_fence(memory_order order) throw() {
+  ::Mdc_Atomic_ThreadFence(static_cast< ::Mdc_MemoryOrder>(order));
+}
+
+inline void atomic_signal_fence(memory_order order) throw() {
+  ::Mdc_Atomic_SignalFence(static_cast< ::Mdc_MemoryOrder>(order));
+}
+
+} // namespace std
+
+#define ATOMIC_FLAG_INIT MDC_ATOMIC_FLAG_INIT
+
+#endif // __cplusplus >= 201103L || _MSVC_LANG >= 201103L
+
+#endif /* MDC_CPP98_STD_ATOMIC_HPP_ */
@@ -0,0 +1,155 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_BARRIER_HPP_
+#define MDC_CPP98_STD_BARRIER_HPP_
+
+#if __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#include <barrier>
+
+#else
+
+#include <stddef.h>
+
+#include <stdexcept>
+
+#include <mdc/concurrency/barrier.h>
+
+namespace mdc {
+
+/**
+ * The default completion function of std::barrier, which does
+ * nothing.
+ */
+struct BarrierEmptyCompletion {
+  void operator()() throw() {
+  }
+};
+
+} // namespace mdc
+
+namespace std {
+
+/**
+ * Barriers
+ */
+
+template <class CompletionFunction = ::mdc::BarrierEmptyCompletion>
+class barrier {
+ public:
+  class arrival_token {
+   private:
+    friend class barrier;
+
+    int phase_;
+  };
+
+  static ptrdiff_t max() throw() {
+    return ::Mdc_Barrier_kMaxCount;
+  }
+
+  explicit barrier(
+      ptrdiff_t expected,
+      CompletionFunction f = CompletionFunction()
+  ) : completion_(f) {
+    int init_result = ::Mdc_Barrier_Init(
+        &this->barrier_,
+        static_cast<int>(expected),
+        &RunCompletion,
+        this
+    );
+
+    if (init_result != thrd_success) {
+      throw ::std::runtime_error("::std::barrier::barrier failure");
+    }
+  }
+
+  ~barrier() {
+    ::Mdc_Barrier_Deinit(&this->barrier_);
+  }
+
+  arrival_token arrive(ptrdiff_t update = 1) {
+    arrival_token arrival;
+
+    int arrive_result = ::Mdc_Barrier_Arrive(
+        &this->barrier_,
+        static_cast<int>(update),
+        &arrival.phase_
+    );
+
+    if (arrive_result != thrd_success) {
+      throw ::std::runtime_error("::std::barrier::arrive failure");
+    }
+
+    return arrival;
+  }
+
+  void wait(const arrival_token& arrival) const {
+    int wait_result = ::Mdc_Barrier_Wait(&this->barrier_, arrival.phase_);
+
+    if (wait_result != thrd_success) {
+      throw ::std::runtime_error("::std::barrier::wait failure");
+    }
+  }
+
+  void arrive_and_wait() {
+    int arrive_and_wait_result = ::Mdc_Barrier_ArriveAndWait(&this->barrier_);
+
+    if (arrive_and_wait_result != thrd_success) {
+      throw ::std::runtime_error("::std::barrier::arrive_and_wait failure");
+    }
+  }
+
+  void arrive_and_drop() {
+    int arrive_and_drop_result = ::Mdc_Barrier_ArriveAndDrop(&this->barrier_);
+
+    if (arrive_and_drop_result != thrd_success) {
+      throw ::std::runtime_error("::std::barrier::arrive_and_drop failure");
+    }
+  }
+
+ private:
+  mutable ::Mdc_Barrier barrier_;
+  CompletionFunction completion_;
+
+  static void RunCompletion(void* context) {
+    static_cast<barrier*>(context)->completion_();
+  }
+
+  // Intentionally unimplemented to "delete" them.
+  barrier(const barrier&);
+  barrier& operator=(const barrier&);
+};
+
+} // namespace std
+
+#endif // __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#endif /* MDC_CPP98_STD_BARRIER_HPP_ */
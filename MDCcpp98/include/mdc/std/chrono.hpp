@@ -0,0 +1,518 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_CHRONO_HPP_
+#define MDC_CPP98_STD_CHRONO_HPP_
+
+#if __cplusplus >= 201103L || _MSVC_LANG >= 201103L
+
+#include <chrono>
+#include <ratio>
+
+#else
+
+#include <time.h>
+
+#include "../../../dllexport_define.inc"
+
+namespace std {
+
+/**
+ * Compile-time rational constants
+ */
+
+template <long Num, long Denom = 1>
+class ratio {
+ public:
+  static const long num = Num;
+  static const long den = Denom;
+};
+
+typedef ratio<1, 1000000000> nano;
+typedef ratio<1, 1000000> micro;
+typedef ratio<1, 1000> milli;
+
+namespace chrono {
+
+/**
+ * Durations
+ */
+
+#if defined(_MSC_VER)
+typedef __int64 duration_rep_type;
+#else
+typedef long long duration_rep_type;
+#endif
+
+template <class Rep, class Period = ratio<1> >
+class duration;
+
+typedef duration<duration_rep_type, nano> nanoseconds;
+typedef duration<duration_rep_type, micro> microseconds;
+typedef duration<duration_rep_type, milli> milliseconds;
+typedef duration<duration_rep_type> seconds;
+typedef duration<duration_rep_type, ratio<60> > minutes;
+typedef duration<duration_rep_type, ratio<3600> > hours;
+
+template <class ToDuration, class Rep, class Period>
+ToDuration duration_cast(const duration<Rep, Period>& d) {
+  typedef typename ToDuration::rep to_rep;
+  typedef typename ToDuration::period to_period;
+
+  // Multiply first to keep precision, all standard periods are exact.
+  duration_rep_type numerator =
+      static_cast<duration_rep_type>(Period::num) * to_period::den;
+  duration_rep_type denominator =
+      static_cast<duration_rep_type>(Period::den) * to_period::num;
+
+  return ToDuration(static_cast<to_rep>(
+      static_cast<duration_rep_type>(d.count()) * numerator / denominator
+  ));
+}
+
+/**
+ * Unlike C++11, conversions between durations are always implicit,
+ * even when they truncate.
+ */
+template <class Rep, class Period>
+class duration {
+ public:
+  typedef Rep rep;
+  typedef Period period;
+
+  duration()
+      : count_() {
+  }
+
+  explicit duration(const rep& count)
+      : count_(count) {
+  }
+
+  template <class Rep2, class Period2>
+  duration(const duration<Rep2, Period2>& d)
+      : count_(duration_cast<duration>(d).count()) {
+  }
+
+  rep count() const {
+    return this->count_;
+  }
+
+  duration operator+() const {
+    return *this;
+  }
+
+  duration operator-() const {
+    return duration(-this->count_);
+  }
+
+  duration& operator+=(const duration& d) {
+    this->count_ += d.count();
+    return *this;
+  }
+
+  duration& operator-=(const duration& d) {
+    this->count_ -= d.count();
+    return *this;
+  }
+
+  duration& operator*=(const rep& rhs) {
+    this->count_ *= rhs;
+    return *this;
+  }
+
+  duration& operator/=(const rep& rhs) {
+    this->count_ /= rhs;
+    return *this;
+  }
+
+  static duration zero() {
+    return duration(0);
+  }
+
+ private:
+  rep count_;
+};
+
+template <class Rep, class Period>
+inline duration<Rep, Period> operator+(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return duration<Rep, Period>(lhs.count() + rhs.count());
+}
+
+template <class Rep, class Period>
+inline duration<Rep, Period> operator-(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return duration<Rep, Period>(lhs.count() - rhs.count());
+}
+
+template <class Rep, class Period>
+inline bool operator==(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() == rhs.count();
+}
+
+template <class Rep, class Period>
+inline bool operator!=(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() != rhs.count();
+}
+
+template <class Rep, class Period>
+inline bool operator<(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() < rhs.count();
+}
+
+template <class Rep, class Period>
+inline bool operator<=(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() <= rhs.count();
+}
+
+template <class Rep, class Period>
+inline bool operator>(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() > rhs.count();
+}
+
+template <class Rep, class Period>
+inline bool operator>=(
+    const duration<Rep, Period>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  return lhs.count() >= rhs.count();
+}
+
+/**
+ * Mixed durations are combined and compared in nanoseconds, which
+ * represent every standard period exactly.
+ */
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline nanoseconds operator+(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) + nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline nanoseconds operator-(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) - nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator==(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) == nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator!=(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) != nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator<(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) < nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator<=(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) <= nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator>(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) > nanoseconds(rhs);
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+inline bool operator>=(
+    const duration<Rep1, Period1>& lhs,
+    const duration<Rep2, Period2>& rhs
+) {
+  return nanoseconds(lhs) >= nanoseconds(rhs);
+}
+
+template <class Rep, class Period>
+inline duration<Rep, Period> operator*(
+    const duration<Rep, Period>& lhs,
+    const Rep& rhs
+) {
+  return duration<Rep, Period>(lhs.count() * rhs);
+}
+
+template <class Rep, class Period>
+inline duration<Rep, Period> operator/(
+    const duration<Rep, Period>& lhs,
+    const Rep& rhs
+) {
+  return duration<Rep, Period>(lhs.count() / rhs);
+}
+
+/**
+ * Time points
+ */
+
+template <class Clock, class Duration = typename Clock::duration>
+class time_point {
+ public:
+  typedef Clock clock;
+  typedef Duration duration;
+  typedef typename duration::rep rep;
+  typedef typename duration::period period;
+
+  time_point()
+      : time_since_epoch_() {
+  }
+
+  explicit time_point(const duration& d)
+      : time_since_epoch_(d) {
+  }
+
+  template <class Duration2>
+  time_point(const time_point<Clock, Duration2>& t)
+      : time_since_epoch_(t.time_since_epoch()) {
+  }
+
+  duration time_since_epoch() const {
+    return this->time_since_epoch_;
+  }
+
+  template <class Rep2, class Period2>
+  time_point& operator+=(const ::std::chrono::duration<Rep2, Period2>& d) {
+    this->time_since_epoch_ += duration(d);
+    return *this;
+  }
+
+  template <class Rep2, class Period2>
+  time_point& operator-=(const ::std::chrono::duration<Rep2, Period2>& d) {
+    this->time_since_epoch_ -= duration(d);
+    return *this;
+  }
+
+ private:
+  duration time_since_epoch_;
+};
+
+template <class Clock, class Duration, class Rep, class Period>
+inline time_point<Clock, Duration> operator+(
+    const time_point<Clock, Duration>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  time_point<Clock, Duration> result(lhs);
+  result += rhs;
+
+  return result;
+}
+
+template <class Clock, class Duration, class Rep, class Period>
+inline time_point<Clock, Duration> operator-(
+    const time_point<Clock, Duration>& lhs,
+    const duration<Rep, Period>& rhs
+) {
+  time_point<Clock, Duration> result(lhs);
+  result -= rhs;
+
+  return result;
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline nanoseconds operator-(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() - rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator==(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() == rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator!=(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() != rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator<(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() < rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator<=(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() <= rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator>(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() > rhs.time_since_epoch();
+}
+
+template <class Clock, class Duration1, class Duration2>
+inline bool operator>=(
+    const time_point<Clock, Duration1>& lhs,
+    const time_point<Clock, Duration2>& rhs
+) {
+  return lhs.time_since_epoch() >= rhs.time_since_epoch();
+}
+
+template <class ToDuration, class Clock, class Duration>
+inline time_point<Clock, ToDuration> time_point_cast(
+    const time_point<Clock, Duration>& t
+) {
+  return time_point<Clock, ToDuration>(
+      duration_cast<ToDuration>(t.time_since_epoch())
+  );
+}
+
+/**
+ * Clocks
+ */
+
+class DLLEXPORT system_clock {
+ public:
+  typedef nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef ::std::chrono::time_point<system_clock> time_point;
+
+  static const bool is_steady = false;
+
+  static time_point now() throw();
+
+  static ::time_t to_time_t(const time_point& t) throw();
+
+  static time_point from_time_t(::time_t t) throw();
+};
+
+class DLLEXPORT steady_clock {
+ public:
+  typedef nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef ::std::chrono::time_point<steady_clock> time_point;
+
+  static const bool is_steady = true;
+
+  static time_point now() throw();
+};
+
+typedef steady_clock high_resolution_clock;
+
+} // namespace chrono
+} // namespace std
+
+#include "../../../dllexport_undefine.inc"
+#endif // __cplusplus >= 201103L || _MSVC_LANG >= 201103L
+
+#include <mdc/std/time.h>
+
+namespace mdc {
+namespace chrono_detail {
+
+/**
+ * Converts a system clock time point to the timespec taken by the
+ * timed waits of the C library.
+ */
+template <class Duration>
+inline ::timespec ToTimespec(
+    const ::std::chrono::time_point<
+        ::std::chrono::system_clock,
+        Duration
+    >& abs_time
+) {
+  ::std::chrono::seconds seconds_since_epoch =
+      ::std::chrono::duration_cast< ::std::chrono::seconds>(
+          abs_time.time_since_epoch()
+      );
+  ::std::chrono::nanoseconds nanoseconds_remainder =
+      ::std::chrono::duration_cast< ::std::chrono::nanoseconds>(
+          abs_time.time_since_epoch() - seconds_since_epoch
+      );
+
+  ::timespec time_point;
+  time_point.tv_sec = static_cast< ::time_t>(seconds_since_epoch.count());
+  time_point.tv_nsec = static_cast<long>(nanoseconds_remainder.count());
+
+  return time_point;
+}
+
+} // namespace chrono_detail
+} // namespace mdc
+
+#endif /* MDC_CPP98_STD_CHRONO_HPP_ */
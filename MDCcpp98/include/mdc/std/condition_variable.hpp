@@ -38,6 +38,7 @@
 
 #include <mdc/std/threads.h>
 
+#include "chrono.hpp"
 #include "mutex.hpp"
 
 #include "../../../dllexport_define.inc"
@@ -48,6 +49,24 @@ namespace std {
  * Condition variables
  */
 
+class cv_status {
+ public:
+  enum value_type {
+    no_timeout,
+    timeout
+  };
+
+  cv_status(value_type value) : value_(value) {
+  }
+
+  operator value_type() const {
+    return this->value_;
+  }
+
+ private:
+  value_type value_;
+};
+
 class DLLEXPORT condition_variable {
  public:
   condition_variable();
@@ -67,6 +86,58 @@ class DLLEXPORT condition_variable {
     }
   }
 
+  cv_status wait_until(
+      unique_lock<mutex>& lock,
+      const chrono::system_clock::time_point& abs_time
+  );
+
+  template <class Clock, class Duration>
+  cv_status wait_until(
+      unique_lock<mutex>& lock,
+      const chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    return this->wait_until(
+        lock,
+        chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+  }
+
+  template <class Clock, class Duration, class Predicate>
+  bool wait_until(
+      unique_lock<mutex>& lock,
+      const chrono::time_point<Clock, Duration>& abs_time,
+      Predicate pred
+  ) {
+    while (!pred()) {
+      if (this->wait_until(lock, abs_time) == cv_status::timeout) {
+        return pred();
+      }
+    }
+
+    return true;
+  }
+
+  template <class Rep, class Period>
+  cv_status wait_for(
+      unique_lock<mutex>& lock,
+      const chrono::duration<Rep, Period>& rel_time
+  ) {
+    return this->wait_until(lock, chrono::system_clock::now() + rel_time);
+  }
+
+  template <class Rep, class Period, class Predicate>
+  bool wait_for(
+      unique_lock<mutex>& lock,
+      const chrono::duration<Rep, Period>& rel_time,
+      Predicate pred
+  ) {
+    return this->wait_until(
+        lock,
+        chrono::system_clock::now() + rel_time,
+        pred
+    );
+  }
+
  private:
   ::cnd_t condition_variable_;
 
@@ -87,7 +158,7 @@ class DLLEXPORT condition_variable_any {
 
   template <class Lock>
   void wait(Lock& lock) {
-    ::cnd_wait(&this->condition_variable_, &lock.mutex()->native_handle());
+    ::cnd_wait(&this->condition_variable_, lock.mutex()->native_handle());
   }
 
   template <class Lock, class Predicate>
@@ -97,9 +168,61 @@ class DLLEXPORT condition_variable_any {
     }
   }
 
+  template <class Lock, class Clock, class Duration>
+  cv_status wait_until(
+      Lock& lock,
+      const chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    return this->wait_until_native(
+        lock.mutex()->native_handle(),
+        chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+  }
+
+  template <class Lock, class Clock, class Duration, class Predicate>
+  bool wait_until(
+      Lock& lock,
+      const chrono::time_point<Clock, Duration>& abs_time,
+      Predicate pred
+  ) {
+    while (!pred()) {
+      if (this->wait_until(lock, abs_time) == cv_status::timeout) {
+        return pred();
+      }
+    }
+
+    return true;
+  }
+
+  template <class Lock, class Rep, class Period>
+  cv_status wait_for(
+      Lock& lock,
+      const chrono::duration<Rep, Period>& rel_time
+  ) {
+    return this->wait_until(lock, chrono::system_clock::now() + rel_time);
+  }
+
+  template <class Lock, class Rep, class Period, class Predicate>
+  bool wait_for(
+      Lock& lock,
+      const chrono::duration<Rep, Period>& rel_time,
+      Predicate pred
+  ) {
+    return this->wait_until(
+        lock,
+        chrono::system_clock::now() + rel_time,
+        pred
+    );
+  }
+
  private:
   ::cnd_t condition_variable_;
 
+  cv_status wait_until_native(
+      ::mtx_t* mutex,
+      const chrono::system_clock::time_point& abs_time
+  );
+
   // Intentionally unimplemented to "delete" them.
   condition_variable_any(const condition_variable_any&);
   condition_variable_any& operator=(const condition_variable_any&);
@@ -0,0 +1,80 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_LATCH_HPP_
+#define MDC_CPP98_STD_LATCH_HPP_
+
+#if __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#include <latch>
+
+#else
+
+#include <stddef.h>
+
+#include <mdc/concurrency/latch.h>
+
+#include "../../../dllexport_define.inc"
+
+namespace std {
+
+/**
+ * Latches
+ */
+
+class DLLEXPORT latch {
+ public:
+  static ptrdiff_t max() throw();
+
+  explicit latch(ptrdiff_t expected);
+
+  ~latch();
+
+  void count_down(ptrdiff_t update = 1);
+
+  bool try_wait() const throw();
+
+  void wait() const;
+
+  void arrive_and_wait(ptrdiff_t update = 1);
+
+ private:
+  mutable ::Mdc_Latch latch_;
+
+  // Intentionally unimplemented to "delete" them.
+  latch(const latch&);
+  latch& operator=(const latch&);
+};
+
+} // namespace std
+
+#include "../../../dllexport_undefine.inc"
+#endif // __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#endif /* MDC_CPP98_STD_LATCH_HPP_ */
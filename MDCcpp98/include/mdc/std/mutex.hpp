@@ -40,8 +40,11 @@
 
 #include <stdexcept>
 
+#include <mdc/concurrency/once_cell.h>
 #include <mdc/std/threads.h>
 
+#include "chrono.hpp"
+
 #include "../../../dllexport_define.inc"
 
 namespace std {
@@ -104,6 +107,88 @@ class DLLEXPORT recursive_mutex {
   recursive_mutex& operator=(const recursive_mutex&);
 };
 
+class DLLEXPORT timed_mutex {
+ private:
+  typedef ::mtx_t native_type;
+
+ public:
+  typedef native_type* native_handle_type;
+
+  timed_mutex() throw();
+
+  ~timed_mutex();
+
+  void lock();
+
+  bool try_lock();
+
+  template <class Rep, class Period>
+  bool try_lock_for(const chrono::duration<Rep, Period>& rel_time) {
+    return this->try_lock_until(chrono::system_clock::now() + rel_time);
+  }
+
+  template <class Clock, class Duration>
+  bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time) {
+    return this->try_lock_until(
+        chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+  }
+
+  bool try_lock_until(const chrono::system_clock::time_point& abs_time);
+
+  void unlock();
+
+  native_handle_type native_handle();
+
+ private:
+  native_type mutex_;
+
+  // Intentionally unimplemented to "delete" them.
+  timed_mutex(const timed_mutex&);
+  timed_mutex& operator=(const timed_mutex&);
+};
+
+class DLLEXPORT recursive_timed_mutex {
+ private:
+  typedef ::mtx_t native_type;
+
+ public:
+  typedef native_type* native_handle_type;
+
+  recursive_timed_mutex() throw();
+
+  ~recursive_timed_mutex();
+
+  void lock();
+
+  bool try_lock();
+
+  template <class Rep, class Period>
+  bool try_lock_for(const chrono::duration<Rep, Period>& rel_time) {
+    return this->try_lock_until(chrono::system_clock::now() + rel_time);
+  }
+
+  template <class Clock, class Duration>
+  bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time) {
+    return this->try_lock_until(
+        chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+  }
+
+  bool try_lock_until(const chrono::system_clock::time_point& abs_time);
+
+  void unlock();
+
+  native_handle_type native_handle();
+
+ private:
+  native_type mutex_;
+
+  // Intentionally unimplemented to "delete" them.
+  recursive_timed_mutex(const recursive_timed_mutex&);
+  recursive_timed_mutex& operator=(const recursive_timed_mutex&);
+};
+
 /**
  * Generic mutex management
  */
@@ -113,13 +198,12 @@ class lock_guard {
  public:
   typedef Mutex mutex_type;
 
-  explicit lock_guard(mutex_type& m) {
-    this->mutex_ = m;
+  explicit lock_guard(mutex_type& m) : mutex_(m) {
     m.lock();
   }
 
   ~lock_guard() {
-    mutex_.unlock();
+    this->mutex_.unlock();
   }
 
  private:
@@ -189,7 +273,7 @@ class unique_lock {
       throw ::std::runtime_error("::std::unique_lock::unlock failure");
     }
 
-    if (this->is_owner_) {
+    if (!this->is_owner_) {
       throw ::std::runtime_error("::std::unique_lock::unlock failure");
     }
 
@@ -240,22 +324,55 @@ class DLLEXPORT once_flag;
 
 DLLEXPORT void call_once(once_flag& flag, void (*func)(void));
 
+template <class Callable>
+void call_once(once_flag& flag, Callable func);
+
 class DLLEXPORT once_flag {
  public:
   once_flag() throw();
 
+  ~once_flag();
+
   friend void call_once(once_flag& flag, void (*func)(void));
 
- private:
-  static const ::once_flag kDefaultInit;
+  template <class Callable>
+  friend void call_once(once_flag& flag, Callable func);
 
-  ::once_flag once_flag_;
+ private:
+  ::Mdc_OnceCell once_cell_;
 
   // Intentionally unimplemented to "delete" them.
   once_flag(const once_flag&);
   once_flag& operator=(const once_flag&);
 };
 
+/**
+ * Calls the callable exactly once across all threads that call it
+ * with the same flag. Once the call has completed, every later call
+ * returns after a single acquire load. If the callable throws, the
+ * exception is propagated and the flag is left unset, so that
+ * another call can try again.
+ */
+template <class Callable>
+void call_once(once_flag& flag, Callable func) {
+  if (MDC_ONCE_CELL_IS_READY(&flag.once_cell_)) {
+    return;
+  }
+
+  if (!::Mdc_OnceCell_BeginInit(&flag.once_cell_)) {
+    return;
+  }
+
+  try {
+    func();
+  } catch (...) {
+    ::Mdc_OnceCell_AbortInit(&flag.once_cell_);
+    throw;
+  }
+
+  ::Mdc_OnceCell_CommitInit(&flag.once_cell_, &flag);
+}
+
 } // namespace std
 
 #include "../../../dllexport_undefine.inc"
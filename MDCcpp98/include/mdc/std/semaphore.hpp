@@ -0,0 +1,146 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_SEMAPHORE_HPP_
+#define MDC_CPP98_STD_SEMAPHORE_HPP_
+
+#if __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#include <semaphore>
+
+#else
+
+#include <stddef.h>
+
+#include <stdexcept>
+
+#include <mdc/concurrency/semaphore.h>
+#include <mdc/std/time.h>
+
+#include "chrono.hpp"
+
+namespace std {
+
+/**
+ * Semaphores
+ */
+
+template <ptrdiff_t LeastMaxValue = ::Mdc_Semaphore_kMaxCount>
+class counting_semaphore {
+ public:
+  static ptrdiff_t max() throw() {
+    return LeastMaxValue;
+  }
+
+  explicit counting_semaphore(ptrdiff_t desired) {
+    int init_result = ::Mdc_Semaphore_Init(
+        &this->semaphore_,
+        static_cast<int>(desired)
+    );
+
+    if (init_result != thrd_success) {
+      throw ::std::runtime_error(
+          "::std::counting_semaphore::counting_semaphore failure"
+      );
+    }
+  }
+
+  ~counting_semaphore() {
+    ::Mdc_Semaphore_Deinit(&this->semaphore_);
+  }
+
+  void release(ptrdiff_t update = 1) {
+    int release_result = ::Mdc_Semaphore_Release(
+        &this->semaphore_,
+        static_cast<int>(update)
+    );
+
+    if (release_result != thrd_success) {
+      throw ::std::runtime_error("::std::counting_semaphore::release failure");
+    }
+  }
+
+  void acquire() {
+    int acquire_result = ::Mdc_Semaphore_Acquire(&this->semaphore_);
+
+    if (acquire_result != thrd_success) {
+      throw ::std::runtime_error("::std::counting_semaphore::acquire failure");
+    }
+  }
+
+  bool try_acquire() throw() {
+    return ::Mdc_Semaphore_TryAcquire(&this->semaphore_) == thrd_success;
+  }
+
+  template <class Rep, class Period>
+  bool try_acquire_for(const chrono::duration<Rep, Period>& rel_time) {
+    return this->try_acquire_until(chrono::system_clock::now() + rel_time);
+  }
+
+  template <class Clock, class Duration>
+  bool try_acquire_until(
+      const chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    ::timespec time_point = ::mdc::chrono_detail::ToTimespec(
+        chrono::system_clock::now() + (abs_time - Clock::now())
+    );
+
+    int acquire_result = ::Mdc_Semaphore_TimedAcquire(
+        &this->semaphore_,
+        &time_point
+    );
+
+    if (acquire_result == thrd_timedout) {
+      return false;
+    }
+
+    if (acquire_result != thrd_success) {
+      throw ::std::runtime_error(
+          "::std::counting_semaphore::try_acquire_until failure"
+      );
+    }
+
+    return true;
+  }
+
+ private:
+  ::Mdc_Semaphore semaphore_;
+
+  // Intentionally unimplemented to "delete" them.
+  counting_semaphore(const counting_semaphore&);
+  counting_semaphore& operator=(const counting_semaphore&);
+};
+
+typedef counting_semaphore<1> binary_semaphore;
+
+} // namespace std
+
+#endif // __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+
+#endif /* MDC_CPP98_STD_SEMAPHORE_HPP_ */
@@ -0,0 +1,306 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#ifndef MDC_CPP98_STD_SHARED_MUTEX_HPP_
+#define MDC_CPP98_STD_SHARED_MUTEX_HPP_
+
+#if __cplusplus >= 201703L || _MSVC_LANG >= 201703L
+
+#include <shared_mutex>
+
+#else
+
+#if __cplusplus >= 201402L || _MSVC_LANG >= 201402L
+  #include <shared_mutex>
+#endif
+
+#include <stddef.h>
+
+#include <stdexcept>
+
+#include <mdc/concurrency/rw_lock.h>
+#include <mdc/std/time.h>
+
+#include "chrono.hpp"
+
+#include "../../../dllexport_define.inc"
+
+namespace std {
+
+/**
+ * Shared mutual exclusion
+ */
+
+class DLLEXPORT shared_mutex {
+ private:
+  typedef ::Mdc_RwLock native_type;
+
+ public:
+  typedef native_type* native_handle_type;
+
+  shared_mutex();
+
+  ~shared_mutex();
+
+  void lock();
+
+  bool try_lock();
+
+  void unlock();
+
+  void lock_shared();
+
+  bool try_lock_shared();
+
+  void unlock_shared();
+
+  native_handle_type native_handle();
+
+ private:
+  native_type rw_lock_;
+
+  // Intentionally unimplemented to "delete" them.
+  shared_mutex(const shared_mutex&);
+  shared_mutex& operator=(const shared_mutex&);
+};
+
+#if __cplusplus < 201402L && _MSVC_LANG < 201402L
+
+class DLLEXPORT shared_timed_mutex {
+ private:
+  typedef ::Mdc_RwLock native_type;
+
+ public:
+  shared_timed_mutex();
+
+  ~shared_timed_mutex();
+
+  void lock();
+
+  bool try_lock();
+
+  template <class Rep, class Period>
+  bool try_lock_for(const chrono::duration<Rep, Period>& rel_time) {
+    return this->try_lock_until(
+        chrono::system_clock::now()
+            + chrono::duration_cast<chrono::system_clock::duration>(rel_time)
+    );
+  }
+
+  template <class Clock, class Duration>
+  bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time) {
+    ::timespec time_point = ::mdc::chrono_detail::ToTimespec(
+        chrono::system_clock::now()
+            + chrono::duration_cast<chrono::system_clock::duration>(
+                abs_time - Clock::now()
+            )
+    );
+
+    int lock_result = ::Mdc_RwLock_TimedLock(&this->rw_lock_, &time_point);
+
+    if (lock_result == thrd_timedout) {
+      return false;
+    }
+
+    if (lock_result != thrd_success) {
+      throw ::std::runtime_error(
+          "::std::shared_timed_mutex::try_lock_until failure"
+      );
+    }
+
+    return true;
+  }
+
+  void unlock();
+
+  void lock_shared();
+
+  bool try_lock_shared();
+
+  template <class Rep, class Period>
+  bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time) {
+    return this->try_lock_shared_until(
+        chrono::system_clock::now()
+            + chrono::duration_cast<chrono::system_clock::duration>(rel_time)
+    );
+  }
+
+  template <class Clock, class Duration>
+  bool try_lock_shared_until(
+      const chrono::time_point<Clock, Duration>& abs_time
+  ) {
+    ::timespec time_point = ::mdc::chrono_detail::ToTimespec(
+        chrono::system_clock::now()
+            + chrono::duration_cast<chrono::system_clock::duration>(
+                abs_time - Clock::now()
+            )
+    );
+
+    int lock_shared_result = ::Mdc_RwLock_TimedLockShared(
+        &this->rw_lock_,
+        &time_point
+    );
+
+    if (lock_shared_result == thrd_timedout) {
+      return false;
+    }
+
+    if (lock_shared_result != thrd_success) {
+      throw ::std::runtime_error(
+          "::std::shared_timed_mutex::try_lock_shared_until failure"
+      );
+    }
+
+    return true;
+  }
+
+  void unlock_shared();
+
+ private:
+  native_type rw_lock_;
+
+  // Intentionally unimplemented to "delete" them.
+  shared_timed_mutex(const shared_timed_mutex&);
+  shared_timed_mutex& operator=(const shared_timed_mutex&);
+};
+
+/**
+ * Shared mutex management
+ */
+
+template <class Mutex>
+class shared_lock {
+ public:
+  typedef Mutex mutex_type;
+
+  shared_lock() throw()
+      : mutex_(NULL),
+        is_owner_(false) {
+  }
+
+  explicit shared_lock(mutex_type& m) {
+    m.lock_shared();
+
+    this->is_owner_ = true;
+    this->mutex_ = &m;
+  }
+
+  ~shared_lock() {
+    if (this->mutex_ != NULL && this->is_owner_) {
+      this->mutex_->unlock_shared();
+    }
+  }
+
+  void lock() {
+    if (this->mutex_ == NULL) {
+      throw ::std::runtime_error("::std::shared_lock::lock failure");
+    }
+
+    if (this->is_owner_) {
+      throw ::std::runtime_error("::std::shared_lock::lock failure");
+    }
+
+    this->mutex_->lock_shared();
+    this->is_owner_ = true;
+  }
+
+  bool try_lock() {
+    if (this->mutex_ == NULL) {
+      throw ::std::runtime_error("::std::shared_lock::try_lock failure");
+    }
+
+    if (this->is_owner_) {
+      throw ::std::runtime_error("::std::shared_lock::try_lock failure");
+    }
+
+    bool is_try_lock_success = this->mutex_->try_lock_shared();
+
+    if (is_try_lock_success) {
+      this->is_owner_ = true;
+    }
+
+    return is_try_lock_success;
+  }
+
+  void unlock() {
+    if (this->mutex_ == NULL) {
+      throw ::std::runtime_error("::std::shared_lock::unlock failure");
+    }
+
+    if (!this->is_owner_) {
+      throw ::std::runtime_error("::std::shared_lock::unlock failure");
+    }
+
+    this->mutex_->unlock_shared();
+    this->is_owner_ = false;
+  }
+
+  void swap(shared_lock<Mutex>& other) throw() {
+    mutex_type* temp_mutex = this->mutex_;
+    bool temp_is_owner = this->is_owner_;
+
+    this->mutex_ = other.mutex_;
+    this->is_owner_ = other.is_owner_;
+
+    other.mutex_ = temp_mutex;
+    other.is_owner_ = temp_is_owner;
+  }
+
+  mutex_type* release() throw() {
+    mutex_type* release_mutex = this->mutex_;
+    this->mutex_ = NULL;
+
+    return release_mutex;
+  }
+
+  mutex_type* mutex() const throw() {
+    return this->mutex_;
+  }
+
+  bool owns_lock() const throw() {
+    return (this->mutex_ != NULL && this->is_owner_);
+  }
+
+ private:
+  mutex_type* mutex_;
+  bool is_owner_;
+
+  // Intentionally unimplemented to "delete" them.
+  shared_lock(const shared_lock&);
+  shared_lock& operator=(const shared_lock&);
+};
+
+#endif // __cplusplus < 201402L && _MSVC_LANG < 201402L
+
+} // namespace std
+
+#include "../../../dllexport_undefine.inc"
+#endif // __cplusplus >= 201703L || _MSVC_LANG >= 201703L
+
+#endif /* MDC_CPP98_STD_SHARED_MUTEX_HPP_ */
@@ -36,17 +36,149 @@
 
 #else
 
+#include <stddef.h>
+
+#include <mdc/concurrency/thrd.h>
 #include <mdc/std/threads.h>
 
+#include "chrono.hpp"
+
 #include "../../../dllexport_define.inc"
 
 namespace std {
 
 class DLLEXPORT thread {
+ private:
+  typedef thrd_t native_type;
+
+  struct CallableTag {
+  };
+
+  /**
+   * Removes a callable constructor from overload resolution when the
+   * function is a C thread function.
+   */
+  template <class Function, class Unused = void>
+  struct CallableOnly {
+    typedef CallableTag type;
+  };
+
+  template <class Unused>
+  struct CallableOnly<int (*)(void*), Unused> {
+  };
+
  public:
+  typedef native_type native_handle_type;
+
+  class id {
+   public:
+    id() throw()
+        : id_(0) {
+    }
+
+    /**
+     * Extension: wraps the ID that Mdc_Thrd_GetId returns.
+     */
+    explicit id(unsigned long native_id) throw()
+        : id_(native_id) {
+    }
+
+    friend bool operator==(id lhs, id rhs) throw() {
+      return lhs.id_ == rhs.id_;
+    }
+
+    friend bool operator!=(id lhs, id rhs) throw() {
+      return lhs.id_ != rhs.id_;
+    }
+
+    friend bool operator<(id lhs, id rhs) throw() {
+      return lhs.id_ < rhs.id_;
+    }
+
+    friend bool operator<=(id lhs, id rhs) throw() {
+      return lhs.id_ <= rhs.id_;
+    }
+
+    friend bool operator>(id lhs, id rhs) throw() {
+      return lhs.id_ > rhs.id_;
+    }
+
+    friend bool operator>=(id lhs, id rhs) throw() {
+      return lhs.id_ >= rhs.id_;
+    }
+
+   private:
+    unsigned long id_;
+  };
+
+  thread() throw();
 
   explicit thread(int (*func)(void*), void* arg);
 
+  /**
+   * Extension: creates the thread with the specified stack size, name,
+   * and CPU affinity. Not available with the standard library thread.
+   */
+  thread(
+      int (*func)(void*),
+      void* arg,
+      const ::Mdc_ThrdAttributes& attributes
+  );
+
+  /**
+   * Creates a thread that calls a copy of the callable with copies of
+   * the arguments. Without variadic templates, up to three arguments
+   * can be bound. An exception that escapes the callable terminates
+   * the program.
+   *
+   * A thread function of type int (*)(void*) always goes to the
+   * constructors above, so that NULL is still accepted as its argument
+   * and the thread is started without allocating.
+   */
+  template <class Function>
+  explicit thread(Function func)
+      : is_joinable_(false) {
+    this->Start(new StartRoutine0<Function>(func));
+  }
+
+  template <class Function, class Arg1>
+  thread(
+      Function func,
+      Arg1 arg1,
+      typename CallableOnly<Function>::type* = NULL
+  ) : is_joinable_(false) {
+    this->Start(new StartRoutine1<Function, Arg1>(func, arg1));
+  }
+
+  template <class Function, class Arg1, class Arg2>
+  thread(
+      Function func,
+      Arg1 arg1,
+      Arg2 arg2,
+      typename CallableOnly<Function>::type* = NULL
+  ) : is_joinable_(false) {
+    this->Start(new StartRoutine2<Function, Arg1, Arg2>(func, arg1, arg2));
+  }
+
+  template <class Function, class Arg1, class Arg2, class Arg3>
+  thread(Function func, Arg1 arg1, Arg2 arg2, Arg3 arg3)
+      : is_joinable_(false) {
+    this->Start(new StartRoutine3<Function, Arg1, Arg2, Arg3>(
+        func,
+        arg1,
+        arg2,
+        arg3
+    ));
+  }
+
+  bool joinable() const throw();
+
+  id get_id() const throw();
+
+  native_handle_type native_handle();
+
+  static unsigned int hardware_concurrency() throw();
+
   void join();
 
   void detach();
@@ -54,13 +186,124 @@ class DLLEXPORT thread {
   void swap(thread& other) throw();
 
  private:
-  thrd_t thread_;
+  class StartRoutine {
+   public:
+    virtual ~StartRoutine() {
+    }
+
+    virtual void Run() = 0;
+  };
+
+  template <class Function>
+  class StartRoutine0 : public StartRoutine {
+   public:
+    explicit StartRoutine0(Function func)
+        : func_(func) {
+    }
+
+    void Run() {
+      this->func_();
+    }
+
+   private:
+    Function func_;
+  };
+
+  template <class Function, class Arg1>
+  class StartRoutine1 : public StartRoutine {
+   public:
+    StartRoutine1(Function func, Arg1 arg1)
+        : func_(func),
+          arg1_(arg1) {
+    }
+
+    void Run() {
+      this->func_(this->arg1_);
+    }
+
+   private:
+    Function func_;
+    Arg1 arg1_;
+  };
+
+  template <class Function, class Arg1, class Arg2>
+  class StartRoutine2 : public StartRoutine {
+   public:
+    StartRoutine2(Function func, Arg1 arg1, Arg2 arg2)
+        : func_(func),
+          arg1_(arg1),
+          arg2_(arg2) {
+    }
+
+    void Run() {
+      this->func_(this->arg1_, this->arg2_);
+    }
+
+   private:
+    Function func_;
+    Arg1 arg1_;
+    Arg2 arg2_;
+  };
+
+  template <class Function, class Arg1, class Arg2, class Arg3>
+  class StartRoutine3 : public StartRoutine {
+   public:
+    StartRoutine3(Function func, Arg1 arg1, Arg2 arg2, Arg3 arg3)
+        : func_(func),
+          arg1_(arg1),
+          arg2_(arg2),
+          arg3_(arg3) {
+    }
+
+    void Run() {
+      this->func_(this->arg1_, this->arg2_, this->arg3_);
+    }
+
+   private:
+    Function func_;
+    Arg1 arg1_;
+    Arg2 arg2_;
+    Arg3 arg3_;
+  };
+
+  native_type thread_;
+  bool is_joinable_;
+
+  static int RunStartRoutine(void* start_routine);
+
+  void Start(StartRoutine* start_routine);
+
+  void Start(
+      int (*func)(void*),
+      void* arg,
+      const ::Mdc_ThrdAttributes* attributes
+  );
 
   // Intentionally unimplemented to "delete" them.
-  thread();
   thread(const thread&);
+  thread& operator=(const thread&);
 };
 
+namespace this_thread {
+
+DLLEXPORT thread::id get_id() throw();
+
+DLLEXPORT void yield() throw();
+
+DLLEXPORT void sleep_for(const chrono::nanoseconds& rel_time);
+
+template <class Rep, class Period>
+void sleep_for(const chrono::duration<Rep, Period>& rel_time) {
+  sleep_for(chrono::nanoseconds(rel_time));
+}
+
+template <class Clock, class Duration>
+void sleep_until(const chrono::time_point<Clock, Duration>& abs_time) {
+  sleep_for(chrono::nanoseconds(abs_time - Clock::now()));
+}
+
+} // namespace this_thread
+
 } // namespace std
 
 
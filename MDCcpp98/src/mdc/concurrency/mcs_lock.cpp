@@ -0,0 +1,60 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/mcs_lock.hpp"
+
+#include <mdc/std/threads.h>
+
+namespace mdc {
+
+McsLock::McsLock() {
+  ::Mdc_McsLock_Init(&this->lock_);
+}
+
+McsLock::~McsLock() {
+  ::Mdc_McsLock_Deinit(&this->lock_);
+}
+
+void McsLock::lock() {
+  ::Mdc_McsLock_Lock(&this->lock_);
+}
+
+bool McsLock::try_lock() {
+  return ::Mdc_McsLock_TryLock(&this->lock_) == thrd_success;
+}
+
+void McsLock::unlock() {
+  ::Mdc_McsLock_Unlock(&this->lock_);
+}
+
+McsLock::native_handle_type McsLock::native_handle() {
+  return &this->lock_;
+}
+
+} // namespace mdc
@@ -0,0 +1,81 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/concurrency/thread_pool.hpp"
+
+#include <new>
+#include <stdexcept>
+
+namespace mdc {
+
+ThreadPool::ThreadPool(size_t workers_count) {
+  int init_result = ::Mdc_ThreadPool_Init(&this->pool_, workers_count);
+
+  if (init_result == thrd_nomem) {
+    throw ::std::bad_alloc();
+  }
+
+  if (init_result != thrd_success) {
+    throw ::std::runtime_error("::mdc::ThreadPool::ThreadPool failure");
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  ::Mdc_ThreadPool_Deinit(&this->pool_);
+}
+
+void ThreadPool::Submit(void (*func)(void*), void* arg) {
+  int submit_result = ::Mdc_ThreadPool_Submit(&this->pool_, func, arg);
+
+  if (submit_result != thrd_success) {
+    throw ::std::bad_alloc();
+  }
+}
+
+void ThreadPool::SubmitBatch(const Task* tasks, size_t count) {
+  int submit_result = ::Mdc_ThreadPool_SubmitBatch(
+      &this->pool_,
+      tasks,
+      count
+  );
+
+  if (submit_result != thrd_success) {
+    throw ::std::bad_alloc();
+  }
+}
+
+void ThreadPool::WaitIdle() {
+  ::Mdc_ThreadPool_WaitIdle(&this->pool_);
+}
+
+size_t ThreadPool::workers_count() const throw() {
+  return this->pool_.workers_count_;
+}
+
+} // namespace mdc
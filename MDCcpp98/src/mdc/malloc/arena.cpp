@@ -0,0 +1,82 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../include/mdc/malloc/arena.hpp"
+
+namespace mdc {
+
+Arena::Arena(size_t block_size) {
+  ::Mdc_Arena_Init(&this->arena_, block_size);
+}
+
+Arena::~Arena() {
+  ::Mdc_Arena_Deinit(&this->arena_);
+}
+
+void* Arena::Allocate(size_t size) {
+  void* result = ::Mdc_Arena_Allocate(&this->arena_, size);
+
+  if (result == NULL) {
+    throw ::std::bad_alloc();
+  }
+
+  return result;
+}
+
+void* Arena::AllocateAligned(size_t size, size_t alignment) {
+  void* result = ::Mdc_Arena_AllocateAligned(&this->arena_, size, alignment);
+
+  if (result == NULL) {
+    throw ::std::bad_alloc();
+  }
+
+  return result;
+}
+
+Arena::mark_type Arena::GetMark() const {
+  mark_type mark;
+
+  ::Mdc_Arena_GetMark(&this->arena_, &mark);
+
+  return mark;
+}
+
+void Arena::Rewind(const mark_type& mark) {
+  ::Mdc_Arena_Rewind(&this->arena_, &mark);
+}
+
+void Arena::Reset() {
+  ::Mdc_Arena_Reset(&this->arena_);
+}
+
+Arena::native_handle_type Arena::native_handle() {
+  return &this->arena_;
+}
+
+} // namespace mdc
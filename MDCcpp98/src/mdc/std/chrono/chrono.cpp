@@ -0,0 +1,117 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../../include/mdc/std/chrono.hpp"
+
+#if __cplusplus < 201103L && _MSVC_LANG < 201103L
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  #include <windows.h>
+#endif
+
+#include <mdc/std/time.h>
+
+namespace std {
+namespace chrono {
+
+namespace {
+
+static const duration_rep_type kNanosecondsPerSecond = 1000000000;
+
+} // namespace
+
+/**
+ * system_clock
+ */
+
+system_clock::time_point system_clock::now() throw() {
+  ::timespec ts;
+
+  ::timespec_get(&ts, TIME_UTC);
+
+  return time_point(duration(
+      static_cast<duration_rep_type>(ts.tv_sec) * kNanosecondsPerSecond
+          + ts.tv_nsec
+  ));
+}
+
+::time_t system_clock::to_time_t(const time_point& t) throw() {
+  return static_cast< ::time_t>(
+      duration_cast<seconds>(t.time_since_epoch()).count()
+  );
+}
+
+system_clock::time_point system_clock::from_time_t(::time_t t) throw() {
+  return time_point(seconds(t));
+}
+
+/**
+ * steady_clock
+ */
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+
+steady_clock::time_point steady_clock::now() throw() {
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  duration_rep_type seconds_part;
+  duration_rep_type remainder_part;
+
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+
+  // Split the conversion to avoid overflowing the multiplication.
+  seconds_part = counter.QuadPart / frequency.QuadPart;
+  remainder_part = counter.QuadPart % frequency.QuadPart;
+
+  return time_point(duration(
+      seconds_part * kNanosecondsPerSecond
+          + remainder_part * kNanosecondsPerSecond / frequency.QuadPart
+  ));
+}
+
+#elif defined(__GNUC__)
+
+steady_clock::time_point steady_clock::now() throw() {
+  ::timespec ts;
+
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return time_point(duration(
+      static_cast<duration_rep_type>(ts.tv_sec) * kNanosecondsPerSecond
+          + ts.tv_nsec
+  ));
+}
+
+#endif
+
+} // namespace chrono
+} // namespace std
+
+#endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
@@ -33,6 +33,8 @@
 
 #include <stdexcept>
 
+#include <mdc/std/time.h>
+
 namespace std {
 
 condition_variable::condition_variable() {
@@ -61,6 +63,31 @@ void condition_variable::wait(unique_lock<mutex>& lock) {
   ::cnd_wait(&this->condition_variable_, lock.mutex()->native_handle());
 }
 
+cv_status condition_variable::wait_until(
+    unique_lock<mutex>& lock,
+    const chrono::system_clock::time_point& abs_time
+) {
+  ::timespec time_point = ::mdc::chrono_detail::ToTimespec(abs_time);
+
+  int wait_result = ::cnd_timedwait(
+      &this->condition_variable_,
+      lock.mutex()->native_handle(),
+      &time_point
+  );
+
+  if (wait_result == thrd_timedout) {
+    return cv_status::timeout;
+  }
+
+  if (wait_result != thrd_success) {
+    throw ::std::runtime_error(
+        "::std::condition_variable::wait_until failure"
+    );
+  }
+
+  return cv_status::no_timeout;
+}
+
 } // namespace std
 
 #endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
@@ -33,6 +33,8 @@
 
 #include <stdexcept>
 
+#include <mdc/std/time.h>
+
 namespace std {
 
 condition_variable_any::condition_variable_any() {
@@ -57,6 +59,31 @@ void condition_variable_any::notify_all() throw() {
   ::cnd_broadcast(&this->condition_variable_);
 }
 
+cv_status condition_variable_any::wait_until_native(
+    ::mtx_t* mutex,
+    const chrono::system_clock::time_point& abs_time
+) {
+  ::timespec time_point = ::mdc::chrono_detail::ToTimespec(abs_time);
+
+  int wait_result = ::cnd_timedwait(
+      &this->condition_variable_,
+      mutex,
+      &time_point
+  );
+
+  if (wait_result == thrd_timedout) {
+    return cv_status::timeout;
+  }
+
+  if (wait_result != thrd_success) {
+    throw ::std::runtime_error(
+        "::std::condition_variable_any::wait_until failure"
+    );
+  }
+
+  return cv_status::no_timeout;
+}
+
 } // namespace std
 
 #endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
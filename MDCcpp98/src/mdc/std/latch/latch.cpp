@@ -0,0 +1,93 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../../include/mdc/std/latch.hpp"
+
+#if __cplusplus < 202002L && _MSVC_LANG < 202002L
+
+#include <stdexcept>
+
+namespace std {
+
+ptrdiff_t latch::max() throw() {
+  return ::Mdc_Latch_kMaxCount;
+}
+
+latch::latch(ptrdiff_t expected) {
+  int init_result = ::Mdc_Latch_Init(
+      &this->latch_,
+      static_cast<int>(expected)
+  );
+
+  if (init_result != thrd_success) {
+    throw ::std::runtime_error("::std::latch::latch failure");
+  }
+}
+
+latch::~latch() {
+  ::Mdc_Latch_Deinit(&this->latch_);
+}
+
+void latch::count_down(ptrdiff_t update) {
+  int count_down_result = ::Mdc_Latch_CountDown(
+      &this->latch_,
+      static_cast<int>(update)
+  );
+
+  if (count_down_result != thrd_success) {
+    throw ::std::runtime_error("::std::latch::count_down failure");
+  }
+}
+
+bool latch::try_wait() const throw() {
+  return ::Mdc_Latch_TryWait(&this->latch_) != 0;
+}
+
+void latch::wait() const {
+  int wait_result = ::Mdc_Latch_Wait(&this->latch_);
+
+  if (wait_result != thrd_success) {
+    throw ::std::runtime_error("::std::latch::wait failure");
+  }
+}
+
+void latch::arrive_and_wait(ptrdiff_t update) {
+  int arrive_and_wait_result = ::Mdc_Latch_ArriveAndWait(
+      &this->latch_,
+      static_cast<int>(update)
+  );
+
+  if (arrive_and_wait_result != thrd_success) {
+    throw ::std::runtime_error("::std::latch::arrive_and_wait failure");
+  }
+}
+
+} // namespace std
+
+#endif // __cplusplus < 202002L && _MSVC_LANG < 202002L
@@ -35,14 +35,16 @@
 
 namespace std {
 
-const ::once_flag once_flag::kDefaultInit = ONCE_FLAG_INIT;
+once_flag::once_flag() throw() {
+  ::Mdc_OnceCell_Init(&this->once_cell_);
+}
 
-once_flag::once_flag() throw()
-    : once_flag_(kDefaultInit) {
+once_flag::~once_flag() {
+  ::Mdc_OnceCell_Deinit(&this->once_cell_);
 }
 
 void call_once(once_flag& flag, void (*func)(void)) {
-  ::call_once(&flag.once_flag_, func);
+  call_once<void (*)(void)>(flag, func);
 }
 
 } // namespace std
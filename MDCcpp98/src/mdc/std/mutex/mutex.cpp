@@ -52,7 +52,7 @@ void mutex::lock() {
 }
 
 bool mutex::try_lock() {
-  return !!::mtx_trylock(&this->mutex_);
+  return ::mtx_trylock(&this->mutex_) == thrd_success;
 }
 
 void mutex::unlock() {
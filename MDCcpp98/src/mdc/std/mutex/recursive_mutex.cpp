@@ -52,7 +52,7 @@ void recursive_mutex::lock() {
 }
 
 bool recursive_mutex::try_lock() {
-  return !!::mtx_trylock(&this->mutex_);
+  return ::mtx_trylock(&this->mutex_) == thrd_success;
 }
 
 void recursive_mutex::unlock() {
@@ -0,0 +1,88 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "../../../../include/mdc/std/shared_mutex.hpp"
+
+#if __cplusplus < 201703L && _MSVC_LANG < 201703L
+
+#include <stdexcept>
+
+namespace std {
+
+shared_mutex::shared_mutex() {
+  int init_result = ::Mdc_RwLock_Init(&this->rw_lock_);
+
+  if (init_result != thrd_success) {
+    throw ::std::runtime_error("::std::shared_mutex::shared_mutex failure");
+  }
+}
+
+shared_mutex::~shared_mutex() {
+  ::Mdc_RwLock_Deinit(&this->rw_lock_);
+}
+
+void shared_mutex::lock() {
+  int lock_result = ::Mdc_RwLock_Lock(&this->rw_lock_);
+
+  if (lock_result != thrd_success) {
+    throw ::std::runtime_error("::std::shared_mutex::lock failure");
+  }
+}
+
+bool shared_mutex::try_lock() {
+  return ::Mdc_RwLock_TryLock(&this->rw_lock_) == thrd_success;
+}
+
+void shared_mutex::unlock() {
+  ::Mdc_RwLock_Unlock(&this->rw_lock_);
+}
+
+void shared_mutex::lock_shared() {
+  int lock_shared_result = ::Mdc_RwLock_LockShared(&this->rw_lock_);
+
+  if (lock_shared_result != thrd_success) {
+    throw ::std::runtime_error("::std::shared_mutex::lock_shared failure");
+  }
+}
+
+bool shared_mutex::try_lock_shared() {
+  return ::Mdc_RwLock_TryLockShared(&this->rw_lock_) == thrd_success;
+}
+
+void shared_mutex::unlock_shared() {
+  ::Mdc_RwLock_UnlockShared(&this->rw_lock_);
+}
+
+shared_mutex::native_handle_type shared_mutex::native_handle() {
+  return &this->rw_lock_;
+}
+
+} // namespace std
+
+#endif // __cplusplus < 201703L && _MSVC_LANG < 201703L
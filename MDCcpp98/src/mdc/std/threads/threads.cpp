@@ -31,6 +31,7 @@
 
 #if __cplusplus < 201103L && _MSVC_LANG < 201103L
 
+#include <exception>
 #include <stdexcept>
 
 namespace std {
@@ -39,34 +40,160 @@ namespace std {
  * thread
  */
 
-thread::thread(int (*func)(void*), void* arg) {
-  int create_result = thrd_create(&this->thread_, func, arg);
+thread::thread() throw()
+    : is_joinable_(false) {
+}
 
-  if (create_result != thrd_success) {
-    throw ::std::runtime_error("::std::thread::thread failure");
+thread::thread(int (*func)(void*), void* arg)
+    : is_joinable_(false) {
+  this->Start(func, arg, NULL);
+}
+
+thread::thread(
+    int (*func)(void*),
+    void* arg,
+    const ::Mdc_ThrdAttributes& attributes
+) : is_joinable_(false) {
+  this->Start(func, arg, &attributes);
+}
+
+bool thread::joinable() const throw() {
+  return this->is_joinable_;
+}
+
+thread::id thread::get_id() const throw() {
+  if (!this->is_joinable_) {
+    return id();
   }
+
+  return id(::Mdc_Thrd_GetId(this->thread_));
+}
+
+thread::native_handle_type thread::native_handle() {
+  return this->thread_;
+}
+
+unsigned int thread::hardware_concurrency() throw() {
+  return static_cast<unsigned int>(::Mdc_Thrd_GetHardwareConcurrency());
 }
 
 void thread::join() {
   int result_code;
 
+  if (!this->is_joinable_) {
+    throw ::std::runtime_error("::std::thread::join failure");
+  }
+
   int join_result = thrd_join(this->thread_, &result_code);
 
   if (join_result != thrd_success) {
     throw ::std::runtime_error("::std::thread::join failure");
   }
+
+  this->is_joinable_ = false;
 }
 
 void thread::detach() {
+  if (!this->is_joinable_) {
+    throw ::std::runtime_error("::std::thread::detach failure");
+  }
+
   int detach_result = thrd_detach(this->thread_);
+
+  this->is_joinable_ = false;
 }
 
 void thread::swap(thread& other) throw() {
   thrd_t temp = this->thread_;
   this->thread_ = other.thread_;
   other.thread_ = temp;
+
+  bool temp_is_joinable = this->is_joinable_;
+  this->is_joinable_ = other.is_joinable_;
+  other.is_joinable_ = temp_is_joinable;
+}
+
+int thread::RunStartRoutine(void* start_routine) {
+  StartRoutine* routine = static_cast<StartRoutine*>(start_routine);
+
+  // Like C++11, an exception that escapes the thread terminates.
+  try {
+    routine->Run();
+  } catch (...) {
+    ::std::terminate();
+  }
+
+  delete routine;
+
+  return 0;
+}
+
+void thread::Start(StartRoutine* start_routine) {
+  int create_result = thrd_create(
+      &this->thread_,
+      &RunStartRoutine,
+      start_routine
+  );
+
+  if (create_result != thrd_success) {
+    delete start_routine;
+    throw ::std::runtime_error("::std::thread::thread failure");
+  }
+
+  this->is_joinable_ = true;
 }
 
+void thread::Start(
+    int (*func)(void*),
+    void* arg,
+    const ::Mdc_ThrdAttributes* attributes
+) {
+  int create_result = ::Mdc_Thrd_CreateEx(
+      &this->thread_,
+      func,
+      arg,
+      attributes
+  );
+
+  if (create_result != thrd_success) {
+    throw ::std::runtime_error("::std::thread::thread failure");
+  }
+
+  this->is_joinable_ = true;
+}
+
+/**
+ * this_thread
+ */
+
+namespace this_thread {
+
+thread::id get_id() throw() {
+  return thread::id(::Mdc_Thrd_GetCurrentId());
+}
+
+void yield() throw() {
+  thrd_yield();
+}
+
+void sleep_for(const chrono::nanoseconds& rel_time) {
+  chrono::duration_rep_type count = rel_time.count();
+
+  if (count <= 0) {
+    return;
+  }
+
+  struct timespec duration;
+  duration.tv_sec = static_cast<time_t>(count / 1000000000);
+  duration.tv_nsec = static_cast<long>(count % 1000000000);
+
+  // Resume with the remaining time if interrupted by a signal.
+  while (thrd_sleep(&duration, &duration) == -1) {
+  }
+}
+
+} // namespace this_thread
+
 } // namespace std
 
 #endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
@@ -148,6 +148,106 @@ LINK32=link.exe
 # Begin Group "mdc"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\barrier_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\barrier_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\latch_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\latch_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mcs_lock_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mcs_lock_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mpmc_queue_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mpmc_queue_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mtx_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mtx_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\once_cell_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\once_cell_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\rw_lock_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\rw_lock_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\semaphore_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\semaphore_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\spsc_ring_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\spsc_ring_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thrd_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thrd_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_local_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_local_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_pool_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_pool_tests.h
+# End Source File
+# End Group
 # Begin Group "error"
 
 # PROP Default_Filter ""
@@ -160,6 +260,34 @@ SOURCE=.\tests\mdc\error\exit_on_error_tests.c
 SOURCE=.\tests\mdc\error\exit_on_error_tests.h
 # End Source File
 # End Group
+# Begin Group "malloc"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\arena_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\arena_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\malloc_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\malloc_tests.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\pool_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\pool_tests.h
+# End Source File
+# End Group
 # Begin Group "std"
 
 # PROP Default_Filter ""
@@ -173,6 +301,14 @@ SOURCE=.\tests\mdc\std\assert_tests.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\tests\mdc\std\stdatomic_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\stdatomic_tests.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\std\stdbool_tests.c
 # End Source File
 # Begin Source File
@@ -238,6 +374,14 @@ SOURCE=.\tests\mdc\wchar_t\wide_encoding_tests.h
 # End Group
 # Begin Source File
 
+SOURCE=.\tests\mdc\concurrency_tests.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency_tests.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\error_tests.c
 # End Source File
 # Begin Source File
@@ -258,6 +402,14 @@ SOURCE=.\tests\mdc\std_tests.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\tests\mdc\test_deadline.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\test_deadline.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\wchar_t_tests.c
 # End Source File
 # Begin Source File
@@ -0,0 +1,241 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "barrier_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/barrier.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 4,
+  kPhasesCount = 100
+};
+
+struct PhasedWork {
+  struct Mdc_Barrier barrier;
+  int completed_phases_count;
+};
+
+static void CountPhase(void* context) {
+  int* completed_phases_count = context;
+
+  *completed_phases_count += 1;
+}
+
+static int RunPhases(void* arg) {
+  struct PhasedWork* work = arg;
+  int i;
+  int arrive_and_wait_result;
+
+  for (i = 0; i < kPhasesCount; ++i) {
+    arrive_and_wait_result = Mdc_Barrier_ArriveAndWait(&work->barrier);
+    assert(arrive_and_wait_result == thrd_success);
+
+    /* The next phase cannot complete until this thread arrives. */
+    assert(work->completed_phases_count == i + 1);
+  }
+
+  return 0;
+}
+
+static int ArriveAndWait(void* arg) {
+  struct Mdc_Barrier* barrier = arg;
+  int arrive_and_wait_result;
+
+  arrive_and_wait_result = Mdc_Barrier_ArriveAndWait(barrier);
+  assert(arrive_and_wait_result == thrd_success);
+
+  return 0;
+}
+
+static int ArriveAndDrop(void* arg) {
+  struct Mdc_Barrier* barrier = arg;
+  int arrive_and_drop_result;
+
+  arrive_and_drop_result = Mdc_Barrier_ArriveAndDrop(barrier);
+  assert(arrive_and_drop_result == thrd_success);
+
+  return 0;
+}
+
+static void RunInThread(thrd_start_t func, struct Mdc_Barrier* barrier) {
+  thrd_t thread;
+  int thread_create_result;
+  int thread_join_result;
+
+  thread_create_result = thrd_create(&thread, func, barrier);
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+}
+
+static void Mdc_Barrier_AssertPhases(void) {
+  struct PhasedWork work;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  work.completed_phases_count = 0;
+
+  init_result = Mdc_Barrier_Init(
+      &work.barrier,
+      kThreadsCount,
+      &CountPhase,
+      &work.completed_phases_count
+  );
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(&threads[i], &RunPhases, &work);
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(work.completed_phases_count == kPhasesCount);
+
+  Mdc_Barrier_Deinit(&work.barrier);
+}
+
+static void Mdc_Barrier_AssertArriveAndWaitSeparately(void) {
+  struct Mdc_Barrier barrier;
+  thrd_t thread;
+  int phase;
+
+  int init_result;
+  int arrive_result;
+  int wait_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_Barrier_Init(&barrier, 3, NULL, NULL);
+  assert(init_result == thrd_success);
+
+  arrive_result = Mdc_Barrier_Arrive(&barrier, 2, &phase);
+  assert(arrive_result == thrd_success);
+
+  thread_create_result = thrd_create(&thread, &ArriveAndWait, &barrier);
+  assert(thread_create_result == thrd_success);
+
+  wait_result = Mdc_Barrier_Wait(&barrier, phase);
+  assert(wait_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  Mdc_Barrier_Deinit(&barrier);
+}
+
+static void Mdc_Barrier_AssertArriveTooMany(void) {
+  struct Mdc_Barrier barrier;
+  int completed_phases_count;
+  int phase;
+
+  int init_result;
+  int arrive_result;
+  int wait_result;
+
+  completed_phases_count = 0;
+
+  init_result = Mdc_Barrier_Init(
+      &barrier,
+      2,
+      &CountPhase,
+      &completed_phases_count
+  );
+  assert(init_result == thrd_success);
+
+  arrive_result = Mdc_Barrier_Arrive(&barrier, 3, &phase);
+  assert(arrive_result == thrd_error);
+
+  /* The rejected arrival left the phase's count untouched. */
+  arrive_result = Mdc_Barrier_Arrive(&barrier, 1, &phase);
+  assert(arrive_result == thrd_success);
+  assert(completed_phases_count == 0);
+
+  arrive_result = Mdc_Barrier_Arrive(&barrier, 2, &phase);
+  assert(arrive_result == thrd_error);
+
+  arrive_result = Mdc_Barrier_Arrive(&barrier, 1, &phase);
+  assert(arrive_result == thrd_success);
+  assert(completed_phases_count == 1);
+
+  wait_result = Mdc_Barrier_Wait(&barrier, phase);
+  assert(wait_result == thrd_success);
+
+  Mdc_Barrier_Deinit(&barrier);
+}
+
+static void Mdc_Barrier_AssertArriveAndDrop(void) {
+  struct Mdc_Barrier barrier;
+  int completed_phases_count;
+
+  int init_result;
+  int arrive_and_wait_result;
+
+  completed_phases_count = 0;
+
+  init_result = Mdc_Barrier_Init(
+      &barrier,
+      2,
+      &CountPhase,
+      &completed_phases_count
+  );
+  assert(init_result == thrd_success);
+
+  RunInThread(&ArriveAndDrop, &barrier);
+
+  arrive_and_wait_result = Mdc_Barrier_ArriveAndWait(&barrier);
+  assert(arrive_and_wait_result == thrd_success);
+
+  /* Later phases only expect the remaining thread. */
+  arrive_and_wait_result = Mdc_Barrier_ArriveAndWait(&barrier);
+  assert(arrive_and_wait_result == thrd_success);
+
+  assert(completed_phases_count == 2);
+
+  Mdc_Barrier_Deinit(&barrier);
+}
+
+void Mdc_Barrier_RunTests(void) {
+  Mdc_Barrier_AssertPhases();
+  Mdc_Barrier_AssertArriveAndWaitSeparately();
+  Mdc_Barrier_AssertArriveTooMany();
+  Mdc_Barrier_AssertArriveAndDrop();
+}
@@ -0,0 +1,171 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "latch_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/latch.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 4
+};
+
+struct Workers {
+  struct Mdc_Latch latch;
+  int is_done[kThreadsCount];
+};
+
+struct WorkerArgs {
+  struct Workers* workers;
+  size_t index;
+};
+
+static int WorkThenWait(void* arg) {
+  struct WorkerArgs* args = arg;
+  struct Workers* workers = args->workers;
+  size_t i;
+  int arrive_and_wait_result;
+
+  workers->is_done[args->index] = 1;
+
+  arrive_and_wait_result = Mdc_Latch_ArriveAndWait(&workers->latch, 1);
+  assert(arrive_and_wait_result == thrd_success);
+
+  /* Every worker's write happened before the latch opened. */
+  for (i = 0; i < kThreadsCount; ++i) {
+    assert(workers->is_done[i]);
+  }
+
+  return 0;
+}
+
+static void Mdc_Latch_AssertCountDown(void) {
+  struct Mdc_Latch latch;
+
+  int init_result;
+  int count_down_result;
+  int wait_result;
+
+  init_result = Mdc_Latch_Init(&latch, 3);
+  assert(init_result == thrd_success);
+
+  assert(!Mdc_Latch_TryWait(&latch));
+
+  count_down_result = Mdc_Latch_CountDown(&latch, 2);
+  assert(count_down_result == thrd_success);
+
+  assert(!Mdc_Latch_TryWait(&latch));
+
+  count_down_result = Mdc_Latch_CountDown(&latch, 1);
+  assert(count_down_result == thrd_success);
+
+  assert(Mdc_Latch_TryWait(&latch));
+
+  wait_result = Mdc_Latch_Wait(&latch);
+  assert(wait_result == thrd_success);
+
+  Mdc_Latch_Deinit(&latch);
+}
+
+static void Mdc_Latch_AssertCountDownTooFar(void) {
+  struct Mdc_Latch latch;
+
+  int init_result;
+  int count_down_result;
+
+  init_result = Mdc_Latch_Init(&latch, 2);
+  assert(init_result == thrd_success);
+
+  count_down_result = Mdc_Latch_CountDown(&latch, 3);
+  assert(count_down_result == thrd_error);
+
+  /* The rejected count down left the count untouched. */
+  count_down_result = Mdc_Latch_CountDown(&latch, 1);
+  assert(count_down_result == thrd_success);
+
+  assert(!Mdc_Latch_TryWait(&latch));
+
+  count_down_result = Mdc_Latch_CountDown(&latch, 1);
+  assert(count_down_result == thrd_success);
+
+  assert(Mdc_Latch_TryWait(&latch));
+
+  count_down_result = Mdc_Latch_CountDown(&latch, 1);
+  assert(count_down_result == thrd_error);
+
+  assert(Mdc_Latch_TryWait(&latch));
+
+  Mdc_Latch_Deinit(&latch);
+}
+
+static void Mdc_Latch_AssertWaitersReleased(void) {
+  struct Workers workers;
+  struct WorkerArgs args[kThreadsCount];
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int init_result;
+  int wait_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_Latch_Init(&workers.latch, kThreadsCount);
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    workers.is_done[i] = 0;
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    args[i].workers = &workers;
+    args[i].index = i;
+
+    thread_create_result = thrd_create(&threads[i], &WorkThenWait, &args[i]);
+    assert(thread_create_result == thrd_success);
+  }
+
+  wait_result = Mdc_Latch_Wait(&workers.latch);
+  assert(wait_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  Mdc_Latch_Deinit(&workers.latch);
+}
+
+void Mdc_Latch_RunTests(void) {
+  Mdc_Latch_AssertCountDown();
+  Mdc_Latch_AssertCountDownTooFar();
+  Mdc_Latch_AssertWaitersReleased();
+}
@@ -0,0 +1,127 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mcs_lock_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/mcs_lock.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 8,
+  kIncrementsPerThread = 10000
+};
+
+struct Counter {
+  struct Mdc_McsLock lock;
+  int holders_count;
+  int value;
+};
+
+static int IncrementCounter(void* arg) {
+  struct Counter* counter = arg;
+  int i;
+
+  for (i = 0; i < kIncrementsPerThread; ++i) {
+    Mdc_McsLock_Lock(&counter->lock);
+
+    counter->holders_count += 1;
+    assert(counter->holders_count == 1);
+
+    counter->value += 1;
+
+    counter->holders_count -= 1;
+    Mdc_McsLock_Unlock(&counter->lock);
+  }
+
+  return 0;
+}
+
+static void Mdc_McsLock_AssertTryLock(void) {
+  struct Mdc_McsLock lock;
+
+  int try_lock_result;
+
+  Mdc_McsLock_Init(&lock);
+
+  try_lock_result = Mdc_McsLock_TryLock(&lock);
+  assert(try_lock_result == thrd_success);
+
+  try_lock_result = Mdc_McsLock_TryLock(&lock);
+  assert(try_lock_result == thrd_busy);
+
+  Mdc_McsLock_Unlock(&lock);
+
+  Mdc_McsLock_Lock(&lock);
+
+  try_lock_result = Mdc_McsLock_TryLock(&lock);
+  assert(try_lock_result == thrd_busy);
+
+  Mdc_McsLock_Unlock(&lock);
+
+  Mdc_McsLock_Deinit(&lock);
+}
+
+static void Mdc_McsLock_AssertMutualExclusion(void) {
+  struct Counter counter;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  Mdc_McsLock_Init(&counter.lock);
+  counter.holders_count = 0;
+  counter.value = 0;
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &IncrementCounter,
+        &counter
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(counter.value == kThreadsCount * kIncrementsPerThread);
+
+  Mdc_McsLock_Deinit(&counter.lock);
+}
+
+void Mdc_McsLock_RunTests(void) {
+  Mdc_McsLock_AssertTryLock();
+  Mdc_McsLock_AssertMutualExclusion();
+}
@@ -0,0 +1,292 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mpmc_queue_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <time.h>
+
+#include <mdc/concurrency/mpmc_queue.h>
+#include <mdc/std/threads.h>
+
+#include "../test_deadline.h"
+
+enum {
+  kCapacity = 8,
+  kProducersCount = 4,
+  kConsumersCount = 4,
+  kElementsPerProducer = 20000
+};
+
+struct SharedQueue {
+  struct Mdc_MpmcQueue queue;
+
+  mtx_t mutex;
+  long popped_sum;
+  long popped_count;
+};
+
+static int PushElements(void* arg) {
+  struct SharedQueue* shared_queue = arg;
+  long value;
+  int push_result;
+
+  for (value = 1; value <= kElementsPerProducer; value += 1) {
+    push_result = Mdc_MpmcQueue_Push(&shared_queue->queue, &value);
+    assert(push_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static int PopElements(void* arg) {
+  struct SharedQueue* shared_queue = arg;
+  long value;
+  long sum;
+  size_t i;
+  int pop_result;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+
+  enum {
+    kElementsPerConsumer =
+        kProducersCount * kElementsPerProducer / kConsumersCount
+  };
+
+  sum = 0;
+  for (i = 0; i < kElementsPerConsumer; i += 1) {
+    pop_result = Mdc_MpmcQueue_Pop(&shared_queue->queue, &value);
+    assert(pop_result == thrd_success);
+
+    sum += value;
+  }
+
+  mtx_lock_result = mtx_lock(&shared_queue->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  shared_queue->popped_sum += sum;
+  shared_queue->popped_count += kElementsPerConsumer;
+
+  mtx_unlock_result = mtx_unlock(&shared_queue->mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  return 0;
+}
+
+static void Mdc_MpmcQueue_AssertTryPushPop(void) {
+  struct Mdc_MpmcQueue queue;
+  long value;
+  size_t lap;
+  size_t i;
+  int init_result;
+
+  init_result = Mdc_MpmcQueue_Init(
+      &queue,
+      sizeof(value),
+      kCapacity - 1,
+      Mdc_MpmcQueue_kPlain
+  );
+  assert(init_result == thrd_success);
+  assert(Mdc_MpmcQueue_GetCapacity(&queue) == kCapacity);
+
+  assert(!Mdc_MpmcQueue_TryPop(&queue, &value));
+
+  /* Fill and drain several times, so that the slots are reused. */
+  for (lap = 0; lap < 3; lap += 1) {
+    for (i = 0; i < kCapacity; i += 1) {
+      value = (long) (lap * kCapacity + i);
+      assert(Mdc_MpmcQueue_TryPush(&queue, &value));
+    }
+
+    assert(!Mdc_MpmcQueue_TryPush(&queue, &value));
+
+    for (i = 0; i < kCapacity; i += 1) {
+      assert(Mdc_MpmcQueue_TryPop(&queue, &value));
+      assert(value == (long) (lap * kCapacity + i));
+    }
+
+    assert(!Mdc_MpmcQueue_TryPop(&queue, &value));
+  }
+
+  /* A plain queue cannot wait. */
+  assert(Mdc_MpmcQueue_Pop(&queue, &value) == thrd_error);
+
+  Mdc_MpmcQueue_Deinit(&queue);
+}
+
+static void Mdc_MpmcQueue_AssertTimeout(void) {
+  struct Mdc_MpmcQueue queue;
+  struct timespec time_point;
+  long value;
+  size_t i;
+
+  int init_result;
+  int timed_pop_result;
+  int timed_push_result;
+
+  init_result = Mdc_MpmcQueue_Init(
+      &queue,
+      sizeof(value),
+      kCapacity,
+      Mdc_MpmcQueue_kBlocking
+  );
+  assert(init_result == thrd_success);
+
+  Mdc_TestDeadline_Get(&time_point);
+  timed_pop_result = Mdc_MpmcQueue_TimedPop(&queue, &value, &time_point);
+  assert(timed_pop_result == thrd_timedout);
+
+  for (i = 0; i < kCapacity; i += 1) {
+    value = (long) i;
+
+    Mdc_TestDeadline_Get(&time_point);
+    timed_push_result = Mdc_MpmcQueue_TimedPush(
+        &queue,
+        &value,
+        &time_point
+    );
+    assert(timed_push_result == thrd_success);
+  }
+
+  Mdc_TestDeadline_Get(&time_point);
+  timed_push_result = Mdc_MpmcQueue_TimedPush(&queue, &value, &time_point);
+  assert(timed_push_result == thrd_timedout);
+
+  Mdc_TestDeadline_Get(&time_point);
+  timed_pop_result = Mdc_MpmcQueue_TimedPop(&queue, &value, &time_point);
+  assert(timed_pop_result == thrd_success);
+  assert(value == 0);
+
+  Mdc_MpmcQueue_Deinit(&queue);
+}
+
+static void Mdc_MpmcQueue_AssertConcurrentPushPop(void) {
+  struct SharedQueue shared_queue;
+  thrd_t producers[kProducersCount];
+  thrd_t consumers[kConsumersCount];
+  size_t i;
+
+  int init_result;
+  int mtx_init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_MpmcQueue_Init(
+      &shared_queue.queue,
+      sizeof(long),
+      kCapacity,
+      Mdc_MpmcQueue_kBlocking
+  );
+  assert(init_result == thrd_success);
+
+  mtx_init_result = mtx_init(&shared_queue.mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  shared_queue.popped_sum = 0;
+  shared_queue.popped_count = 0;
+
+  for (i = 0; i < kConsumersCount; i += 1) {
+    thread_create_result = thrd_create(
+        &consumers[i],
+        &PopElements,
+        &shared_queue
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kProducersCount; i += 1) {
+    thread_create_result = thrd_create(
+        &producers[i],
+        &PushElements,
+        &shared_queue
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kProducersCount; i += 1) {
+    thread_join_result = thrd_join(producers[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  for (i = 0; i < kConsumersCount; i += 1) {
+    thread_join_result = thrd_join(consumers[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(shared_queue.popped_count == kProducersCount * kElementsPerProducer);
+  assert(
+      shared_queue.popped_sum
+          == (long) kProducersCount
+              * kElementsPerProducer * (kElementsPerProducer + 1) / 2
+  );
+
+  mtx_destroy(&shared_queue.mutex);
+  Mdc_MpmcQueue_Deinit(&shared_queue.queue);
+}
+
+static void Mdc_MpmcQueue_AssertCapacityOverflow(void) {
+  struct Mdc_MpmcQueue queue;
+
+  int init_result;
+
+  /* No power of two fits in a size_t. */
+  init_result = Mdc_MpmcQueue_Init(
+      &queue,
+      sizeof(long),
+      (size_t) -1,
+      Mdc_MpmcQueue_kPlain
+  );
+  assert(init_result == thrd_error);
+
+  /* The power of two fits, but the size of the slots does not. */
+  init_result = Mdc_MpmcQueue_Init(
+      &queue,
+      sizeof(long),
+      (size_t) -1 / 2 + 1,
+      Mdc_MpmcQueue_kPlain
+  );
+  assert(init_result == thrd_error);
+
+  /* The slot size of the element does not fit in a size_t. */
+  init_result = Mdc_MpmcQueue_Init(
+      &queue,
+      (size_t) -1,
+      kCapacity,
+      Mdc_MpmcQueue_kPlain
+  );
+  assert(init_result == thrd_error);
+}
+
+void Mdc_MpmcQueue_RunTests(void) {
+  Mdc_MpmcQueue_AssertTryPushPop();
+  Mdc_MpmcQueue_AssertTimeout();
+  Mdc_MpmcQueue_AssertConcurrentPushPop();
+  Mdc_MpmcQueue_AssertCapacityOverflow();
+}
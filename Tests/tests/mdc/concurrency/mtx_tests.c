@@ -0,0 +1,354 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mtx_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <mdc/concurrency/latch.h>
+#include <mdc/concurrency/mtx.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kSpinCount = 1000,
+
+  kThreadsCount = 8,
+  kIncrementsCount = 10000,
+
+  kHolderYieldsCount = 100
+};
+
+struct AdaptiveCounter {
+  mtx_t mutex;
+  long value;
+};
+
+struct ProfiledHolder {
+  mtx_t* mutex;
+  struct Mdc_Latch locked_latch;
+  struct Mdc_Latch waiting_latch;
+};
+
+static int IncrementAdaptiveCounter(void* arg) {
+  struct AdaptiveCounter* counter = arg;
+  size_t i;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    mtx_lock_result = mtx_lock(&counter->mutex);
+    assert(mtx_lock_result == thrd_success);
+
+    counter->value += 1;
+
+    mtx_unlock_result = mtx_unlock(&counter->mutex);
+    assert(mtx_unlock_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static int TryLockSpinExpectBusy(void* arg) {
+  mtx_t* mutex = arg;
+  int try_lock_spin_result;
+
+  try_lock_spin_result = Mdc_Mtx_TryLockSpin(mutex, kSpinCount);
+  assert(try_lock_spin_result == thrd_busy);
+
+  return 0;
+}
+
+/*
+* Holds the mutex until the main thread is about to lock it, then
+* yields so that the main thread's attempt finds the mutex held.
+*/
+static int HoldProfiledMutex(void* arg) {
+  struct ProfiledHolder* holder = arg;
+  size_t i;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+
+  mtx_lock_result = mtx_lock(holder->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  Mdc_Latch_CountDown(&holder->locked_latch, 1);
+  Mdc_Latch_Wait(&holder->waiting_latch);
+
+  for (i = 0; i < kHolderYieldsCount; ++i) {
+    thrd_yield();
+  }
+
+  mtx_unlock_result = mtx_unlock(holder->mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  return 0;
+}
+
+static uint64_t SumHistogram(const uint64_t* histogram) {
+  uint64_t sum;
+  size_t i;
+
+  sum = 0;
+  for (i = 0; i < Mdc_Mtx_kProfileHistogramBucketsCount; ++i) {
+    sum += histogram[i];
+  }
+
+  return sum;
+}
+
+static void Mdc_Mtx_AssertTryLockSpinSuccess(void) {
+  mtx_t mutex;
+
+  int mtx_init_result;
+  int try_lock_spin_result;
+  int mtx_unlock_result;
+
+  mtx_init_result = mtx_init(&mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  try_lock_spin_result = Mdc_Mtx_TryLockSpin(&mutex, kSpinCount);
+  assert(try_lock_spin_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  mtx_destroy(&mutex);
+}
+
+static void Mdc_Mtx_AssertTryLockSpinBusy(void) {
+  mtx_t mutex;
+  thrd_t thread;
+
+  int mtx_init_result;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  mtx_lock_result = mtx_lock(&mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  thread_create_result = thrd_create(
+      &thread,
+      &TryLockSpinExpectBusy,
+      &mutex
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  mtx_destroy(&mutex);
+}
+
+static void AssertAdaptiveCounter(int type) {
+  struct AdaptiveCounter counter;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int mtx_init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&counter.mutex, type);
+  assert(mtx_init_result == thrd_success);
+
+  counter.value = 0;
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &IncrementAdaptiveCounter,
+        &counter
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(counter.value == kThreadsCount * kIncrementsCount);
+
+  mtx_destroy(&counter.mutex);
+}
+
+static void Mdc_Mtx_AssertAdaptiveMutex(void) {
+  unsigned int spin_limit;
+
+  AssertAdaptiveCounter(mtx_plain | mtx_adaptive);
+  AssertAdaptiveCounter(mtx_timed | mtx_adaptive);
+  AssertAdaptiveCounter(mtx_plain | mtx_recursive | mtx_adaptive);
+
+  spin_limit = Mdc_Mtx_GetAdaptiveSpinLimit();
+
+  /* Without spinning, an adaptive mutex behaves like a plain one. */
+  Mdc_Mtx_SetAdaptiveSpinLimit(0);
+  assert(Mdc_Mtx_GetAdaptiveSpinLimit() == 0);
+
+  AssertAdaptiveCounter(mtx_plain | mtx_adaptive);
+
+  Mdc_Mtx_SetAdaptiveSpinLimit(spin_limit);
+}
+
+static void Mdc_Mtx_AssertProfile(void) {
+  mtx_t mutex;
+  struct Mdc_MtxProfileStats stats;
+  struct ProfiledHolder holder;
+  thrd_t thread;
+  FILE* report_file;
+
+  int mtx_init_result;
+  int latch_init_result;
+  int register_result;
+  int get_stats_result;
+  int mtx_lock_result;
+  int mtx_trylock_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+  int print_report_result;
+
+  mtx_init_result = mtx_init(&mutex, mtx_plain | mtx_recursive);
+  assert(mtx_init_result == thrd_success);
+
+  register_result = Mdc_Mtx_RegisterProfile(&mutex, "profiled");
+  assert(register_result == thrd_success);
+
+  register_result = Mdc_Mtx_RegisterProfile(&mutex, "profiled again");
+  assert(register_result == thrd_error);
+
+  /* Nothing is recorded until profiling is enabled. */
+  assert(!Mdc_Mtx_IsProfilingEnabled());
+
+  mtx_lock_result = mtx_lock(&mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  Mdc_Mtx_SetProfilingEnabled(1);
+  assert(Mdc_Mtx_IsProfilingEnabled());
+
+  /* A recursive relock is an acquisition, but not a separate hold. */
+  mtx_lock_result = mtx_lock(&mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  mtx_trylock_result = mtx_trylock(&mutex);
+  assert(mtx_trylock_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  get_stats_result = Mdc_Mtx_GetProfileStats(&mutex, &stats);
+  assert(get_stats_result == thrd_success);
+
+  assert(stats.acquisitions_count == 2);
+  assert(stats.contended_count == 0);
+  assert(SumHistogram(stats.wait_histogram) == 0);
+  assert(SumHistogram(stats.hold_histogram) == 1);
+
+  /* The main thread's lock finds the mutex held by the other thread. */
+  holder.mutex = &mutex;
+
+  latch_init_result = Mdc_Latch_Init(&holder.locked_latch, 1);
+  assert(latch_init_result == thrd_success);
+
+  latch_init_result = Mdc_Latch_Init(&holder.waiting_latch, 1);
+  assert(latch_init_result == thrd_success);
+
+  thread_create_result = thrd_create(&thread, &HoldProfiledMutex, &holder);
+  assert(thread_create_result == thrd_success);
+
+  Mdc_Latch_Wait(&holder.locked_latch);
+  Mdc_Latch_CountDown(&holder.waiting_latch, 1);
+
+  mtx_lock_result = mtx_lock(&mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  Mdc_Latch_Deinit(&holder.waiting_latch);
+  Mdc_Latch_Deinit(&holder.locked_latch);
+
+  get_stats_result = Mdc_Mtx_GetProfileStats(&mutex, &stats);
+  assert(get_stats_result == thrd_success);
+
+  assert(stats.acquisitions_count == 4);
+  assert(stats.contended_count == 1);
+  assert(SumHistogram(stats.wait_histogram) == 1);
+  assert(SumHistogram(stats.hold_histogram) == 3);
+
+  report_file = tmpfile();
+  assert(report_file != NULL);
+
+  print_report_result = Mdc_Mtx_PrintProfileReport(report_file);
+  assert(print_report_result == thrd_success);
+  assert(ftell(report_file) > 0);
+
+  fclose(report_file);
+
+  Mdc_Mtx_ResetProfiles();
+
+  get_stats_result = Mdc_Mtx_GetProfileStats(&mutex, &stats);
+  assert(get_stats_result == thrd_success);
+  assert(stats.acquisitions_count == 0);
+
+  Mdc_Mtx_SetProfilingEnabled(0);
+  assert(!Mdc_Mtx_IsProfilingEnabled());
+
+  /* Destroying the mutex unregisters it. */
+  mtx_destroy(&mutex);
+
+  get_stats_result = Mdc_Mtx_GetProfileStats(&mutex, &stats);
+  assert(get_stats_result == thrd_error);
+}
+
+void Mdc_Mtx_RunTests(void) {
+  Mdc_Mtx_AssertTryLockSpinSuccess();
+  Mdc_Mtx_AssertTryLockSpinBusy();
+  Mdc_Mtx_AssertAdaptiveMutex();
+  Mdc_Mtx_AssertProfile();
+}
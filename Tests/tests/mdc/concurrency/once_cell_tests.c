@@ -0,0 +1,184 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "once_cell_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/once_cell.h>
+#include <mdc/std/stdatomic.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 8,
+  kGetsCount = 1000,
+  kInitYieldsCount = 16
+};
+
+struct Singleton {
+  struct Mdc_OnceCell cell;
+  atomic_int init_count;
+  int is_failing;
+  int value;
+};
+
+static struct Mdc_OnceCell static_cell = MDC_ONCE_CELL_INIT;
+
+static void* InitSingleton(void* context) {
+  struct Singleton* singleton = context;
+  size_t i;
+
+  atomic_fetch_add_explicit(&singleton->init_count, 1, memory_order_relaxed);
+
+  /* Give the other threads time to block on the cell. */
+  for (i = 0; i < kInitYieldsCount; ++i) {
+    thrd_yield();
+  }
+
+  if (singleton->is_failing) {
+    return NULL;
+  }
+
+  singleton->value = 42;
+
+  return &singleton->value;
+}
+
+static int GetSingleton(void* arg) {
+  struct Singleton* singleton = arg;
+  int* value;
+  size_t i;
+
+  for (i = 0; i < kGetsCount; ++i) {
+    value = MDC_ONCE_CELL_GET(&singleton->cell, &InitSingleton, singleton);
+    assert(value == &singleton->value);
+    assert(*value == 42);
+  }
+
+  return 0;
+}
+
+static void Mdc_OnceCell_AssertGet(void) {
+  struct Singleton singleton;
+  void* value;
+
+  Mdc_OnceCell_Init(&singleton.cell);
+  atomic_init(&singleton.init_count, 0);
+  singleton.is_failing = 0;
+
+  assert(!Mdc_OnceCell_IsReady(&singleton.cell));
+  assert(Mdc_OnceCell_TryGet(&singleton.cell) == NULL);
+
+  value = Mdc_OnceCell_Get(&singleton.cell, &InitSingleton, &singleton);
+  assert(value == &singleton.value);
+
+  value = MDC_ONCE_CELL_GET(&singleton.cell, &InitSingleton, &singleton);
+  assert(value == &singleton.value);
+
+  assert(Mdc_OnceCell_IsReady(&singleton.cell));
+  assert(Mdc_OnceCell_TryGet(&singleton.cell) == &singleton.value);
+  assert(singleton.init_count == 1);
+
+  Mdc_OnceCell_Deinit(&singleton.cell);
+}
+
+static void Mdc_OnceCell_AssertStaticInit(void) {
+  struct Singleton singleton;
+  void* value;
+
+  atomic_init(&singleton.init_count, 0);
+  singleton.is_failing = 0;
+
+  value = MDC_ONCE_CELL_GET(&static_cell, &InitSingleton, &singleton);
+  assert(value == &singleton.value);
+
+  value = MDC_ONCE_CELL_GET(&static_cell, &InitSingleton, &singleton);
+  assert(value == &singleton.value);
+  assert(singleton.init_count == 1);
+}
+
+static void Mdc_OnceCell_AssertFailureRetries(void) {
+  struct Singleton singleton;
+  void* value;
+
+  Mdc_OnceCell_Init(&singleton.cell);
+  atomic_init(&singleton.init_count, 0);
+  singleton.is_failing = 1;
+
+  value = Mdc_OnceCell_Get(&singleton.cell, &InitSingleton, &singleton);
+  assert(value == NULL);
+  assert(!Mdc_OnceCell_IsReady(&singleton.cell));
+
+  singleton.is_failing = 0;
+
+  value = Mdc_OnceCell_Get(&singleton.cell, &InitSingleton, &singleton);
+  assert(value == &singleton.value);
+  assert(singleton.init_count == 2);
+
+  Mdc_OnceCell_Deinit(&singleton.cell);
+}
+
+static void Mdc_OnceCell_AssertConcurrentGet(void) {
+  struct Singleton singleton;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  Mdc_OnceCell_Init(&singleton.cell);
+  atomic_init(&singleton.init_count, 0);
+  singleton.is_failing = 0;
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &GetSingleton,
+        &singleton
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(singleton.init_count == 1);
+
+  Mdc_OnceCell_Deinit(&singleton.cell);
+}
+
+void Mdc_OnceCell_RunTests(void) {
+  Mdc_OnceCell_AssertGet();
+  Mdc_OnceCell_AssertStaticInit();
+  Mdc_OnceCell_AssertFailureRetries();
+  Mdc_OnceCell_AssertConcurrentGet();
+}
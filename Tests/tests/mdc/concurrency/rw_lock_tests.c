@@ -0,0 +1,247 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "rw_lock_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <time.h>
+
+#include <mdc/concurrency/rw_lock.h>
+#include <mdc/std/threads.h>
+
+#include "../test_deadline.h"
+
+enum {
+  kWritersCount = 4,
+  kIncrementsCount = 1000
+};
+
+struct GuardedPair {
+  struct Mdc_RwLock rw_lock;
+  long first;
+  long second;
+};
+
+static int TryLockSharedExpectSuccess(void* arg) {
+  struct Mdc_RwLock* rw_lock = arg;
+  int try_lock_shared_result;
+  int unlock_shared_result;
+
+  try_lock_shared_result = Mdc_RwLock_TryLockShared(rw_lock);
+  assert(try_lock_shared_result == thrd_success);
+
+  unlock_shared_result = Mdc_RwLock_UnlockShared(rw_lock);
+  assert(unlock_shared_result == thrd_success);
+
+  return 0;
+}
+
+static int TryLockExpectBusy(void* arg) {
+  struct Mdc_RwLock* rw_lock = arg;
+  int try_lock_result;
+
+  try_lock_result = Mdc_RwLock_TryLock(rw_lock);
+  assert(try_lock_result == thrd_busy);
+
+  return 0;
+}
+
+static int TryLockSharedExpectBusy(void* arg) {
+  struct Mdc_RwLock* rw_lock = arg;
+  int try_lock_shared_result;
+
+  try_lock_shared_result = Mdc_RwLock_TryLockShared(rw_lock);
+  assert(try_lock_shared_result == thrd_busy);
+
+  return 0;
+}
+
+static int TimedLockExpectTimeout(void* arg) {
+  struct Mdc_RwLock* rw_lock = arg;
+  struct timespec time_point;
+  int timed_lock_result;
+
+  Mdc_TestDeadline_Get(&time_point);
+
+  timed_lock_result = Mdc_RwLock_TimedLock(rw_lock, &time_point);
+  assert(timed_lock_result == thrd_timedout);
+
+  return 0;
+}
+
+static int TimedLockSharedExpectTimeout(void* arg) {
+  struct Mdc_RwLock* rw_lock = arg;
+  struct timespec time_point;
+  int timed_lock_shared_result;
+
+  Mdc_TestDeadline_Get(&time_point);
+
+  timed_lock_shared_result = Mdc_RwLock_TimedLockShared(
+      rw_lock,
+      &time_point
+  );
+  assert(timed_lock_shared_result == thrd_timedout);
+
+  return 0;
+}
+
+static int IncrementPair(void* arg) {
+  struct GuardedPair* pair = arg;
+  size_t i;
+  int lock_result;
+  int unlock_result;
+  int lock_shared_result;
+  int unlock_shared_result;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    lock_result = Mdc_RwLock_Lock(&pair->rw_lock);
+    assert(lock_result == thrd_success);
+
+    pair->first += 1;
+    pair->second += 1;
+
+    unlock_result = Mdc_RwLock_Unlock(&pair->rw_lock);
+    assert(unlock_result == thrd_success);
+
+    lock_shared_result = Mdc_RwLock_LockShared(&pair->rw_lock);
+    assert(lock_shared_result == thrd_success);
+
+    assert(pair->first == pair->second);
+
+    unlock_shared_result = Mdc_RwLock_UnlockShared(&pair->rw_lock);
+    assert(unlock_shared_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static void RunInThread(thrd_start_t func, struct Mdc_RwLock* rw_lock) {
+  thrd_t thread;
+  int thread_create_result;
+  int thread_join_result;
+
+  thread_create_result = thrd_create(&thread, func, rw_lock);
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+}
+
+static void Mdc_RwLock_AssertSharedReaders(void) {
+  struct Mdc_RwLock rw_lock;
+
+  int init_result;
+  int lock_shared_result;
+  int unlock_shared_result;
+
+  init_result = Mdc_RwLock_Init(&rw_lock);
+  assert(init_result == thrd_success);
+
+  lock_shared_result = Mdc_RwLock_LockShared(&rw_lock);
+  assert(lock_shared_result == thrd_success);
+
+  RunInThread(&TryLockSharedExpectSuccess, &rw_lock);
+  RunInThread(&TryLockExpectBusy, &rw_lock);
+  RunInThread(&TimedLockExpectTimeout, &rw_lock);
+
+  /* A timed out writer must not keep blocking new readers. */
+  RunInThread(&TryLockSharedExpectSuccess, &rw_lock);
+
+  unlock_shared_result = Mdc_RwLock_UnlockShared(&rw_lock);
+  assert(unlock_shared_result == thrd_success);
+
+  Mdc_RwLock_Deinit(&rw_lock);
+}
+
+static void Mdc_RwLock_AssertExclusiveWriter(void) {
+  struct Mdc_RwLock rw_lock;
+
+  int init_result;
+  int try_lock_result;
+  int unlock_result;
+
+  init_result = Mdc_RwLock_Init(&rw_lock);
+  assert(init_result == thrd_success);
+
+  try_lock_result = Mdc_RwLock_TryLock(&rw_lock);
+  assert(try_lock_result == thrd_success);
+
+  RunInThread(&TryLockExpectBusy, &rw_lock);
+  RunInThread(&TryLockSharedExpectBusy, &rw_lock);
+  RunInThread(&TimedLockSharedExpectTimeout, &rw_lock);
+
+  unlock_result = Mdc_RwLock_Unlock(&rw_lock);
+  assert(unlock_result == thrd_success);
+
+  RunInThread(&TryLockSharedExpectSuccess, &rw_lock);
+
+  Mdc_RwLock_Deinit(&rw_lock);
+}
+
+static void Mdc_RwLock_AssertWriterExclusion(void) {
+  struct GuardedPair pair;
+  thrd_t threads[kWritersCount];
+  size_t i;
+
+  int init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_RwLock_Init(&pair.rw_lock);
+  assert(init_result == thrd_success);
+
+  pair.first = 0;
+  pair.second = 0;
+
+  for (i = 0; i < kWritersCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &IncrementPair,
+        &pair
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kWritersCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(pair.first == kWritersCount * kIncrementsCount);
+  assert(pair.second == kWritersCount * kIncrementsCount);
+
+  Mdc_RwLock_Deinit(&pair.rw_lock);
+}
+
+void Mdc_RwLock_RunTests(void) {
+  Mdc_RwLock_AssertSharedReaders();
+  Mdc_RwLock_AssertExclusiveWriter();
+  Mdc_RwLock_AssertWriterExclusion();
+}
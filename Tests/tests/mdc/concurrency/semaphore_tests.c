@@ -0,0 +1,195 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "semaphore_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <time.h>
+
+#include <mdc/concurrency/semaphore.h>
+#include <mdc/std/threads.h>
+
+#include "../test_deadline.h"
+
+enum {
+  kThreadsCount = 4,
+  kIncrementsCount = 1000
+};
+
+struct GuardedCounter {
+  struct Mdc_Semaphore semaphore;
+  long value;
+};
+
+static int IncrementCounter(void* arg) {
+  struct GuardedCounter* counter = arg;
+  size_t i;
+  int acquire_result;
+  int release_result;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    acquire_result = Mdc_Semaphore_Acquire(&counter->semaphore);
+    assert(acquire_result == thrd_success);
+
+    counter->value += 1;
+
+    release_result = Mdc_Semaphore_Release(&counter->semaphore, 1);
+    assert(release_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static int AcquireRepeatedly(void* arg) {
+  struct Mdc_Semaphore* semaphore = arg;
+  size_t i;
+  int acquire_result;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    acquire_result = Mdc_Semaphore_Acquire(semaphore);
+    assert(acquire_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static void Mdc_Semaphore_AssertTryAcquire(void) {
+  struct Mdc_Semaphore semaphore;
+  struct timespec time_point;
+
+  int init_result;
+  int try_acquire_result;
+  int timed_acquire_result;
+  int release_result;
+
+  init_result = Mdc_Semaphore_Init(&semaphore, 2);
+  assert(init_result == thrd_success);
+
+  try_acquire_result = Mdc_Semaphore_TryAcquire(&semaphore);
+  assert(try_acquire_result == thrd_success);
+
+  try_acquire_result = Mdc_Semaphore_TryAcquire(&semaphore);
+  assert(try_acquire_result == thrd_success);
+
+  try_acquire_result = Mdc_Semaphore_TryAcquire(&semaphore);
+  assert(try_acquire_result == thrd_busy);
+
+  Mdc_TestDeadline_Get(&time_point);
+  timed_acquire_result = Mdc_Semaphore_TimedAcquire(&semaphore, &time_point);
+  assert(timed_acquire_result == thrd_timedout);
+
+  release_result = Mdc_Semaphore_Release(&semaphore, 1);
+  assert(release_result == thrd_success);
+
+  Mdc_TestDeadline_Get(&time_point);
+  timed_acquire_result = Mdc_Semaphore_TimedAcquire(&semaphore, &time_point);
+  assert(timed_acquire_result == thrd_success);
+
+  Mdc_Semaphore_Deinit(&semaphore);
+}
+
+static void Mdc_Semaphore_AssertMutualExclusion(void) {
+  struct GuardedCounter counter;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_Semaphore_Init(&counter.semaphore, 1);
+  assert(init_result == thrd_success);
+
+  counter.value = 0;
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &IncrementCounter,
+        &counter
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(counter.value == kThreadsCount * kIncrementsCount);
+
+  Mdc_Semaphore_Deinit(&counter.semaphore);
+}
+
+static void Mdc_Semaphore_AssertReleaseMany(void) {
+  struct Mdc_Semaphore semaphore;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int init_result;
+  int release_result;
+  int try_acquire_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  init_result = Mdc_Semaphore_Init(&semaphore, 0);
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &AcquireRepeatedly,
+        &semaphore
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  /* Each release unblocks one acquire in every thread. */
+  for (i = 0; i < kIncrementsCount; ++i) {
+    release_result = Mdc_Semaphore_Release(&semaphore, kThreadsCount);
+    assert(release_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  try_acquire_result = Mdc_Semaphore_TryAcquire(&semaphore);
+  assert(try_acquire_result == thrd_busy);
+
+  Mdc_Semaphore_Deinit(&semaphore);
+}
+
+void Mdc_Semaphore_RunTests(void) {
+  Mdc_Semaphore_AssertTryAcquire();
+  Mdc_Semaphore_AssertMutualExclusion();
+  Mdc_Semaphore_AssertReleaseMany();
+}
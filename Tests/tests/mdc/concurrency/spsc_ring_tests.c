@@ -0,0 +1,210 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "spsc_ring_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/spsc_ring.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kCapacity = 16,
+  kBatchSize = 7,
+  kElementsCount = 100000
+};
+
+static int PushSequence(void* arg) {
+  struct Mdc_SpscRing* ring = arg;
+  long batch[kBatchSize];
+  long value;
+  size_t i;
+  int push_result;
+
+  value = 0;
+  while (value < kElementsCount) {
+    /* Alternate between single and batch pushes. */
+    if (value % 2 == 0) {
+      push_result = Mdc_SpscRing_Push(ring, &value);
+      assert(push_result == thrd_success);
+
+      value += 1;
+      continue;
+    }
+
+    for (i = 0; i < kBatchSize && value < kElementsCount; i += 1) {
+      batch[i] = value;
+      value += 1;
+    }
+
+    push_result = Mdc_SpscRing_PushBatch(ring, batch, i);
+    assert(push_result == thrd_success);
+  }
+
+  return 0;
+}
+
+static void Mdc_SpscRing_AssertTryPushPop(void) {
+  struct Mdc_SpscRing ring;
+  long elements[kCapacity + 4];
+  long popped_elements[kCapacity + 4];
+  long element;
+  size_t i;
+
+  int init_result;
+  size_t pushed_count;
+  size_t popped_count;
+
+  /* The capacity is rounded up to a power of two. */
+  init_result = Mdc_SpscRing_Init(
+      &ring,
+      sizeof(long),
+      kCapacity - 3,
+      Mdc_SpscRing_kPlain
+  );
+  assert(init_result == thrd_success);
+  assert(Mdc_SpscRing_GetCapacity(&ring) == kCapacity);
+
+  assert(!Mdc_SpscRing_TryPop(&ring, &element));
+
+  for (i = 0; i < kCapacity + 4; i += 1) {
+    elements[i] = (long) i;
+  }
+
+  /* Wrap the indices around the end of the buffer. */
+  pushed_count = Mdc_SpscRing_TryPushBatch(&ring, elements, 10);
+  assert(pushed_count == 10);
+
+  popped_count = Mdc_SpscRing_TryPopBatch(&ring, popped_elements, 10);
+  assert(popped_count == 10);
+
+  pushed_count = Mdc_SpscRing_TryPushBatch(
+      &ring,
+      elements,
+      kCapacity + 4
+  );
+  assert(pushed_count == kCapacity);
+  assert(!Mdc_SpscRing_TryPush(&ring, &elements[0]));
+
+  popped_count = Mdc_SpscRing_TryPopBatch(
+      &ring,
+      popped_elements,
+      kCapacity + 4
+  );
+  assert(popped_count == kCapacity);
+
+  for (i = 0; i < kCapacity; i += 1) {
+    assert(popped_elements[i] == (long) i);
+  }
+
+  /* A plain ring cannot wait. */
+  assert(Mdc_SpscRing_Pop(&ring, &element) == thrd_error);
+
+  Mdc_SpscRing_Deinit(&ring);
+}
+
+static void Mdc_SpscRing_AssertBlockingHandoff(void) {
+  struct Mdc_SpscRing ring;
+  thrd_t thread;
+  long batch[kBatchSize];
+  long expected_value;
+  size_t i;
+
+  int init_result;
+  int thread_create_result;
+  int thread_join_result;
+  int pop_result;
+  size_t popped_count;
+
+  init_result = Mdc_SpscRing_Init(
+      &ring,
+      sizeof(long),
+      kCapacity,
+      Mdc_SpscRing_kBlocking
+  );
+  assert(init_result == thrd_success);
+
+  thread_create_result = thrd_create(&thread, &PushSequence, &ring);
+  assert(thread_create_result == thrd_success);
+
+  expected_value = 0;
+  while (expected_value < kElementsCount) {
+    pop_result = Mdc_SpscRing_PopBatch(
+        &ring,
+        batch,
+        kBatchSize,
+        &popped_count
+    );
+    assert(pop_result == thrd_success);
+    assert(popped_count > 0);
+
+    for (i = 0; i < popped_count; i += 1) {
+      assert(batch[i] == expected_value);
+      expected_value += 1;
+    }
+  }
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  assert(!Mdc_SpscRing_TryPop(&ring, &batch[0]));
+
+  Mdc_SpscRing_Deinit(&ring);
+}
+
+static void Mdc_SpscRing_AssertCapacityOverflow(void) {
+  struct Mdc_SpscRing ring;
+
+  int init_result;
+
+  /* No power of two fits in a size_t. */
+  init_result = Mdc_SpscRing_Init(
+      &ring,
+      sizeof(long),
+      (size_t) -1,
+      Mdc_SpscRing_kPlain
+  );
+  assert(init_result == thrd_error);
+
+  /* The power of two fits, but the size in bytes does not. */
+  init_result = Mdc_SpscRing_Init(
+      &ring,
+      sizeof(long),
+      (size_t) -1 / 2 + 1,
+      Mdc_SpscRing_kPlain
+  );
+  assert(init_result == thrd_error);
+}
+
+void Mdc_SpscRing_RunTests(void) {
+  Mdc_SpscRing_AssertTryPushPop();
+  Mdc_SpscRing_AssertBlockingHandoff();
+  Mdc_SpscRing_AssertCapacityOverflow();
+}
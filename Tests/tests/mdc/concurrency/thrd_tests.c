@@ -0,0 +1,270 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "thrd_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <mdc/concurrency/thrd.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadResult = 42,
+  kStackSize = 64 * 1024
+};
+
+static int ReturnResult(void* arg) {
+  (void) arg;
+
+  return kThreadResult;
+}
+
+static int StoreCurrentId(void* arg) {
+  unsigned long* id = arg;
+
+  *id = Mdc_Thrd_GetCurrentId();
+
+  return 0;
+}
+
+#if defined(__linux__)
+
+static int AssertThreadName(void* arg) {
+  char name[16];
+  int get_name_result;
+
+  (void) arg;
+
+  get_name_result = pthread_getname_np(pthread_self(), name, sizeof(name));
+  assert(get_name_result == 0);
+
+  /* Linux names are truncated to 15 characters. */
+  assert(strcmp(name, "mdc-test-thread") == 0);
+
+  return 0;
+}
+
+static int AssertThreadCpu(void* arg) {
+  int* cpu = arg;
+
+  assert(sched_getcpu() == *cpu);
+
+  return 0;
+}
+
+#endif /* defined(__linux__) */
+
+static void Mdc_Thrd_AssertCreateExDefault(void) {
+  thrd_t thread;
+  int result;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  thread_create_result = Mdc_Thrd_CreateEx(
+      &thread,
+      &ReturnResult,
+      NULL,
+      NULL
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, &result);
+  assert(thread_join_result == thrd_success);
+  assert(result == kThreadResult);
+}
+
+static void Mdc_Thrd_AssertCreateExStackSize(void) {
+  enum {
+    kThreadsCount = 256
+  };
+
+  thrd_t threads[kThreadsCount];
+  struct Mdc_ThrdAttributes attributes;
+
+  size_t i;
+  int thread_create_result;
+  int thread_join_result;
+
+  Mdc_ThrdAttributes_Init(&attributes);
+  attributes.stack_size = kStackSize;
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_create_result = Mdc_Thrd_CreateEx(
+        &threads[i],
+        &ReturnResult,
+        NULL,
+        &attributes
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+}
+
+#if defined(__linux__)
+
+static void Mdc_Thrd_AssertCreateExName(void) {
+  thrd_t thread;
+  struct Mdc_ThrdAttributes attributes;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  Mdc_ThrdAttributes_Init(&attributes);
+  attributes.name = "mdc-test-thread-name";
+
+  thread_create_result = Mdc_Thrd_CreateEx(
+      &thread,
+      &AssertThreadName,
+      NULL,
+      &attributes
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+}
+
+static void Mdc_Thrd_AssertCreateExAffinity(void) {
+  thrd_t thread;
+  struct Mdc_ThrdAttributes attributes;
+  cpu_set_t cpu_set;
+  int cpu;
+
+  int get_affinity_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  /* Pin to the first CPU that this process is allowed to run on. */
+  get_affinity_result = sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+  assert(get_affinity_result == 0);
+
+  for (cpu = 0; !CPU_ISSET(cpu, &cpu_set); cpu += 1) {
+  }
+
+  if ((size_t) cpu >= sizeof(attributes.affinity_mask) * 8) {
+    return;
+  }
+
+  Mdc_ThrdAttributes_Init(&attributes);
+  attributes.affinity_mask = (size_t) 1 << cpu;
+
+  thread_create_result = Mdc_Thrd_CreateEx(
+      &thread,
+      &AssertThreadCpu,
+      &cpu,
+      &attributes
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+}
+
+#endif /* defined(__linux__) */
+
+static void Mdc_Thrd_AssertGetId(void) {
+  thrd_t thread;
+  unsigned long thread_id;
+  unsigned long expected_id;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  assert(Mdc_Thrd_GetCurrentId() != 0);
+  assert(Mdc_Thrd_GetCurrentId() == Mdc_Thrd_GetCurrentId());
+
+  thread_create_result = thrd_create(&thread, &StoreCurrentId, &thread_id);
+  assert(thread_create_result == thrd_success);
+
+  expected_id = Mdc_Thrd_GetId(thread);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  assert(thread_id != Mdc_Thrd_GetCurrentId());
+
+  /* The ID of another thread is unavailable before Windows Vista. */
+  if (expected_id != 0) {
+    assert(thread_id == expected_id);
+  }
+}
+
+static void Mdc_Thrd_AssertPreciseSleep(void) {
+  enum {
+    kSleepNanoseconds = 2500000
+  };
+
+  struct timespec duration;
+  struct timespec start;
+  struct timespec end;
+  long elapsed_nanoseconds;
+
+  duration.tv_sec = 0;
+  duration.tv_nsec = kSleepNanoseconds;
+
+  timespec_get(&start, TIME_UTC);
+  Mdc_Thrd_PreciseSleep(&duration);
+  timespec_get(&end, TIME_UTC);
+
+  elapsed_nanoseconds = (long) (end.tv_sec - start.tv_sec) * 1000000000L
+      + (end.tv_nsec - start.tv_nsec);
+  assert(elapsed_nanoseconds >= kSleepNanoseconds);
+}
+
+static void Mdc_Thrd_AssertGetHardwareConcurrency(void) {
+  assert(Mdc_Thrd_GetHardwareConcurrency() >= 1);
+}
+
+void Mdc_Thrd_RunTests(void) {
+  Mdc_Thrd_AssertCreateExDefault();
+  Mdc_Thrd_AssertGetId();
+  Mdc_Thrd_AssertGetHardwareConcurrency();
+  Mdc_Thrd_AssertPreciseSleep();
+  Mdc_Thrd_AssertCreateExStackSize();
+
+#if defined(__linux__)
+  Mdc_Thrd_AssertCreateExName();
+  Mdc_Thrd_AssertCreateExAffinity();
+#endif /* defined(__linux__) */
+}
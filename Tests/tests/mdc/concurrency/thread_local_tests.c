@@ -0,0 +1,97 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "thread_local_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/thread_local.h>
+#include <mdc/std/threads.h>
+
+#if defined(MDC_HAS_THREAD_LOCAL)
+
+enum {
+  kThreadsCount = 16,
+  kIterationsCount = 1000
+};
+
+static MDC_THREAD_LOCAL int thread_local_value = 0;
+
+static int CountThreadLocal(void* arg) {
+  size_t i;
+
+  (void) arg;
+
+  assert(thread_local_value == 0);
+
+  /* No other thread can observe or modify this thread's count. */
+  for (i = 0; i < kIterationsCount; i += 1) {
+    thread_local_value += 1;
+    thrd_yield();
+  }
+
+  assert(thread_local_value == kIterationsCount);
+
+  return 0;
+}
+
+static void Mdc_ThreadLocal_AssertIsolation(void) {
+  thrd_t threads[kThreadsCount];
+
+  size_t i;
+  int thread_create_result;
+  int thread_join_result;
+
+  thread_local_value = -1;
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &CountThreadLocal,
+        NULL
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(thread_local_value == -1);
+}
+
+#endif /* defined(MDC_HAS_THREAD_LOCAL) */
+
+void Mdc_ThreadLocal_RunTests(void) {
+#if defined(MDC_HAS_THREAD_LOCAL)
+  Mdc_ThreadLocal_AssertIsolation();
+#endif /* defined(MDC_HAS_THREAD_LOCAL) */
+}
@@ -0,0 +1,229 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "thread_pool_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/concurrency/thread_pool.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kWorkersCount = 4,
+  kTasksCount = 10000,
+  kParentTasksCount = 4,
+  /* Larger than a worker's deque, so that children overflow. */
+  kChildTasksCount = 3000
+};
+
+struct Counter {
+  mtx_t mutex;
+  long value;
+};
+
+struct ParentTaskContext {
+  struct Mdc_ThreadPool* pool;
+  struct Counter* counter;
+};
+
+static void IncrementCounter(void* arg) {
+  struct Counter* counter = arg;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+
+  mtx_lock_result = mtx_lock(&counter->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  counter->value += 1;
+
+  mtx_unlock_result = mtx_unlock(&counter->mutex);
+  assert(mtx_unlock_result == thrd_success);
+}
+
+static void SubmitChildTasks(void* arg) {
+  struct ParentTaskContext* context = arg;
+  size_t i;
+  int submit_result;
+
+  for (i = 0; i < kChildTasksCount; i += 1) {
+    submit_result = Mdc_ThreadPool_Submit(
+        context->pool,
+        &IncrementCounter,
+        context->counter
+    );
+    assert(submit_result == thrd_success);
+  }
+}
+
+static void InitCounter(struct Counter* counter) {
+  int mtx_init_result;
+
+  mtx_init_result = mtx_init(&counter->mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  counter->value = 0;
+}
+
+static void Mdc_ThreadPool_AssertSubmit(void) {
+  struct Mdc_ThreadPool pool;
+  struct Counter counter;
+
+  size_t i;
+  int init_result;
+  int submit_result;
+
+  InitCounter(&counter);
+
+  init_result = Mdc_ThreadPool_Init(&pool, kWorkersCount);
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < kTasksCount; i += 1) {
+    submit_result = Mdc_ThreadPool_Submit(
+        &pool,
+        &IncrementCounter,
+        &counter
+    );
+    assert(submit_result == thrd_success);
+  }
+
+  Mdc_ThreadPool_WaitIdle(&pool);
+  assert(counter.value == kTasksCount);
+
+  /* The pool can be reused after becoming idle. */
+  submit_result = Mdc_ThreadPool_Submit(&pool, &IncrementCounter, &counter);
+  assert(submit_result == thrd_success);
+
+  Mdc_ThreadPool_WaitIdle(&pool);
+  assert(counter.value == kTasksCount + 1);
+
+  Mdc_ThreadPool_Deinit(&pool);
+  mtx_destroy(&counter.mutex);
+}
+
+static void Mdc_ThreadPool_AssertSubmitBatch(void) {
+  static struct Mdc_ThreadPoolTask tasks[kTasksCount];
+
+  struct Mdc_ThreadPool pool;
+  struct Counter counter;
+
+  size_t i;
+  int init_result;
+  int submit_result;
+
+  InitCounter(&counter);
+
+  for (i = 0; i < kTasksCount; i += 1) {
+    tasks[i].func = &IncrementCounter;
+    tasks[i].arg = &counter;
+  }
+
+  init_result = Mdc_ThreadPool_Init(&pool, kWorkersCount);
+  assert(init_result == thrd_success);
+
+  submit_result = Mdc_ThreadPool_SubmitBatch(&pool, tasks, kTasksCount);
+  assert(submit_result == thrd_success);
+
+  Mdc_ThreadPool_WaitIdle(&pool);
+  assert(counter.value == kTasksCount);
+
+  Mdc_ThreadPool_Deinit(&pool);
+  mtx_destroy(&counter.mutex);
+}
+
+static void Mdc_ThreadPool_AssertNestedSubmit(void) {
+  struct Mdc_ThreadPool pool;
+  struct Counter counter;
+  struct ParentTaskContext context;
+
+  size_t i;
+  int init_result;
+  int submit_result;
+
+  InitCounter(&counter);
+
+  init_result = Mdc_ThreadPool_Init(&pool, kWorkersCount);
+  assert(init_result == thrd_success);
+
+  context.pool = &pool;
+  context.counter = &counter;
+
+  for (i = 0; i < kParentTasksCount; i += 1) {
+    submit_result = Mdc_ThreadPool_Submit(
+        &pool,
+        &SubmitChildTasks,
+        &context
+    );
+    assert(submit_result == thrd_success);
+  }
+
+  /* Waiting for idle includes the children submitted by tasks. */
+  Mdc_ThreadPool_WaitIdle(&pool);
+  assert(counter.value == kParentTasksCount * kChildTasksCount);
+
+  Mdc_ThreadPool_Deinit(&pool);
+  mtx_destroy(&counter.mutex);
+}
+
+static void Mdc_ThreadPool_AssertDeinitWaits(void) {
+  struct Mdc_ThreadPool pool;
+  struct Counter counter;
+
+  size_t i;
+  int init_result;
+  int submit_result;
+
+  InitCounter(&counter);
+
+  /* 0 selects one worker per processor. */
+  init_result = Mdc_ThreadPool_Init(&pool, 0);
+  assert(init_result == thrd_success);
+  assert(pool.workers_count_ > 0);
+
+  for (i = 0; i < kTasksCount; i += 1) {
+    submit_result = Mdc_ThreadPool_Submit(
+        &pool,
+        &IncrementCounter,
+        &counter
+    );
+    assert(submit_result == thrd_success);
+  }
+
+  Mdc_ThreadPool_Deinit(&pool);
+  assert(counter.value == kTasksCount);
+
+  mtx_destroy(&counter.mutex);
+}
+
+void Mdc_ThreadPool_RunTests(void) {
+  Mdc_ThreadPool_AssertSubmit();
+  Mdc_ThreadPool_AssertSubmitBatch();
+  Mdc_ThreadPool_AssertNestedSubmit();
+  Mdc_ThreadPool_AssertDeinitWaits();
+}
@@ -0,0 +1,58 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "concurrency_tests.h"
+
+#include "concurrency/barrier_tests.h"
+#include "concurrency/latch_tests.h"
+#include "concurrency/mcs_lock_tests.h"
+#include "concurrency/mpmc_queue_tests.h"
+#include "concurrency/mtx_tests.h"
+#include "concurrency/once_cell_tests.h"
+#include "concurrency/rw_lock_tests.h"
+#include "concurrency/semaphore_tests.h"
+#include "concurrency/spsc_ring_tests.h"
+#include "concurrency/thrd_tests.h"
+#include "concurrency/thread_local_tests.h"
+#include "concurrency/thread_pool_tests.h"
+
+void Mdc_Concurrency_RunTests(void) {
+  Mdc_Barrier_RunTests();
+  Mdc_Latch_RunTests();
+  Mdc_McsLock_RunTests();
+  Mdc_MpmcQueue_RunTests();
+  Mdc_Mtx_RunTests();
+  Mdc_OnceCell_RunTests();
+  Mdc_RwLock_RunTests();
+  Mdc_Semaphore_RunTests();
+  Mdc_SpscRing_RunTests();
+  Mdc_ThreadLocal_RunTests();
+  Mdc_Thrd_RunTests();
+  Mdc_ThreadPool_RunTests();
+}
@@ -34,7 +34,11 @@
 #include <windows.h>
 
 #include <mdc/malloc/malloc.h>
+#include "concurrency_tests.h"
 #include "error_tests.h"
+#include "malloc/arena_tests.h"
+#include "malloc/malloc_tests.h"
+#include "malloc/pool_tests.h"
 #include "std_tests.h"
 #include "wchar_t_tests.h"
 
@@ -47,6 +51,10 @@ int main(int argc, char** argv) {
   /* Mdc_Error_RunTests(); */
 
   Mdc_Std_RunTests();
+  Mdc_Concurrency_RunTests();
+  Mdc_Arena_RunTests();
+  Mdc_Malloc_RunTests();
+  Mdc_Pool_RunTests();
   Mdc_WChar_t_RunTests();
 
   Mdc_PrintMallocLeaks();
@@ -0,0 +1,179 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "arena_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <mdc/malloc/arena.h>
+#include <mdc/malloc/malloc.h>
+#include <mdc/std/stdint.h>
+
+enum {
+  kBlockSize = 256,
+  kAllocationsCount = 100,
+  kAllocationSize = 24
+};
+
+static void Mdc_Arena_AssertAllocate(void) {
+  struct Mdc_Arena arena;
+  unsigned char* allocations[kAllocationsCount];
+  size_t i;
+  size_t j;
+
+  Mdc_Arena_Init(&arena, kBlockSize);
+
+  /* Spans several blocks, none of which may overlap. */
+  for (i = 0; i < kAllocationsCount; ++i) {
+    allocations[i] = Mdc_Arena_Allocate(&arena, kAllocationSize);
+    assert(allocations[i] != NULL);
+    assert((uintptr_t) allocations[i] % sizeof(void*) == 0);
+
+    memset(allocations[i], (int) i, kAllocationSize);
+  }
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    for (j = 0; j < kAllocationSize; ++j) {
+      assert(allocations[i][j] == (unsigned char) i);
+    }
+  }
+
+  Mdc_Arena_Deinit(&arena);
+  assert(Mdc_GetMallocDifference() == 0);
+}
+
+static void Mdc_Arena_AssertAllocateAligned(void) {
+  struct Mdc_Arena arena;
+  void* ptr;
+  size_t alignment;
+
+  Mdc_Arena_Init(&arena, kBlockSize);
+
+  for (alignment = 1; alignment <= 4096; alignment *= 2) {
+    /* Misalign the position before each aligned allocation. */
+    ptr = Mdc_Arena_Allocate(&arena, 1);
+    assert(ptr != NULL);
+
+    ptr = Mdc_Arena_AllocateAligned(&arena, 8, alignment);
+    assert(ptr != NULL);
+    assert((uintptr_t) ptr % alignment == 0);
+  }
+
+  assert(Mdc_Arena_AllocateAligned(&arena, 8, 3) == NULL);
+  assert(Mdc_Arena_AllocateAligned(&arena, 8, 0) == NULL);
+
+  Mdc_Arena_Deinit(&arena);
+}
+
+static void Mdc_Arena_AssertLargeAllocation(void) {
+  struct Mdc_Arena arena;
+  unsigned char* ptr;
+
+  Mdc_Arena_Init(&arena, kBlockSize);
+
+  ptr = Mdc_Arena_Allocate(&arena, kBlockSize * 10);
+  assert(ptr != NULL);
+  memset(ptr, 0xAB, kBlockSize * 10);
+
+  assert(Mdc_Arena_Allocate(&arena, (size_t) -1) == NULL);
+
+  Mdc_Arena_Deinit(&arena);
+}
+
+static void Mdc_Arena_AssertMarkRewind(void) {
+  struct Mdc_Arena arena;
+  struct Mdc_ArenaMark mark;
+  void* first_ptr;
+  void* marked_ptr;
+  void* ptr;
+  size_t i;
+  int malloc_difference;
+
+  Mdc_Arena_Init(&arena, kBlockSize);
+
+  first_ptr = Mdc_Arena_Allocate(&arena, kAllocationSize);
+  assert(first_ptr != NULL);
+
+  Mdc_Arena_GetMark(&arena, &mark);
+
+  marked_ptr = Mdc_Arena_Allocate(&arena, kAllocationSize);
+  assert(marked_ptr != NULL);
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    ptr = Mdc_Arena_Allocate(&arena, kAllocationSize);
+    assert(ptr != NULL);
+  }
+
+  malloc_difference = Mdc_GetMallocDifference();
+
+  /* Rewinding reuses the memory and the blocks after the mark. */
+  Mdc_Arena_Rewind(&arena, &mark);
+  assert(Mdc_Arena_Allocate(&arena, kAllocationSize) == marked_ptr);
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    ptr = Mdc_Arena_Allocate(&arena, kAllocationSize);
+    assert(ptr != NULL);
+  }
+
+  assert(Mdc_GetMallocDifference() == malloc_difference);
+
+  Mdc_Arena_Reset(&arena);
+  assert(Mdc_Arena_Allocate(&arena, kAllocationSize) == first_ptr);
+
+  Mdc_Arena_Deinit(&arena);
+}
+
+static void Mdc_Arena_AssertRewindToEmpty(void) {
+  struct Mdc_Arena arena;
+  struct Mdc_ArenaMark mark;
+  void* first_ptr;
+
+  Mdc_Arena_Init(&arena, 0);
+
+  Mdc_Arena_GetMark(&arena, &mark);
+  Mdc_Arena_Reset(&arena);
+
+  first_ptr = Mdc_Arena_Allocate(&arena, kAllocationSize);
+  assert(first_ptr != NULL);
+
+  Mdc_Arena_Rewind(&arena, &mark);
+  assert(Mdc_Arena_Allocate(&arena, kAllocationSize) == first_ptr);
+
+  Mdc_Arena_Deinit(&arena);
+}
+
+void Mdc_Arena_RunTests(void) {
+  Mdc_Arena_AssertAllocate();
+  Mdc_Arena_AssertAllocateAligned();
+  Mdc_Arena_AssertLargeAllocation();
+  Mdc_Arena_AssertMarkRewind();
+  Mdc_Arena_AssertRewindToEmpty();
+}
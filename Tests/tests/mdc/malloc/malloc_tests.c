@@ -0,0 +1,381 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "malloc_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mdc/malloc/malloc.h>
+#include <mdc/std/stdint.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 8,
+  kAllocationsCount = 1000,
+  kPeakBlocksCount = 4
+};
+
+static int AllocateAndFree(void* arg) {
+  size_t i;
+  void* ptr;
+
+  (void) arg;
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    ptr = Mdc_malloc(i + 1);
+    assert(ptr != NULL);
+
+    Mdc_free(ptr);
+  }
+
+  return 0;
+}
+
+struct CallCounts {
+  size_t malloc_count;
+  size_t calloc_count;
+  size_t realloc_count;
+  size_t free_count;
+};
+
+static void* CountingMalloc(void* context, size_t size) {
+  ((struct CallCounts*) context)->malloc_count += 1;
+
+  return malloc(size);
+}
+
+static void* CountingCalloc(void* context, size_t num, size_t size) {
+  ((struct CallCounts*) context)->calloc_count += 1;
+
+  return calloc(num, size);
+}
+
+static void* CountingRealloc(void* context, void* ptr, size_t new_size) {
+  ((struct CallCounts*) context)->realloc_count += 1;
+
+  return realloc(ptr, new_size);
+}
+
+static void CountingFree(void* context, void* ptr) {
+  ((struct CallCounts*) context)->free_count += 1;
+
+  free(ptr);
+}
+
+static void Mdc_Malloc_AssertBytes(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  unsigned char* ptr;
+  size_t i;
+
+  Mdc_GetMallocStats(&start_stats);
+
+  ptr = Mdc_malloc(100);
+  assert(ptr != NULL);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.malloc_count == start_stats.malloc_count + 1);
+  assert(stats.current_bytes == start_stats.current_bytes + 100);
+
+  ptr = Mdc_realloc(ptr, 300);
+  assert(ptr != NULL);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.malloc_count == start_stats.malloc_count + 2);
+  assert(stats.free_count == start_stats.free_count + 1);
+  assert(stats.current_bytes == start_stats.current_bytes + 300);
+
+  Mdc_free(ptr);
+
+  ptr = Mdc_calloc(10, 20);
+  assert(ptr != NULL);
+
+  for (i = 0; i < 10 * 20; ++i) {
+    assert(ptr[i] == 0);
+  }
+
+  Mdc_free(ptr);
+
+  /* Freeing NULL is not a free. */
+  Mdc_free(NULL);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.malloc_count == start_stats.malloc_count + 3);
+  assert(stats.free_count == start_stats.free_count + 3);
+  assert(stats.allocated_bytes == start_stats.allocated_bytes + 600);
+  assert(stats.current_bytes == start_stats.current_bytes);
+}
+
+static void Mdc_Malloc_AssertOverflow(void) {
+  assert(Mdc_malloc((size_t) -1) == NULL);
+  assert(Mdc_calloc((size_t) -1 / 2, 4) == NULL);
+  assert(Mdc_GetMallocDifference() == 0);
+}
+
+static void Mdc_Malloc_AssertAligned(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  unsigned char* ptr;
+  size_t alignment;
+
+  Mdc_GetMallocStats(&start_stats);
+
+  for (alignment = 1; alignment <= 4096; alignment *= 2) {
+    ptr = Mdc_AlignedAlloc(alignment, 100);
+    assert(ptr != NULL);
+    assert((uintptr_t) ptr % alignment == 0);
+    assert(Mdc_AllocUsableSize(ptr) == 100);
+
+    memset(ptr, 0xFF, 100);
+
+    Mdc_GetMallocStats(&stats);
+    assert(stats.current_bytes == start_stats.current_bytes + 100);
+
+    /* Aligned blocks cannot be reallocated. */
+    assert(Mdc_realloc(ptr, 200) == NULL);
+
+    if (alignment % 2 == 0) {
+      Mdc_AlignedFree(ptr);
+    } else {
+      Mdc_free(ptr);
+    }
+  }
+
+  assert(Mdc_AlignedAlloc(0, 100) == NULL);
+  assert(Mdc_AlignedAlloc(3, 100) == NULL);
+  assert(Mdc_AlignedAlloc(64, (size_t) -1) == NULL);
+
+  Mdc_AlignedFree(NULL);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.malloc_count == start_stats.malloc_count + 13);
+  assert(stats.free_count == start_stats.free_count + 13);
+  assert(stats.current_bytes == start_stats.current_bytes);
+}
+
+static void Mdc_Malloc_AssertFreeSized(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  void* ptr;
+
+  Mdc_GetMallocStats(&start_stats);
+
+  ptr = Mdc_malloc(100);
+  assert(ptr != NULL);
+  assert(Mdc_AllocUsableSize(ptr) == 100);
+
+  ptr = Mdc_realloc(ptr, 300);
+  assert(ptr != NULL);
+  assert(Mdc_AllocUsableSize(ptr) == 300);
+
+  Mdc_FreeSized(ptr, 300);
+  Mdc_FreeSized(NULL, 0);
+
+  assert(Mdc_AllocUsableSize(NULL) == 0);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.free_count == start_stats.free_count + 2);
+  assert(stats.current_bytes == start_stats.current_bytes);
+}
+
+static void Mdc_Malloc_AssertDisabled(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  void* ptr;
+
+  int is_enabled;
+
+  is_enabled = Mdc_IsMallocAccountingEnabled();
+  Mdc_GetMallocStats(&start_stats);
+
+  Mdc_SetMallocAccountingEnabled(0);
+  assert(!Mdc_IsMallocAccountingEnabled());
+
+  ptr = Mdc_malloc(100);
+  assert(ptr != NULL);
+
+  /* The block was not counted, so neither is its free. */
+  Mdc_SetMallocAccountingEnabled(1);
+  Mdc_free(ptr);
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.malloc_count == start_stats.malloc_count);
+  assert(stats.free_count == start_stats.free_count);
+  assert(stats.current_bytes == start_stats.current_bytes);
+
+  Mdc_SetMallocAccountingEnabled(is_enabled);
+}
+
+static void Mdc_Malloc_AssertAllocator(void) {
+  struct CallCounts counts = { 0 };
+  struct Mdc_AllocatorVTable vtable;
+  const struct Mdc_AllocatorVTable* default_vtable;
+  void* ptr;
+
+  vtable.malloc_func = &CountingMalloc;
+  vtable.calloc_func = &CountingCalloc;
+  vtable.realloc_func = &CountingRealloc;
+  vtable.free_func = &CountingFree;
+  vtable.aligned_alloc_func = NULL;
+  vtable.aligned_free_func = NULL;
+  vtable.context = &counts;
+
+  default_vtable = Mdc_GetAllocator();
+  assert(default_vtable != NULL);
+
+  Mdc_SetAllocator(&vtable);
+  assert(Mdc_GetAllocator() == &vtable);
+
+  ptr = Mdc_malloc(100);
+  assert(ptr != NULL);
+
+  ptr = Mdc_realloc(ptr, 200);
+  assert(ptr != NULL);
+
+  Mdc_free(ptr);
+
+  ptr = Mdc_calloc(10, 20);
+  assert(ptr != NULL);
+
+  Mdc_free(ptr);
+
+  Mdc_SetAllocator(NULL);
+  assert(Mdc_GetAllocator() == default_vtable);
+
+  assert(counts.malloc_count == 1);
+  assert(counts.calloc_count == 1);
+  assert(counts.realloc_count == 1);
+  assert(counts.free_count == 2);
+}
+
+static void Mdc_Malloc_AssertAllocatorSwap(void) {
+  struct CallCounts counts = { 0 };
+  struct Mdc_AllocatorVTable vtable;
+  void* ptr;
+  void* aligned_ptr;
+
+  vtable.malloc_func = &CountingMalloc;
+  vtable.calloc_func = &CountingCalloc;
+  vtable.realloc_func = &CountingRealloc;
+  vtable.free_func = &CountingFree;
+  vtable.aligned_alloc_func = NULL;
+  vtable.aligned_free_func = NULL;
+  vtable.context = &counts;
+
+  Mdc_SetAllocator(&vtable);
+
+  ptr = Mdc_malloc(100);
+  assert(ptr != NULL);
+
+  aligned_ptr = Mdc_AlignedAlloc(64, 100);
+  assert(aligned_ptr != NULL);
+
+  Mdc_SetAllocator(NULL);
+
+  /* Blocks outlive the swap, and go back to their own allocator. */
+  ptr = Mdc_realloc(ptr, 200);
+  assert(ptr != NULL);
+
+  Mdc_free(ptr);
+  Mdc_AlignedFree(aligned_ptr);
+
+  assert(counts.malloc_count == 2);
+  assert(counts.realloc_count == 1);
+  assert(counts.free_count == 2);
+}
+
+static void Mdc_Malloc_AssertPeak(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  void* blocks[kPeakBlocksCount];
+  size_t i;
+
+  Mdc_GetMallocStats(&start_stats);
+
+  for (i = 0; i < kPeakBlocksCount; ++i) {
+    blocks[i] = Mdc_malloc(Mdc_Malloc_kPeakGranularityBytes);
+    assert(blocks[i] != NULL);
+  }
+
+  for (i = 0; i < kPeakBlocksCount; ++i) {
+    Mdc_free(blocks[i]);
+  }
+
+  Mdc_GetMallocStats(&stats);
+  assert(stats.current_bytes == start_stats.current_bytes);
+  assert(stats.peak_bytes >= start_stats.current_bytes
+      + kPeakBlocksCount * Mdc_Malloc_kPeakGranularityBytes
+      - Mdc_Malloc_kPeakGranularityBytes);
+}
+
+static void Mdc_Malloc_AssertMultithread(void) {
+  struct Mdc_MallocStats start_stats;
+  struct Mdc_MallocStats stats;
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  Mdc_GetMallocStats(&start_stats);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(&threads[i], &AllocateAndFree, NULL);
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  Mdc_GetMallocStats(&stats);
+
+  /* Thread creation may allocate, so only the lower bound is exact. */
+  assert(stats.malloc_count - start_stats.malloc_count
+      >= kThreadsCount * kAllocationsCount);
+  assert(stats.malloc_count - stats.free_count
+      == start_stats.malloc_count - start_stats.free_count);
+  assert(stats.current_bytes == start_stats.current_bytes);
+}
+
+void Mdc_Malloc_RunTests(void) {
+  Mdc_Malloc_AssertBytes();
+  Mdc_Malloc_AssertOverflow();
+  Mdc_Malloc_AssertAligned();
+  Mdc_Malloc_AssertFreeSized();
+  Mdc_Malloc_AssertDisabled();
+  Mdc_Malloc_AssertAllocator();
+  Mdc_Malloc_AssertAllocatorSwap();
+  Mdc_Malloc_AssertPeak();
+  Mdc_Malloc_AssertMultithread();
+}
@@ -0,0 +1,328 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "pool_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mdc/malloc/malloc.h>
+#include <mdc/malloc/pool.h>
+#include <mdc/std/stdint.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kObjectSize = 24,
+  kLargeObjectSize = Mdc_Pool_kSlabSize + 1,
+  kAllocationsCount = Mdc_Pool_kMagazineCapacity * 5 + 3,
+  kThreadsCount = 4
+};
+
+static struct Mdc_Pool shared_pool;
+static void* shared_objects[kAllocationsCount];
+
+static void Mdc_Pool_AssertAllocate(void) {
+  struct Mdc_Pool pool;
+  unsigned char* objects[kAllocationsCount];
+  int start_difference;
+  int init_result;
+  size_t i;
+  size_t j;
+
+  start_difference = Mdc_GetMallocDifference();
+
+  init_result = Mdc_Pool_Init(&pool, kObjectSize);
+  assert(init_result == thrd_success);
+
+  /* Spans several magazines, none of whose objects may overlap. */
+  for (i = 0; i < kAllocationsCount; ++i) {
+    objects[i] = Mdc_Pool_Allocate(&pool);
+    assert(objects[i] != NULL);
+    assert((uintptr_t) objects[i] % 64 == 0);
+
+    memset(objects[i], (int) i, kObjectSize);
+  }
+
+  assert(Mdc_GetMallocDifference() - start_difference
+      >= kAllocationsCount);
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    for (j = 0; j < kObjectSize; ++j) {
+      assert(objects[i][j] == (unsigned char) i);
+    }
+
+    Mdc_Pool_Free(&pool, objects[i]);
+  }
+
+  Mdc_Pool_Free(&pool, NULL);
+
+  /* The thread's cache is still allocated. */
+  assert(Mdc_GetMallocDifference() - start_difference == 1);
+
+  /* The most recently freed object is reused first. */
+  assert(Mdc_Pool_Allocate(&pool) == objects[kAllocationsCount - 1]);
+  Mdc_Pool_Free(&pool, objects[kAllocationsCount - 1]);
+
+  Mdc_Pool_Deinit(&pool);
+  assert(Mdc_GetMallocDifference() == start_difference);
+}
+
+static void Mdc_Pool_AssertLargeObject(void) {
+  struct Mdc_Pool pool;
+  unsigned char* objects[3];
+  int init_result;
+  size_t i;
+
+  init_result = Mdc_Pool_Init(&pool, kLargeObjectSize);
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < 3; ++i) {
+    objects[i] = Mdc_Pool_Allocate(&pool);
+    assert(objects[i] != NULL);
+
+    memset(objects[i], (int) i, kLargeObjectSize);
+  }
+
+  for (i = 0; i < 3; ++i) {
+    assert(objects[i][0] == (unsigned char) i);
+    assert(objects[i][kLargeObjectSize - 1] == (unsigned char) i);
+
+    Mdc_Pool_Free(&pool, objects[i]);
+  }
+
+  Mdc_Pool_Deinit(&pool);
+}
+
+static void Mdc_Pool_AssertUncounted(void) {
+  struct Mdc_Pool pool;
+  void* object;
+  int is_accounting_enabled;
+  int start_difference;
+  int init_result;
+
+  is_accounting_enabled = Mdc_IsMallocAccountingEnabled();
+
+  Mdc_SetMallocAccountingEnabled(0);
+  init_result = Mdc_Pool_Init(&pool, kObjectSize);
+  assert(init_result == thrd_success);
+  Mdc_SetMallocAccountingEnabled(1);
+
+  /* The first allocation also allocates the thread's cache. */
+  Mdc_Pool_Free(&pool, Mdc_Pool_Allocate(&pool));
+  start_difference = Mdc_GetMallocDifference();
+
+  object = Mdc_Pool_Allocate(&pool);
+  assert(object != NULL);
+  assert(Mdc_GetMallocDifference() == start_difference);
+
+  Mdc_Pool_Free(&pool, object);
+  Mdc_Pool_Deinit(&pool);
+
+  Mdc_SetMallocAccountingEnabled(is_accounting_enabled);
+}
+
+static void* SlabMalloc(void* context, size_t size) {
+  (void) context;
+
+  return malloc(size);
+}
+
+static void* SlabCalloc(void* context, size_t num, size_t size) {
+  (void) context;
+
+  return calloc(num, size);
+}
+
+static void* SlabRealloc(void* context, void* ptr, size_t new_size) {
+  (void) context;
+
+  return realloc(ptr, new_size);
+}
+
+static void SlabFree(void* context, void* ptr) {
+  (void) context;
+
+  free(ptr);
+}
+
+/*
+* Counts the live aligned blocks. The underlying block's address is
+* stored just before the aligned block.
+*/
+static void* SlabAlignedAlloc(void* context, size_t size, size_t alignment) {
+  void* block;
+  uintptr_t aligned_block;
+
+  block = malloc(size + alignment + sizeof(void*));
+  if (block == NULL) {
+    return NULL;
+  }
+
+  aligned_block = ((uintptr_t) block + sizeof(void*) + (alignment - 1))
+      & ~(uintptr_t) (alignment - 1);
+  ((void**) aligned_block)[-1] = block;
+
+  *(size_t*) context += 1;
+
+  return (void*) aligned_block;
+}
+
+static void SlabAlignedFree(void* context, void* ptr) {
+  *(size_t*) context -= 1;
+
+  free(((void**) ptr)[-1]);
+}
+
+static void Mdc_Pool_AssertAllocator(void) {
+  struct Mdc_AllocatorVTable vtable;
+  struct Mdc_Pool pool;
+  void* objects[kAllocationsCount];
+  size_t aligned_blocks_count;
+  int init_result;
+  size_t i;
+
+  aligned_blocks_count = 0;
+
+  vtable.malloc_func = &SlabMalloc;
+  vtable.calloc_func = &SlabCalloc;
+  vtable.realloc_func = &SlabRealloc;
+  vtable.free_func = &SlabFree;
+  vtable.aligned_alloc_func = &SlabAlignedAlloc;
+  vtable.aligned_free_func = &SlabAlignedFree;
+  vtable.context = &aligned_blocks_count;
+
+  Mdc_SetAllocator(&vtable);
+
+  init_result = Mdc_Pool_Init(&pool, kLargeObjectSize);
+  assert(init_result == thrd_success);
+
+  /* Objects larger than a slab get one slab each. */
+  for (i = 0; i < 3; ++i) {
+    objects[i] = Mdc_Pool_Allocate(&pool);
+    assert(objects[i] != NULL);
+    assert((uintptr_t) objects[i] % 64 == 0);
+  }
+
+  /* The thread's cache is also an aligned block. */
+  assert(aligned_blocks_count == 3 + 1);
+
+  for (i = 0; i < 3; ++i) {
+    Mdc_Pool_Free(&pool, objects[i]);
+  }
+
+  Mdc_Pool_Deinit(&pool);
+  assert(aligned_blocks_count == 0);
+
+  Mdc_SetAllocator(NULL);
+}
+
+static int AllocateAndFree(void* arg) {
+  void* objects[kAllocationsCount];
+  size_t i;
+
+  (void) arg;
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    objects[i] = Mdc_Pool_Allocate(&shared_pool);
+    assert(objects[i] != NULL);
+
+    memset(objects[i], (int) i, kObjectSize);
+  }
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    assert(*(unsigned char*) objects[i] == (unsigned char) i);
+    Mdc_Pool_Free(&shared_pool, objects[i]);
+  }
+
+  return 0;
+}
+
+static int FreeSharedObjects(void* arg) {
+  size_t i;
+
+  (void) arg;
+
+  for (i = 0; i < kAllocationsCount; ++i) {
+    Mdc_Pool_Free(&shared_pool, shared_objects[i]);
+  }
+
+  return 0;
+}
+
+static void Mdc_Pool_AssertMultithread(void) {
+  thrd_t threads[kThreadsCount];
+  int start_difference;
+  size_t i;
+
+  int init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  start_difference = Mdc_GetMallocDifference();
+
+  init_result = Mdc_Pool_Init(&shared_pool, kObjectSize);
+  assert(init_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(&threads[i], &AllocateAndFree, NULL);
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  /* Objects may be freed by a thread other than the one allocating. */
+  for (i = 0; i < kAllocationsCount; ++i) {
+    shared_objects[i] = Mdc_Pool_Allocate(&shared_pool);
+    assert(shared_objects[i] != NULL);
+  }
+
+  thread_create_result = thrd_create(&threads[0], &FreeSharedObjects, NULL);
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(threads[0], NULL);
+  assert(thread_join_result == thrd_success);
+
+  Mdc_Pool_Deinit(&shared_pool);
+
+  /* The caches of the exited threads were freed when they exited. */
+  assert(Mdc_GetMallocDifference() == start_difference);
+}
+
+void Mdc_Pool_RunTests(void) {
+  Mdc_Pool_AssertAllocate();
+  Mdc_Pool_AssertLargeObject();
+  Mdc_Pool_AssertUncounted();
+  Mdc_Pool_AssertAllocator();
+  Mdc_Pool_AssertMultithread();
+}
@@ -0,0 +1,194 @@
+/**
+ * Mir Drualga Common For C
+ * Copyright (C) 2020-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "stdatomic_tests.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <mdc/std/stdatomic.h>
+#include <mdc/std/threads.h>
+
+enum {
+  kThreadsCount = 4,
+  kIncrementsCount = 10000
+};
+
+struct SpinLockedCounter {
+  atomic_flag flag;
+  long value;
+};
+
+static int FetchAddCounter(void* arg) {
+  atomic_long* counter = arg;
+  size_t i;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    atomic_fetch_add_explicit(counter, 1, memory_order_relaxed);
+  }
+
+  return 0;
+}
+
+static int CompareExchangeCounter(void* arg) {
+  atomic_long* counter = arg;
+  size_t i;
+  long expected;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    expected = (long) atomic_load_explicit(counter, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak(counter, &expected, expected + 1)) {
+    }
+  }
+
+  return 0;
+}
+
+static int SpinLockedIncrement(void* arg) {
+  struct SpinLockedCounter* counter = arg;
+  size_t i;
+
+  for (i = 0; i < kIncrementsCount; ++i) {
+    while (atomic_flag_test_and_set_explicit(
+        &counter->flag,
+        memory_order_acquire
+    )) {
+    }
+
+    counter->value += 1;
+
+    atomic_flag_clear_explicit(&counter->flag, memory_order_release);
+  }
+
+  return 0;
+}
+
+static void RunThreads(thrd_start_t func, void* arg) {
+  thrd_t threads[kThreadsCount];
+  size_t i;
+
+  int thread_create_result;
+  int thread_join_result;
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_create_result = thrd_create(&threads[i], func, arg);
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+}
+
+static void Mdc_StdAtomic_AssertLoadStoreExchange(void) {
+  atomic_int value;
+  int old_value;
+
+  atomic_init(&value, 1);
+  assert(atomic_load(&value) == 1);
+
+  atomic_store_explicit(&value, 2, memory_order_release);
+  assert(atomic_load_explicit(&value, memory_order_acquire) == 2);
+
+  old_value = (int) atomic_exchange(&value, 3);
+  assert(old_value == 2);
+  assert(atomic_load(&value) == 3);
+}
+
+static void Mdc_StdAtomic_AssertCompareExchange(void) {
+  atomic_long value;
+  long expected;
+  int is_exchanged;
+
+  atomic_init(&value, 5);
+
+  expected = 4;
+  is_exchanged = atomic_compare_exchange_strong(&value, &expected, 6);
+  assert(!is_exchanged);
+  assert(expected == 5);
+
+  is_exchanged = atomic_compare_exchange_strong(&value, &expected, 6);
+  assert(is_exchanged);
+  assert(expected == 5);
+  assert(atomic_load(&value) == 6);
+}
+
+static void Mdc_StdAtomic_AssertFetchOps(void) {
+  atomic_uint value;
+
+  atomic_init(&value, 0x0F);
+
+  assert(atomic_fetch_add(&value, 1) == 0x0F);
+  assert(atomic_fetch_sub(&value, 2) == 0x10);
+  assert(atomic_fetch_or(&value, 0xF0) == 0x0E);
+  assert(atomic_fetch_and(&value, 0x3C) == 0xFE);
+  assert(atomic_fetch_xor(&value, 0xFF) == 0x3C);
+  assert(atomic_load(&value) == 0xC3);
+}
+
+static void Mdc_StdAtomic_AssertFlag(void) {
+  atomic_flag flag = ATOMIC_FLAG_INIT;
+
+  assert(!atomic_flag_test_and_set(&flag));
+  assert(atomic_flag_test_and_set(&flag));
+
+  atomic_flag_clear(&flag);
+  assert(!atomic_flag_test_and_set(&flag));
+
+  atomic_thread_fence(memory_order_seq_cst);
+  atomic_signal_fence(memory_order_seq_cst);
+}
+
+static void Mdc_StdAtomic_AssertConcurrentCounters(void) {
+  atomic_long counter;
+  struct SpinLockedCounter spin_locked_counter = {
+      ATOMIC_FLAG_INIT,
+      0
+  };
+
+  atomic_init(&counter, 0);
+  RunThreads(&FetchAddCounter, (void*) &counter);
+  assert(atomic_load(&counter) == kThreadsCount * kIncrementsCount);
+
+  atomic_store(&counter, 0);
+  RunThreads(&CompareExchangeCounter, (void*) &counter);
+  assert(atomic_load(&counter) == kThreadsCount * kIncrementsCount);
+
+  RunThreads(&SpinLockedIncrement, &spin_locked_counter);
+  assert(spin_locked_counter.value == kThreadsCount * kIncrementsCount);
+}
+
+void Mdc_StdAtomic_RunTests(void) {
+  Mdc_StdAtomic_AssertLoadStoreExchange();
+  Mdc_StdAtomic_AssertCompareExchange();
+  Mdc_StdAtomic_AssertFetchOps();
+  Mdc_StdAtomic_AssertFlag();
+  Mdc_StdAtomic_AssertConcurrentCounters();
+}
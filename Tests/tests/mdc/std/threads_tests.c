@@ -33,37 +33,57 @@
 #include <stdio.h>
 #include <string.h>
 
-#if defined(__GNUC__)
-#include <unistd.h>
-#endif
-
 #include <mdc/std/threads.h>
 
+#include "../test_deadline.h"
+
 struct MutexedValue {
   mtx_t mutex;
   int value;
 };
 
+struct CondFlag {
+  mtx_t mutex;
+  cnd_t cond;
+  int is_set;
+};
+
+struct BroadcastFlag {
+  struct CondFlag cond_flag;
+  int waiting_count;
+};
+
 enum {
   kOnceDefaultValue = 0,
   kOnceTargetValue = 42
 };
 
+enum {
+  kThreadResult = 42,
+  kThreadExitResult = -42
+};
+
+enum {
+  kBroadcastWaitersCount = 32
+};
+
 static int once_value = kOnceDefaultValue;
 
+static tss_t tss_key;
+
 static int Increment(void* value) {
   int* actual_value = (int*) value;
   int temp;
+  struct timespec sleep_duration;
+
+  sleep_duration.tv_sec = 0;
+  sleep_duration.tv_nsec = 1000;
 
   /* Separate operations on a copy forces a race condition. */
   temp = *actual_value;
   temp += 1;
 
-  #if defined(_MSC_VER) || defined(__MINGW32__)
-  Sleep(1);
-  #elif defined(__GNUC__)
-  usleep(1);
-  #endif
+  thrd_sleep(&sleep_duration, NULL);
 
   *actual_value = temp;
 
@@ -86,6 +106,152 @@ static int MutexedIncrement(void* arg) {
   return 0;
 }
 
+static int RecursiveMutexedIncrement(void* arg) {
+  struct MutexedValue* mutexed_value = arg;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+
+  mtx_lock_result = mtx_lock(&mutexed_value->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  MutexedIncrement(mutexed_value);
+
+  mtx_unlock_result = mtx_unlock(&mutexed_value->mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  return 0;
+}
+
+static int TimedLockExpectTimeout(void* arg) {
+  mtx_t* mutex = arg;
+  struct timespec time_point;
+  int mtx_timedlock_result;
+
+  Mdc_TestDeadline_Get(&time_point);
+
+  mtx_timedlock_result = mtx_timedlock(mutex, &time_point);
+  assert(mtx_timedlock_result == thrd_timedout);
+
+  return 0;
+}
+
+static int TimedLockExpectInvalid(void* arg) {
+  mtx_t* mutex = arg;
+  struct timespec time_point;
+  int mtx_timedlock_result;
+
+  Mdc_TestDeadline_Get(&time_point);
+  time_point.tv_nsec = Mdc_TestDeadline_kNanosecondsPerSecond;
+
+  /* An invalid time point must fail rather than wait forever. */
+  mtx_timedlock_result = mtx_timedlock(mutex, &time_point);
+  assert(mtx_timedlock_result != thrd_success);
+
+  return 0;
+}
+
+static int ReturnThreadResult(void* arg) {
+  (void) arg;
+
+  return kThreadResult;
+}
+
+static int ExitThreadResult(void* arg) {
+  (void) arg;
+
+  thrd_exit(kThreadExitResult);
+
+  return 0;
+}
+
+static void DestroyTssValue(void* value) {
+  MutexedIncrement(value);
+}
+
+static int SetTssValue(void* arg) {
+  int tss_set_result;
+
+  assert(tss_get(tss_key) == NULL);
+
+  tss_set_result = tss_set(tss_key, arg);
+  assert(tss_set_result == thrd_success);
+
+  assert(tss_get(tss_key) == arg);
+
+  return 0;
+}
+
+static int SetCondFlag(void* arg) {
+  struct CondFlag* cond_flag = arg;
+  int mtx_lock_result;
+  int mtx_unlock_result;
+  int cnd_signal_result;
+
+  mtx_lock_result = mtx_lock(&cond_flag->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  cond_flag->is_set = 1;
+
+  cnd_signal_result = cnd_signal(&cond_flag->cond);
+  assert(cnd_signal_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&cond_flag->mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  return 0;
+}
+
+static int WaitForBroadcast(void* arg) {
+  struct BroadcastFlag* broadcast_flag = arg;
+  struct CondFlag* cond_flag = &broadcast_flag->cond_flag;
+  struct timespec time_point;
+  int is_timed;
+  int mtx_lock_result;
+  int cnd_wait_result;
+  int mtx_unlock_result;
+
+  /* Long enough that only a missed broadcast would time out. */
+  timespec_get(&time_point, TIME_UTC);
+  time_point.tv_sec += 10;
+
+  mtx_lock_result = mtx_lock(&cond_flag->mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  is_timed = broadcast_flag->waiting_count % 2;
+  broadcast_flag->waiting_count += 1;
+
+  while (!cond_flag->is_set) {
+    if (is_timed) {
+      cnd_wait_result = cnd_timedwait(
+          &cond_flag->cond,
+          &cond_flag->mutex,
+          &time_point
+      );
+    } else {
+      cnd_wait_result = cnd_wait(&cond_flag->cond, &cond_flag->mutex);
+    }
+
+    assert(cnd_wait_result == thrd_success);
+  }
+
+  broadcast_flag->waiting_count -= 1;
+
+  mtx_unlock_result = mtx_unlock(&cond_flag->mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  return 0;
+}
+
+static int TryLockExpectBusy(void* arg) {
+  mtx_t* mutex = arg;
+  int mtx_trylock_result;
+
+  mtx_trylock_result = mtx_trylock(mutex);
+  assert(mtx_trylock_result == thrd_busy);
+
+  return 0;
+}
+
 static void SetOnceTarget(void) {
   size_t i;
 
@@ -138,6 +304,71 @@ static void Mdc_Threads_AssertRaceCondition(void) {
   assert(value <= kThreadsCount);
 }
 
+static void Mdc_Threads_AssertJoinResult(void) {
+  enum {
+    kThreadsCount = 128
+  };
+
+  thrd_t threads[kThreadsCount];
+  int results[kThreadsCount];
+
+  size_t i;
+  int thread_create_result;
+  int thread_join_result;
+
+  /* Spawn more threads than there are pooled start blocks. */
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        (i % 2 == 0) ? &ReturnThreadResult : &ExitThreadResult,
+        NULL
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_join_result = thrd_join(threads[i], &results[i]);
+    assert(thread_join_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    if (i % 2 == 0) {
+      assert(results[i] == kThreadResult);
+    } else {
+      assert(results[i] == kThreadExitResult);
+    }
+  }
+}
+
+static void Mdc_Threads_AssertSleep(void) {
+  struct timespec duration;
+  struct timespec start;
+  struct timespec end;
+  long elapsed_nanoseconds;
+
+  int sleep_result;
+
+  duration.tv_sec = 0;
+  duration.tv_nsec = Mdc_TestDeadline_kTimeoutNanoseconds;
+
+  timespec_get(&start, TIME_UTC);
+  sleep_result = thrd_sleep(&duration, NULL);
+  timespec_get(&end, TIME_UTC);
+
+  assert(sleep_result == 0);
+
+  elapsed_nanoseconds = (long) (end.tv_sec - start.tv_sec)
+      * Mdc_TestDeadline_kNanosecondsPerSecond
+      + (end.tv_nsec - start.tv_nsec);
+  assert(elapsed_nanoseconds >= Mdc_TestDeadline_kTimeoutNanoseconds);
+
+  /* An invalid duration is neither a success nor an interruption. */
+  duration.tv_nsec = -1;
+
+  sleep_result = thrd_sleep(&duration, NULL);
+  assert(sleep_result < -1);
+}
+
 static void Mdc_Threads_AssertMutexLockUnlockSingle(void) {
   struct MutexedValue value;
 
@@ -187,6 +418,323 @@ static void Mdc_Threads_AssertMutexLockUnlockMulti(void) {
   mtx_destroy(&value.mutex);
 }
 
+static void Mdc_Threads_AssertRecursiveMutexLockUnlockMulti(void) {
+  enum {
+    kThreadsCount = 256
+  };
+
+  thrd_t threads[kThreadsCount];
+  struct MutexedValue value;
+
+  size_t i;
+  int mtx_init_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  value.value = 0;
+
+  mtx_init_result = mtx_init(&value.mutex, mtx_plain | mtx_recursive);
+  assert(mtx_init_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &RecursiveMutexedIncrement,
+        &value
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(value.value == kThreadsCount);
+
+  mtx_destroy(&value.mutex);
+}
+
+static void Mdc_Threads_AssertMutexTryLock(void) {
+  mtx_t mutex;
+  thrd_t thread;
+
+  int mtx_init_result;
+  int mtx_trylock_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  mtx_trylock_result = mtx_trylock(&mutex);
+  assert(mtx_trylock_result == thrd_success);
+
+  thread_create_result = thrd_create(&thread, &TryLockExpectBusy, &mutex);
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  mtx_destroy(&mutex);
+}
+
+static void Mdc_Threads_AssertMutexTimedLock(void) {
+  mtx_t mutex;
+  thrd_t thread;
+  struct timespec time_point;
+
+  int mtx_init_result;
+  int mtx_lock_result;
+  int mtx_timedlock_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&mutex, mtx_timed);
+  assert(mtx_init_result == thrd_success);
+
+  mtx_lock_result = mtx_lock(&mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  thread_create_result = thrd_create(
+      &thread,
+      &TimedLockExpectTimeout,
+      &mutex
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  thread_create_result = thrd_create(
+      &thread,
+      &TimedLockExpectInvalid,
+      &mutex
+  );
+  assert(thread_create_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  Mdc_TestDeadline_Get(&time_point);
+
+  mtx_timedlock_result = mtx_timedlock(&mutex, &time_point);
+  assert(mtx_timedlock_result == thrd_success);
+
+  mtx_unlock_result = mtx_unlock(&mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  mtx_destroy(&mutex);
+}
+
+static void Mdc_Threads_AssertCondTimedWaitTimeout(void) {
+  struct CondFlag cond_flag;
+  struct timespec time_point;
+
+  int mtx_init_result;
+  int cnd_init_result;
+  int mtx_lock_result;
+  int cnd_timedwait_result;
+  int mtx_unlock_result;
+
+  mtx_init_result = mtx_init(&cond_flag.mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  cnd_init_result = cnd_init(&cond_flag.cond);
+  assert(cnd_init_result == thrd_success);
+
+  mtx_lock_result = mtx_lock(&cond_flag.mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  Mdc_TestDeadline_Get(&time_point);
+
+  do {
+    cnd_timedwait_result = cnd_timedwait(
+        &cond_flag.cond,
+        &cond_flag.mutex,
+        &time_point
+    );
+  } while (cnd_timedwait_result == thrd_success);
+
+  assert(cnd_timedwait_result == thrd_timedout);
+
+  mtx_unlock_result = mtx_unlock(&cond_flag.mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  cnd_destroy(&cond_flag.cond);
+  mtx_destroy(&cond_flag.mutex);
+}
+
+static void Mdc_Threads_AssertCondTimedWaitSignal(void) {
+  struct CondFlag cond_flag;
+  struct timespec time_point;
+  thrd_t thread;
+
+  int mtx_init_result;
+  int cnd_init_result;
+  int mtx_lock_result;
+  int cnd_timedwait_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&cond_flag.mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  cnd_init_result = cnd_init(&cond_flag.cond);
+  assert(cnd_init_result == thrd_success);
+
+  cond_flag.is_set = 0;
+
+  mtx_lock_result = mtx_lock(&cond_flag.mutex);
+  assert(mtx_lock_result == thrd_success);
+
+  thread_create_result = thrd_create(&thread, &SetCondFlag, &cond_flag);
+  assert(thread_create_result == thrd_success);
+
+  /* Long enough that only a missed signal would time out. */
+  timespec_get(&time_point, TIME_UTC);
+  time_point.tv_sec += 10;
+
+  while (!cond_flag.is_set) {
+    cnd_timedwait_result = cnd_timedwait(
+        &cond_flag.cond,
+        &cond_flag.mutex,
+        &time_point
+    );
+    assert(cnd_timedwait_result == thrd_success);
+  }
+
+  mtx_unlock_result = mtx_unlock(&cond_flag.mutex);
+  assert(mtx_unlock_result == thrd_success);
+
+  thread_join_result = thrd_join(thread, NULL);
+  assert(thread_join_result == thrd_success);
+
+  cnd_destroy(&cond_flag.cond);
+  mtx_destroy(&cond_flag.mutex);
+}
+
+static void Mdc_Threads_AssertCondBroadcast(void) {
+  struct BroadcastFlag broadcast_flag;
+  struct CondFlag* cond_flag = &broadcast_flag.cond_flag;
+  thrd_t threads[kBroadcastWaitersCount];
+  size_t i;
+  int waiting_count;
+
+  int mtx_init_result;
+  int cnd_init_result;
+  int mtx_lock_result;
+  int cnd_broadcast_result;
+  int mtx_unlock_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  mtx_init_result = mtx_init(&cond_flag->mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  cnd_init_result = cnd_init(&cond_flag->cond);
+  assert(cnd_init_result == thrd_success);
+
+  cond_flag->is_set = 0;
+  broadcast_flag.waiting_count = 0;
+
+  for (i = 0; i < kBroadcastWaitersCount; ++i) {
+    thread_create_result = thrd_create(
+        &threads[i],
+        &WaitForBroadcast,
+        &broadcast_flag
+    );
+    assert(thread_create_result == thrd_success);
+  }
+
+  /* Broadcast once every thread is waiting on the condition. */
+  do {
+    thrd_yield();
+
+    mtx_lock_result = mtx_lock(&cond_flag->mutex);
+    assert(mtx_lock_result == thrd_success);
+
+    waiting_count = broadcast_flag.waiting_count;
+    if (waiting_count == kBroadcastWaitersCount) {
+      cond_flag->is_set = 1;
+
+      cnd_broadcast_result = cnd_broadcast(&cond_flag->cond);
+      assert(cnd_broadcast_result == thrd_success);
+    }
+
+    mtx_unlock_result = mtx_unlock(&cond_flag->mutex);
+    assert(mtx_unlock_result == thrd_success);
+  } while (waiting_count < kBroadcastWaitersCount);
+
+  for (i = 0; i < kBroadcastWaitersCount; ++i) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  assert(broadcast_flag.waiting_count == 0);
+
+  cnd_destroy(&cond_flag->cond);
+  mtx_destroy(&cond_flag->mutex);
+}
+
+static void Mdc_Threads_AssertTss(void) {
+  enum {
+    kThreadsCount = 16
+  };
+
+  thrd_t threads[kThreadsCount];
+  struct MutexedValue value;
+  int main_value;
+
+  size_t i;
+  int mtx_init_result;
+  int tss_create_result;
+  int tss_set_result;
+  int thread_create_result;
+  int thread_join_result;
+
+  value.value = 0;
+
+  mtx_init_result = mtx_init(&value.mutex, mtx_plain);
+  assert(mtx_init_result == thrd_success);
+
+  tss_create_result = tss_create(&tss_key, &DestroyTssValue);
+  assert(tss_create_result == thrd_success);
+
+  tss_set_result = tss_set(tss_key, &main_value);
+  assert(tss_set_result == thrd_success);
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_create_result = thrd_create(&threads[i], &SetTssValue, &value);
+    assert(thread_create_result == thrd_success);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    thread_join_result = thrd_join(threads[i], NULL);
+    assert(thread_join_result == thrd_success);
+  }
+
+  /* Each thread's destructor ran on exit; the main value is intact. */
+  assert(value.value == kThreadsCount);
+  assert(tss_get(tss_key) == &main_value);
+
+  tss_set_result = tss_set(tss_key, NULL);
+  assert(tss_set_result == thrd_success);
+
+  tss_delete(tss_key);
+
+  mtx_destroy(&value.mutex);
+}
+
 static void Mdc_Threads_AssertCallOnceSingle(void) {
   const once_flag kInitOnceFlag = ONCE_FLAG_INIT;
 
@@ -234,8 +782,17 @@ static void Mdc_Threads_AssertCallOnceMulti(void) {
 
 void Mdc_Threads_RunTests(void) {
   Mdc_Threads_AssertRaceCondition();
+  Mdc_Threads_AssertJoinResult();
+  Mdc_Threads_AssertSleep();
   Mdc_Threads_AssertMutexLockUnlockSingle();
   Mdc_Threads_AssertMutexLockUnlockMulti();
+  Mdc_Threads_AssertRecursiveMutexLockUnlockMulti();
+  Mdc_Threads_AssertMutexTryLock();
+  Mdc_Threads_AssertMutexTimedLock();
+  Mdc_Threads_AssertCondTimedWaitTimeout();
+  Mdc_Threads_AssertCondTimedWaitSignal();
+  Mdc_Threads_AssertCondBroadcast();
+  Mdc_Threads_AssertTss();
   Mdc_Threads_AssertCallOnceSingle();
   Mdc_Threads_AssertCallOnceMulti();
 }
@@ -32,12 +32,14 @@
 #include <stdio.h>
 
 #include "std/assert_tests.h"
+#include "std/stdatomic_tests.h"
 #include "std/stdbool_tests.h"
 #include "std/stdint_tests.h"
 #include "std/threads_tests.h"
 
 void Mdc_Std_RunTests(void) {
   Mdc_Assert_RunTests();
+  Mdc_StdAtomic_RunTests();
   Mdc_StdBool_RunTests();
   Mdc_StdInt_RunTests();
   Mdc_Threads_RunTests();
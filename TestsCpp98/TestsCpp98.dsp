@@ -147,6 +147,42 @@ LINK32=link.exe
 # Begin Group "mdc"
 
 # PROP Default_Filter ""
+# Begin Group "concurrency"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\adaptive_mutex_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\adaptive_mutex_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mcs_lock_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mcs_lock_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mpmc_queue_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\mpmc_queue_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_pool_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency\thread_pool_tests.hpp
+# End Source File
+# End Group
 # Begin Group "error"
 
 # PROP Default_Filter ""
@@ -159,6 +195,18 @@ SOURCE=.\tests\mdc\error\exit_on_error_tests.cpp
 SOURCE=.\tests\mdc\error\exit_on_error_tests.hpp
 # End Source File
 # End Group
+# Begin Group "malloc"
+
+# PROP Default_Filter ""
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\arena_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc\arena_tests.hpp
+# End Source File
+# End Group
 # Begin Group "std"
 
 # PROP Default_Filter ""
@@ -176,6 +224,38 @@ SOURCE=.\tests\mdc\std\std_example_funcs\std_increment.hpp
 # End Group
 # Begin Source File
 
+SOURCE=.\tests\mdc\std\atomic_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\atomic_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\barrier_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\barrier_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\condition_variable_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\condition_variable_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\latch_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\latch_tests.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\std\mutex_tests.cpp
 # End Source File
 # Begin Source File
@@ -200,12 +280,36 @@ SOURCE=.\tests\mdc\std\recursive_mutex_tests.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\tests\mdc\std\semaphore_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\semaphore_tests.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\shared_mutex_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\shared_mutex_tests.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\std\thread_tests.cpp
 # End Source File
 # Begin Source File
 
 SOURCE=.\tests\mdc\std\thread_tests.hpp
 # End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\timed_mutex_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\std\timed_mutex_tests.hpp
+# End Source File
 # End Group
 # Begin Group "wchar_t"
 
@@ -241,6 +345,14 @@ SOURCE=.\tests\mdc\wchar_t\wide_encoding_tests.hpp
 # End Group
 # Begin Source File
 
+SOURCE=.\tests\mdc\concurrency_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\concurrency_tests.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\error_tests.cpp
 # End Source File
 # Begin Source File
@@ -253,6 +365,14 @@ SOURCE=.\tests\mdc\main.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\tests\mdc\malloc_tests.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\tests\mdc\malloc_tests.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\tests\mdc\std_tests.cpp
 # End Source File
 # Begin Source File
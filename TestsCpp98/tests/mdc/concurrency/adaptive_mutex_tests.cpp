@@ -0,0 +1,109 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "adaptive_mutex_tests.hpp"
+
+#include <mdc/concurrency/adaptive_mutex.hpp>
+#include <mdc/std/assert.h>
+#include <mdc/std/mutex.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace concurrency_test {
+namespace {
+
+enum {
+  kIncrementsCount = 10000
+};
+
+struct GuardedCounter {
+  ::mdc::AdaptiveMutex mutex;
+  long value;
+};
+
+static int IncrementCounter(void* arg) {
+  GuardedCounter* counter = static_cast<GuardedCounter*>(arg);
+
+  for (int i = 0; i < kIncrementsCount; i += 1) {
+    ::std::lock_guard< ::mdc::AdaptiveMutex> lock(counter->mutex);
+
+    counter->value += 1;
+  }
+
+  return 0;
+}
+
+static int TryLockExpectBusy(void* arg) {
+  ::mdc::AdaptiveMutex* mutex = static_cast< ::mdc::AdaptiveMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock();
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+static void AssertTryLock() {
+  ::mdc::AdaptiveMutex mutex;
+
+  ::std::unique_lock< ::mdc::AdaptiveMutex> lock(mutex);
+  assert(lock.owns_lock());
+
+  ::std::thread thread(&TryLockExpectBusy, &mutex);
+  thread.join();
+
+  lock.unlock();
+
+  bool is_lock_success = mutex.try_lock();
+  assert(is_lock_success);
+
+  mutex.unlock();
+}
+
+static void AssertMutualExclusion() {
+  GuardedCounter counter;
+  counter.value = 0;
+
+  ::std::thread first_thread(&IncrementCounter, &counter);
+  ::std::thread second_thread(&IncrementCounter, &counter);
+
+  first_thread.join();
+  second_thread.join();
+
+  assert(counter.value == 2 * kIncrementsCount);
+}
+
+} // namespace
+
+void AdaptiveMutex_RunTests() {
+  AssertTryLock();
+  AssertMutualExclusion();
+}
+
+} // namespace concurrency_test
+} // namespace mdc_test
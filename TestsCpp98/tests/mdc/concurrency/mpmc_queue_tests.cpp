@@ -0,0 +1,105 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "mpmc_queue_tests.hpp"
+
+#include <stddef.h>
+
+#include <mdc/concurrency/mpmc_queue.hpp>
+#include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace concurrency_test {
+namespace {
+
+enum {
+  kCapacity = 4,
+  kElementsCount = 10000
+};
+
+static int PushSequence(void* arg) {
+  ::mdc::MpmcQueue<int>* queue = static_cast< ::mdc::MpmcQueue<int>*>(arg);
+
+  for (int i = 0; i < kElementsCount; i += 1) {
+    queue->Push(i);
+  }
+
+  return 0;
+}
+
+static void AssertTryPushPop() {
+  ::mdc::MpmcQueue<int> queue(kCapacity);
+  assert(queue.capacity() == kCapacity);
+
+  int value;
+  assert(!queue.TryPop(value));
+
+  for (int i = 0; i < kCapacity; i += 1) {
+    assert(queue.TryPush(i));
+  }
+
+  assert(!queue.TryPush(kCapacity));
+  assert(!queue.TryPushFor(kCapacity, ::std::chrono::milliseconds(10)));
+
+  for (int i = 0; i < kCapacity; i += 1) {
+    assert(queue.TryPopUntil(
+        value,
+        ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(10)
+    ));
+    assert(value == i);
+  }
+
+  assert(!queue.TryPopFor(value, ::std::chrono::milliseconds(10)));
+}
+
+static void AssertBlockingHandoff() {
+  ::mdc::MpmcQueue<int> queue(kCapacity);
+
+  ::std::thread thread(&PushSequence, &queue);
+
+  for (int i = 0; i < kElementsCount; i += 1) {
+    int value;
+    queue.Pop(value);
+    assert(value == i);
+  }
+
+  thread.join();
+}
+
+} // namespace
+
+void MpmcQueue_RunTests() {
+  AssertTryPushPop();
+  AssertBlockingHandoff();
+}
+
+} // namespace concurrency_test
+} // namespace mdc_test
@@ -0,0 +1,134 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "thread_pool_tests.hpp"
+
+#include <stddef.h>
+
+#include <mdc/concurrency/thread_pool.hpp>
+#include <mdc/std/assert.h>
+#include <mdc/std/mutex.hpp>
+
+namespace mdc_test {
+namespace concurrency_test {
+namespace {
+
+enum {
+  kWorkersCount = 4,
+  kTasksCount = 10000
+};
+
+struct Counter {
+  ::std::mutex mutex;
+  int value;
+};
+
+static void IncrementCounter(void* arg) {
+  Counter* counter = static_cast<Counter*>(arg);
+
+  ::std::lock_guard< ::std::mutex> lock(counter->mutex);
+  counter->value += 1;
+}
+
+class AddToCounter {
+ public:
+  AddToCounter(Counter* counter, int amount)
+      : counter_(counter),
+        amount_(amount) {
+  }
+
+  void operator()() const {
+    ::std::lock_guard< ::std::mutex> lock(this->counter_->mutex);
+    this->counter_->value += this->amount_;
+  }
+
+ private:
+  Counter* counter_;
+  int amount_;
+};
+
+static void AssertSubmitFunction() {
+  Counter counter;
+  counter.value = 0;
+
+  ::mdc::ThreadPool pool(kWorkersCount);
+  assert(pool.workers_count() == kWorkersCount);
+
+  for (size_t i = 0; i < kTasksCount; i += 1) {
+    pool.Submit(&IncrementCounter, &counter);
+  }
+
+  pool.WaitIdle();
+  assert(counter.value == kTasksCount);
+}
+
+static void AssertSubmitFunctionObject() {
+  Counter counter;
+  counter.value = 0;
+
+  {
+    ::mdc::ThreadPool pool(kWorkersCount);
+
+    for (size_t i = 0; i < kTasksCount; i += 1) {
+      pool.Submit(AddToCounter(&counter, 2));
+    }
+  }
+
+  // The destructor waits for every submitted task.
+  assert(counter.value == kTasksCount * 2);
+}
+
+static void AssertSubmitBatch() {
+  Counter counter;
+  counter.value = 0;
+
+  ::mdc::ThreadPool::Task tasks[kTasksCount];
+  for (size_t i = 0; i < kTasksCount; i += 1) {
+    tasks[i].func = &IncrementCounter;
+    tasks[i].arg = &counter;
+  }
+
+  ::mdc::ThreadPool pool;
+
+  pool.SubmitBatch(tasks, kTasksCount);
+  pool.WaitIdle();
+
+  assert(counter.value == kTasksCount);
+}
+
+} // namespace
+
+void ThreadPool_RunTests() {
+  AssertSubmitFunction();
+  AssertSubmitFunctionObject();
+  AssertSubmitBatch();
+}
+
+} // namespace concurrency_test
+} // namespace mdc_test
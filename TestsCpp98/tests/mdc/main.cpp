@@ -31,7 +31,9 @@
 #include <stddef.h>
 #include <windows.h>
 
+#include "concurrency_tests.hpp"
 #include "error_tests.hpp"
+#include "malloc_tests.hpp"
 #include "std_tests.hpp"
 #include "wchar_t_tests.hpp"
 
@@ -45,6 +47,8 @@ int main(int argc, char** argv) {
   // ::mdc_test::error_test::RunTests();
 
   ::mdc_test::std_test::RunTests();
+  ::mdc_test::concurrency_test::RunTests();
+  ::mdc_test::malloc_test::RunTests();
   ::mdc_test::wide_test::RunTests();
 
   return 0;
@@ -0,0 +1,134 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "arena_tests.hpp"
+
+#include <stddef.h>
+
+#include <list>
+#include <map>
+#include <new>
+#include <vector>
+
+#include <mdc/malloc/arena.hpp>
+#include <mdc/std/assert.h>
+
+namespace mdc_test {
+namespace malloc_test {
+namespace {
+
+enum {
+  kBlockSize = 1024,
+  kElementsCount = 1000
+};
+
+static void AssertAllocate() {
+  ::mdc::Arena arena(kBlockSize);
+
+  int* first = static_cast<int*>(arena.Allocate(sizeof(int)));
+  *first = 42;
+
+  void* aligned = arena.AllocateAligned(16, 64);
+  assert(reinterpret_cast<size_t>(aligned) % 64 == 0);
+
+  ::mdc::Arena::mark_type mark = arena.GetMark();
+  void* marked = arena.Allocate(32);
+
+  arena.Rewind(mark);
+  assert(arena.Allocate(32) == marked);
+
+  arena.Reset();
+  assert(arena.Allocate(sizeof(int)) == first);
+
+  bool is_thrown = false;
+
+  try {
+    arena.AllocateAligned(8, 3);
+  } catch (const ::std::bad_alloc&) {
+    is_thrown = true;
+  }
+
+  assert(is_thrown);
+}
+
+static void AssertVector() {
+  ::mdc::Arena arena(kBlockSize);
+  ::mdc::ArenaAllocator<int> allocator(arena);
+
+  ::std::vector<int, ::mdc::ArenaAllocator<int> > values(allocator);
+
+  for (int i = 0; i < kElementsCount; i += 1) {
+    values.push_back(i);
+  }
+
+  for (int i = 0; i < kElementsCount; i += 1) {
+    assert(values[i] == i);
+  }
+}
+
+static void AssertRebind() {
+  typedef ::mdc::ArenaAllocator< ::std::pair<const int, int> > PairAllocator;
+
+  ::mdc::Arena arena(kBlockSize);
+  ::mdc::ArenaAllocator<int> int_allocator(arena);
+  PairAllocator pair_allocator(int_allocator);
+
+  assert(pair_allocator == int_allocator);
+
+  ::std::list<int, ::mdc::ArenaAllocator<int> > list(int_allocator);
+  ::std::map<int, int, ::std::less<int>, PairAllocator> map(
+      ::std::less<int>(),
+      pair_allocator
+  );
+
+  for (int i = 0; i < kElementsCount; i += 1) {
+    list.push_back(i);
+    map[i] = i * 2;
+  }
+
+  assert(list.size() == kElementsCount);
+  assert(map.size() == kElementsCount);
+  assert(map[kElementsCount - 1] == (kElementsCount - 1) * 2);
+
+  ::mdc::Arena other_arena(kBlockSize);
+  ::mdc::ArenaAllocator<int> other_allocator(other_arena);
+
+  assert(other_allocator != int_allocator);
+}
+
+} // namespace
+
+void Arena_RunTests() {
+  AssertAllocate();
+  AssertVector();
+  AssertRebind();
+}
+
+} // namespace malloc_test
+} // namespace mdc_test
@@ -0,0 +1,168 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "atomic_tests.hpp"
+
+#include <stddef.h>
+
+#include <mdc/std/assert.h>
+#include <mdc/std/atomic.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+enum {
+  kThreadsCount = 4,
+  kIncrementsCount = 10000
+};
+
+struct SpinLockedCounter {
+  ::std::atomic_flag flag;
+  long value;
+};
+
+static int IncrementCounter(void* arg) {
+  ::std::atomic_long* counter = reinterpret_cast< ::std::atomic_long*>(arg);
+
+  for (size_t i = 0; i < kIncrementsCount; ++i) {
+    ++(*counter);
+  }
+
+  return 0;
+}
+
+static int SpinLockedIncrement(void* arg) {
+  SpinLockedCounter* counter = reinterpret_cast<SpinLockedCounter*>(arg);
+
+  for (size_t i = 0; i < kIncrementsCount; ++i) {
+    while (counter->flag.test_and_set(::std::memory_order_acquire)) {
+    }
+
+    counter->value += 1;
+
+    counter->flag.clear(::std::memory_order_release);
+  }
+
+  return 0;
+}
+
+static void RunThreads(int (*func)(void*), void* arg) {
+  ::std::thread* threads[kThreadsCount];
+
+  for (size_t i = 0; i < kThreadsCount; ++i) {
+    threads[i] = new ::std::thread(func, arg);
+  }
+
+  for (size_t i = 0; i < kThreadsCount; ++i) {
+    threads[i]->join();
+    delete threads[i];
+  }
+}
+
+static void AssertIntegral() {
+  ::std::atomic<int> value(1);
+
+  assert(value.load() == 1);
+
+  value.store(2, ::std::memory_order_release);
+  assert(value.load(::std::memory_order_acquire) == 2);
+
+  assert(value.exchange(3) == 2);
+
+  int expected = 4;
+  assert(!value.compare_exchange_strong(expected, 5));
+  assert(expected == 3);
+  assert(value.compare_exchange_strong(expected, 5));
+  assert(value == 5);
+
+  assert(value++ == 5);
+  assert(++value == 7);
+  assert(value-- == 7);
+  assert(--value == 5);
+  assert((value += 10) == 15);
+  assert((value -= 5) == 10);
+  assert((value |= 0x5) == 0xF);
+  assert((value &= 0x6) == 0x6);
+  assert((value ^= 0x3) == 0x5);
+}
+
+static void AssertPointer() {
+  int values[4] = { 0, 1, 2, 3 };
+  ::std::atomic<int*> ptr(&values[0]);
+
+  assert(ptr.fetch_add(2) == &values[0]);
+  assert(ptr.load() == &values[2]);
+  assert(*ptr == 2);
+
+  assert(--ptr == &values[1]);
+  assert((ptr += 2) == &values[3]);
+
+  int* expected = &values[3];
+  assert(ptr.compare_exchange_strong(expected, &values[0]));
+  assert(ptr == &values[0]);
+}
+
+static void AssertBool() {
+  ::std::atomic<bool> value(false);
+
+  assert(!value.exchange(true));
+  assert(value);
+
+  bool expected = false;
+  assert(!value.compare_exchange_strong(expected, false));
+  assert(expected);
+  assert(value.compare_exchange_weak(expected, false));
+  assert(!value.load());
+}
+
+static void AssertConcurrentCounters() {
+  ::std::atomic_long counter(0);
+  RunThreads(&IncrementCounter, &counter);
+  assert(counter == kThreadsCount * kIncrementsCount);
+
+  SpinLockedCounter spin_locked_counter = { ATOMIC_FLAG_INIT, 0 };
+  RunThreads(&SpinLockedIncrement, &spin_locked_counter);
+  assert(spin_locked_counter.value == kThreadsCount * kIncrementsCount);
+
+  ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+}
+
+} // namespace
+
+void Atomic_RunTests() {
+  AssertIntegral();
+  AssertPointer();
+  AssertBool();
+  AssertConcurrentCounters();
+}
+
+} // namespace std_test
+} // namespace mdc_test
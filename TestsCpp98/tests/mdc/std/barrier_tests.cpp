@@ -0,0 +1,115 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "barrier_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/barrier.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+enum {
+  kPhasesCount = 10
+};
+
+class CountPhase {
+ public:
+  explicit CountPhase(int* completed_phases_count)
+      : completed_phases_count_(completed_phases_count) {
+  }
+
+  void operator()() throw() {
+    *this->completed_phases_count_ += 1;
+  }
+
+ private:
+  int* completed_phases_count_;
+};
+
+static int RunPhases(void* arg) {
+  ::std::barrier<CountPhase>* barrier =
+      reinterpret_cast< ::std::barrier<CountPhase>*>(arg);
+
+  for (int i = 0; i < kPhasesCount; ++i) {
+    barrier->arrive_and_wait();
+  }
+
+  return 0;
+}
+
+static int ArriveAndDrop(void* arg) {
+  ::std::barrier<>* barrier = reinterpret_cast< ::std::barrier<>*>(arg);
+
+  barrier->arrive_and_drop();
+
+  return 0;
+}
+
+static void AssertPhases() {
+  int completed_phases_count = 0;
+  ::std::barrier<CountPhase> barrier(
+      2,
+      CountPhase(&completed_phases_count)
+  );
+
+  ::std::thread thread(&RunPhases, &barrier);
+
+  for (int i = 0; i < kPhasesCount; ++i) {
+    barrier.wait(barrier.arrive());
+
+    assert(completed_phases_count == i + 1);
+  }
+
+  thread.join();
+}
+
+static void AssertArriveAndDrop() {
+  ::std::barrier<> barrier(2);
+
+  ::std::thread thread(&ArriveAndDrop, &barrier);
+
+  barrier.arrive_and_wait();
+  thread.join();
+
+  // Later phases only expect the remaining thread.
+  barrier.arrive_and_wait();
+}
+
+} // namespace
+
+void Barrier_RunTests() {
+  AssertPhases();
+  AssertArriveAndDrop();
+}
+
+} // namespace std_test
+} // namespace mdc_test
@@ -0,0 +1,134 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "condition_variable_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/condition_variable.hpp>
+#include <mdc/std/mutex.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+template <class ConditionVariable>
+struct CondFlag {
+  ::std::mutex mutex;
+  ConditionVariable cond;
+  bool is_set;
+};
+
+template <class ConditionVariable>
+struct IsCondFlagSet {
+  explicit IsCondFlagSet(const CondFlag<ConditionVariable>& cond_flag)
+      : cond_flag(cond_flag) {
+  }
+
+  bool operator()() const {
+    return this->cond_flag.is_set;
+  }
+
+  const CondFlag<ConditionVariable>& cond_flag;
+};
+
+template <class ConditionVariable>
+static int SetCondFlag(void* arg) {
+  CondFlag<ConditionVariable>* cond_flag =
+      reinterpret_cast<CondFlag<ConditionVariable>*>(arg);
+
+  ::std::unique_lock< ::std::mutex> lock(cond_flag->mutex);
+  cond_flag->is_set = true;
+  cond_flag->cond.notify_one();
+
+  return 0;
+}
+
+template <class ConditionVariable>
+static void AssertWaitTimeout() {
+  CondFlag<ConditionVariable> cond_flag;
+  cond_flag.is_set = false;
+
+  ::std::unique_lock< ::std::mutex> lock(cond_flag.mutex);
+
+  bool is_pred_success = cond_flag.cond.wait_for(
+      lock,
+      ::std::chrono::milliseconds(10),
+      IsCondFlagSet<ConditionVariable>(cond_flag)
+  );
+  assert(!is_pred_success);
+
+  is_pred_success = cond_flag.cond.wait_until(
+      lock,
+      ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(10),
+      IsCondFlagSet<ConditionVariable>(cond_flag)
+  );
+  assert(!is_pred_success);
+
+  ::std::cv_status status = ::std::cv_status::no_timeout;
+  while (status == ::std::cv_status::no_timeout) {
+    status = cond_flag.cond.wait_for(lock, ::std::chrono::milliseconds(10));
+  }
+  assert(status == ::std::cv_status::timeout);
+}
+
+template <class ConditionVariable>
+static void AssertWaitNotify() {
+  CondFlag<ConditionVariable> cond_flag;
+  cond_flag.is_set = false;
+
+  ::std::unique_lock< ::std::mutex> lock(cond_flag.mutex);
+
+  ::std::thread thread(&SetCondFlag<ConditionVariable>, &cond_flag);
+
+  // Long enough that only a missed notification would time out.
+  bool is_pred_success = cond_flag.cond.wait_for(
+      lock,
+      ::std::chrono::seconds(10),
+      IsCondFlagSet<ConditionVariable>(cond_flag)
+  );
+  assert(is_pred_success);
+
+  lock.unlock();
+  thread.join();
+}
+
+} // namespace
+
+void ConditionVariable_RunTests() {
+  AssertWaitTimeout< ::std::condition_variable>();
+  AssertWaitTimeout< ::std::condition_variable_any>();
+
+  AssertWaitNotify< ::std::condition_variable>();
+  AssertWaitNotify< ::std::condition_variable_any>();
+}
+
+} // namespace std_test
+} // namespace mdc_test
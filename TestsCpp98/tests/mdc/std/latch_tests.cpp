@@ -0,0 +1,84 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "latch_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/latch.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+static int ArriveAndWait(void* arg) {
+  ::std::latch* latch = reinterpret_cast< ::std::latch*>(arg);
+
+  latch->arrive_and_wait();
+
+  return 0;
+}
+
+static void AssertCountDown() {
+  ::std::latch latch(2);
+
+  assert(!latch.try_wait());
+
+  latch.count_down();
+  assert(!latch.try_wait());
+
+  latch.count_down();
+  assert(latch.try_wait());
+
+  latch.wait();
+}
+
+static void AssertArriveAndWait() {
+  ::std::latch latch(3);
+
+  ::std::thread first_thread(&ArriveAndWait, &latch);
+  ::std::thread second_thread(&ArriveAndWait, &latch);
+
+  latch.arrive_and_wait();
+
+  first_thread.join();
+  second_thread.join();
+
+  assert(latch.try_wait());
+}
+
+} // namespace
+
+void Latch_RunTests() {
+  AssertCountDown();
+  AssertArriveAndWait();
+}
+
+} // namespace std_test
+} // namespace mdc_test
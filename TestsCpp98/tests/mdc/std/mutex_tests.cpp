@@ -55,6 +55,15 @@ static int MutexedIncrement(void* arg) {
   return 0;
 }
 
+static int TryLockExpectFailure(void* arg) {
+  ::std::mutex* mutex = reinterpret_cast< ::std::mutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock();
+  assert(!is_lock_success);
+
+  return 0;
+}
+
 static void AssertMutexLockUnlockSingle() {
   MutexedValue value;
 
@@ -88,11 +97,24 @@ static void AssertMutexLockUnlockMulti() {
   assert(value.value == kThreadsCount);
 }
 
+static void AssertMutexTryLock() {
+  ::std::mutex mutex;
+
+  bool is_lock_success = mutex.try_lock();
+  assert(is_lock_success);
+
+  ::std::thread thread(&TryLockExpectFailure, &mutex);
+  thread.join();
+
+  mutex.unlock();
+}
+
 } // namespace
 
 void Mutex_RunTests() {
   AssertMutexLockUnlockSingle();
   AssertMutexLockUnlockMulti();
+  AssertMutexTryLock();
 }
 
 } // namespace std_test
@@ -32,6 +32,8 @@
 #include <stddef.h>
 #include <stdio.h>
 
+#include <stdexcept>
+
 #include <mdc/std/assert.h>
 #include <mdc/std/mutex.hpp>
 #include <mdc/std/threads.hpp>
@@ -106,11 +108,74 @@ static void AssertCallOnceMulti(void) {
   assert(once_value == kOnceTargetValue);
 }
 
+class AddOnce {
+ public:
+  AddOnce(int* target, int amount) : target_(target), amount_(amount) {
+  }
+
+  void operator()() const {
+    *this->target_ += this->amount_;
+  }
+
+ private:
+  int* target_;
+  int amount_;
+};
+
+class ThrowOnce {
+ public:
+  explicit ThrowOnce(int* call_count) : call_count_(call_count) {
+  }
+
+  void operator()() const {
+    *this->call_count_ += 1;
+    throw ::std::runtime_error("ThrowOnce");
+  }
+
+ private:
+  int* call_count_;
+};
+
+static void AssertCallOnceCallable(void) {
+  ::std::once_flag flag;
+  int value = 0;
+
+  ::std::call_once(flag, AddOnce(&value, 3));
+  ::std::call_once(flag, AddOnce(&value, 5));
+
+  assert(value == 3);
+}
+
+static void AssertCallOnceException(void) {
+  ::std::once_flag flag;
+  int call_count = 0;
+  int value = 0;
+  bool is_thrown = false;
+
+  try {
+    ::std::call_once(flag, ThrowOnce(&call_count));
+  } catch (const ::std::runtime_error&) {
+    is_thrown = true;
+  }
+
+  assert(is_thrown);
+  assert(call_count == 1);
+
+  // The failed call leaves the flag unset.
+  ::std::call_once(flag, AddOnce(&value, 7));
+  ::std::call_once(flag, ThrowOnce(&call_count));
+
+  assert(value == 7);
+  assert(call_count == 1);
+}
+
 } // namespace
 
 void OnceFlag_RunTests() {
   AssertCallOnceSingle();
   AssertCallOnceMulti();
+  AssertCallOnceCallable();
+  AssertCallOnceException();
 }
 
 } // namespace std_test
@@ -0,0 +1,92 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "semaphore_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/semaphore.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+static int AcquireThenRelease(void* arg) {
+  ::std::binary_semaphore* semaphore =
+      reinterpret_cast< ::std::binary_semaphore*>(arg);
+
+  semaphore->acquire();
+  semaphore->release();
+
+  return 0;
+}
+
+static void AssertTryAcquire() {
+  ::std::counting_semaphore<2> semaphore(2);
+
+  assert(semaphore.try_acquire());
+  assert(semaphore.try_acquire());
+  assert(!semaphore.try_acquire());
+
+  bool is_acquire_success = semaphore.try_acquire_for(
+      ::std::chrono::milliseconds(10)
+  );
+  assert(!is_acquire_success);
+
+  semaphore.release(2);
+
+  is_acquire_success = semaphore.try_acquire_until(
+      ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(10)
+  );
+  assert(is_acquire_success);
+  assert(semaphore.try_acquire());
+}
+
+static void AssertBinarySemaphore() {
+  ::std::binary_semaphore semaphore(0);
+
+  ::std::thread thread(&AcquireThenRelease, &semaphore);
+
+  semaphore.release();
+  thread.join();
+
+  assert(semaphore.try_acquire());
+  assert(!semaphore.try_acquire());
+}
+
+} // namespace
+
+void Semaphore_RunTests() {
+  AssertTryAcquire();
+  AssertBinarySemaphore();
+}
+
+} // namespace std_test
+} // namespace mdc_test
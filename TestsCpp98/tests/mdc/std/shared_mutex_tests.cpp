@@ -0,0 +1,173 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "shared_mutex_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/shared_mutex.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+template <class SharedMutex>
+static int TryLockSharedExpectSuccess(void* arg) {
+  SharedMutex* mutex = reinterpret_cast<SharedMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_shared();
+  assert(is_lock_success);
+
+  mutex->unlock_shared();
+
+  return 0;
+}
+
+template <class SharedMutex>
+static int TryLockExpectBusy(void* arg) {
+  SharedMutex* mutex = reinterpret_cast<SharedMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock();
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+template <class SharedMutex>
+static int TryLockSharedExpectBusy(void* arg) {
+  SharedMutex* mutex = reinterpret_cast<SharedMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_shared();
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+static int TryLockForExpectTimeout(void* arg) {
+  ::std::shared_timed_mutex* mutex =
+      reinterpret_cast< ::std::shared_timed_mutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_for(
+      ::std::chrono::milliseconds(10)
+  );
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+static int TryLockSharedUntilExpectTimeout(void* arg) {
+  ::std::shared_timed_mutex* mutex =
+      reinterpret_cast< ::std::shared_timed_mutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_shared_until(
+      ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(10)
+  );
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+template <class SharedMutex>
+static void AssertSharedLock() {
+  SharedMutex mutex;
+
+  {
+    ::std::shared_lock<SharedMutex> lock(mutex);
+    assert(lock.owns_lock());
+
+    ::std::thread reader_thread(
+        &TryLockSharedExpectSuccess<SharedMutex>,
+        &mutex
+    );
+    reader_thread.join();
+
+    ::std::thread writer_thread(&TryLockExpectBusy<SharedMutex>, &mutex);
+    writer_thread.join();
+
+    lock.unlock();
+    assert(!lock.owns_lock());
+  }
+
+  bool is_lock_success = mutex.try_lock();
+  assert(is_lock_success);
+
+  mutex.unlock();
+}
+
+template <class SharedMutex>
+static void AssertExclusiveLock() {
+  SharedMutex mutex;
+
+  mutex.lock();
+
+  ::std::thread reader_thread(
+      &TryLockSharedExpectBusy<SharedMutex>,
+      &mutex
+  );
+  reader_thread.join();
+
+  ::std::thread writer_thread(&TryLockExpectBusy<SharedMutex>, &mutex);
+  writer_thread.join();
+
+  mutex.unlock();
+}
+
+static void AssertTryLockTimeout() {
+  ::std::shared_timed_mutex mutex;
+
+  mutex.lock_shared();
+
+  ::std::thread writer_thread(&TryLockForExpectTimeout, &mutex);
+  writer_thread.join();
+
+  mutex.unlock_shared();
+
+  mutex.lock();
+
+  ::std::thread reader_thread(&TryLockSharedUntilExpectTimeout, &mutex);
+  reader_thread.join();
+
+  mutex.unlock();
+}
+
+} // namespace
+
+void SharedMutex_RunTests() {
+  AssertSharedLock< ::std::shared_mutex>();
+  AssertSharedLock< ::std::shared_timed_mutex>();
+
+  AssertExclusiveLock< ::std::shared_mutex>();
+  AssertExclusiveLock< ::std::shared_timed_mutex>();
+
+  AssertTryLockTimeout();
+}
+
+} // namespace std_test
+} // namespace mdc_test
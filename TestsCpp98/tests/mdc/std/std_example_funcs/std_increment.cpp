@@ -29,11 +29,8 @@
 
 #include "std_increment.hpp"
 
-#if defined(_MSC_VER) || defined(__MINGW32__)
-  #include <windows.h>
-#elif defined(__GNUC__)
-  #include <unistd.h>
-#endif
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/threads.hpp>
 
 namespace mdc_test {
 namespace std_test {
@@ -43,11 +40,7 @@ void Increment(int* value) {
   int temp = *value;
   temp += 1;
 
-#if defined(_MSC_VER) || defined(__MINGW32__)
-  Sleep(1);
-#elif defined(__GNUC__)
-  usleep(1);
-#endif
+  ::std::this_thread::sleep_for(::std::chrono::microseconds(1));
 
   *value = temp;
 }
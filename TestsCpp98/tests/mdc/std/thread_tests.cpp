@@ -33,6 +33,7 @@
 #include <stdio.h>
 
 #include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
 #include <mdc/std/threads.hpp>
 #include "std_example_funcs/std_increment.hpp"
 
@@ -64,10 +65,154 @@ static void AssertRaceCondition() {
   assert(value <= kThreadsCount);
 }
 
+class AddTo {
+ public:
+  explicit AddTo(int* target) : target_(target) {
+  }
+
+  void operator()(int amount) const {
+    *this->target_ += amount;
+  }
+
+ private:
+  int* target_;
+};
+
+static void AddProduct(int* target, int lhs, int rhs) {
+  *target += lhs * rhs;
+}
+
+static void StoreThreadId(::std::thread::id* id) {
+  *id = ::std::this_thread::get_id();
+}
+
+static void AssertCallable() {
+  int value = 0;
+
+  ::std::thread functor_thread(AddTo(&value), 3);
+  functor_thread.join();
+
+  assert(value == 3);
+
+  ::std::thread function_thread(&AddProduct, &value, 4, 5);
+  function_thread.join();
+
+  assert(value == 23);
+}
+
+static void AssertIdAndJoinable() {
+  ::std::thread empty_thread;
+
+  assert(!empty_thread.joinable());
+  assert(empty_thread.get_id() == ::std::thread::id());
+
+  ::std::thread::id thread_id;
+  ::std::thread thread(&StoreThreadId, &thread_id);
+
+  assert(thread.joinable());
+  assert(thread.get_id() != ::std::this_thread::get_id());
+
+  ::std::thread::id expected_id = thread.get_id();
+  thread.join();
+
+  assert(!thread.joinable());
+  assert(thread_id == expected_id);
+  assert(thread_id != ::std::thread::id());
+
+  ::std::thread other_thread(&StoreThreadId, &thread_id);
+  empty_thread.swap(other_thread);
+
+  assert(empty_thread.joinable());
+  assert(!other_thread.joinable());
+
+  empty_thread.join();
+}
+
+static void AssertThisThread() {
+  assert(::std::thread::hardware_concurrency() >= 1);
+  assert(::std::this_thread::get_id() == ::std::this_thread::get_id());
+
+  ::std::this_thread::yield();
+
+  ::std::chrono::steady_clock::time_point start =
+      ::std::chrono::steady_clock::now();
+
+  ::std::this_thread::sleep_for(::std::chrono::milliseconds(2));
+
+  assert(::std::chrono::steady_clock::now() - start
+      >= ::std::chrono::milliseconds(2));
+}
+
+#if __cplusplus < 201103L && _MSVC_LANG < 201103L
+
+static int ExpectNullArgument_ThreadFunc(void* arg) {
+  assert(arg == NULL);
+
+  return 0;
+}
+
+static void AssertNullArgument() {
+  ::std::thread null_thread(&ExpectNullArgument_ThreadFunc, NULL);
+  null_thread.join();
+
+  ::std::thread zero_thread(&ExpectNullArgument_ThreadFunc, 0);
+  zero_thread.join();
+
+  ::Mdc_ThrdAttributes attributes;
+  ::Mdc_ThrdAttributes_Init(&attributes);
+
+  ::std::thread attributes_thread(
+      &ExpectNullArgument_ThreadFunc,
+      NULL,
+      attributes
+  );
+  attributes_thread.join();
+}
+
+static void AssertThreadAttributes() {
+  enum {
+    kThreadsCount = 256,
+    kStackSize = 64 * 1024
+  };
+
+  size_t i;
+
+  ::std::thread* threads[kThreadsCount];
+
+  ::Mdc_ThrdAttributes attributes;
+  ::Mdc_ThrdAttributes_Init(&attributes);
+  attributes.stack_size = kStackSize;
+  attributes.name = "mdc-test";
+
+  int value = 0;
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    threads[i] = new ::std::thread(&Increment_ThreadFunc, &value, attributes);
+  }
+
+  for (i = 0; i < kThreadsCount; i += 1) {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  assert(value > 0);
+  assert(value <= kThreadsCount);
+}
+
+#endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
+
 } // namespace
 
 void Thread_RunTests() {
   AssertRaceCondition();
+  AssertCallable();
+  AssertIdAndJoinable();
+  AssertThisThread();
+
+#if __cplusplus < 201103L && _MSVC_LANG < 201103L
+  AssertNullArgument();
+  AssertThreadAttributes();
+#endif // __cplusplus < 201103L && _MSVC_LANG < 201103L
 }
 
 } // namespace std_test
@@ -0,0 +1,132 @@
+/**
+ * Mir Drualga Common For C++98
+ * Copyright (C) 2021-2022  Mir Drualga
+ *
+ * This file is part of Mir Drualga Common For C++98.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Additional permissions under GNU Affero General Public License version 3
+ *  section 7
+ *
+ *  If you modify this Program, or any covered work, by linking or combining
+ *  it with any program (or a modified version of that program and its
+ *  libraries), containing parts covered by the terms of an incompatible
+ *  license, the licensors of this Program grant you additional permission
+ *  to convey the resulting work.
+ */
+
+#include "timed_mutex_tests.hpp"
+
+#include <mdc/std/assert.h>
+#include <mdc/std/chrono.hpp>
+#include <mdc/std/mutex.hpp>
+#include <mdc/std/threads.hpp>
+
+namespace mdc_test {
+namespace std_test {
+namespace {
+
+template <class TimedMutex>
+static int TryLockForExpectTimeout(void* arg) {
+  TimedMutex* mutex = reinterpret_cast<TimedMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_for(
+      ::std::chrono::milliseconds(10)
+  );
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+template <class TimedMutex>
+static int TryLockUntilExpectTimeout(void* arg) {
+  TimedMutex* mutex = reinterpret_cast<TimedMutex*>(arg);
+
+  bool is_lock_success = mutex->try_lock_until(
+      ::std::chrono::steady_clock::now() + ::std::chrono::milliseconds(10)
+  );
+  assert(!is_lock_success);
+
+  return 0;
+}
+
+template <class TimedMutex>
+static void AssertTryLockTimeout() {
+  TimedMutex mutex;
+
+  mutex.lock();
+
+  ::std::thread try_lock_for_thread(
+      &TryLockForExpectTimeout<TimedMutex>,
+      &mutex
+  );
+  try_lock_for_thread.join();
+
+  ::std::thread try_lock_until_thread(
+      &TryLockUntilExpectTimeout<TimedMutex>,
+      &mutex
+  );
+  try_lock_until_thread.join();
+
+  mutex.unlock();
+}
+
+template <class TimedMutex>
+static void AssertTryLockSuccess() {
+  TimedMutex mutex;
+
+  bool is_lock_success = mutex.try_lock_for(
+      ::std::chrono::milliseconds(10)
+  );
+  assert(is_lock_success);
+
+  mutex.unlock();
+
+  is_lock_success = mutex.try_lock_until(
+      ::std::chrono::system_clock::now() + ::std::chrono::milliseconds(10)
+  );
+  assert(is_lock_success);
+
+  mutex.unlock();
+}
+
+static void AssertRecursiveTryLock() {
+  ::std::recursive_timed_mutex mutex;
+
+  mutex.lock();
+
+  bool is_lock_success = mutex.try_lock_for(
+      ::std::chrono::milliseconds(10)
+  );
+  assert(is_lock_success);
+
+  mutex.unlock();
+  mutex.unlock();
+}
+
+} // namespace
+
+void TimedMutex_RunTests() {
+  AssertTryLockTimeout< ::std::timed_mutex>();
+  AssertTryLockTimeout< ::std::recursive_timed_mutex>();
+
+  AssertTryLockSuccess< ::std::timed_mutex>();
+  AssertTryLockSuccess< ::std::recursive_timed_mutex>();
+
+  AssertRecursiveTryLock();
+}
+
+} // namespace std_test
+} // namespace mdc_test
@@ -29,10 +29,17 @@
 
 #include "std_tests.hpp"
 
+#include "std/atomic_tests.hpp"
+#include "std/barrier_tests.hpp"
+#include "std/condition_variable_tests.hpp"
+#include "std/latch_tests.hpp"
 #include "std/mutex_tests.hpp"
 #include "std/once_flag_tests.hpp"
 #include "std/recursive_mutex_tests.hpp"
+#include "std/semaphore_tests.hpp"
+#include "std/shared_mutex_tests.hpp"
 #include "std/thread_tests.hpp"
+#include "std/timed_mutex_tests.hpp"
 
 namespace mdc_test {
 namespace std_test {
@@ -42,7 +49,14 @@ void RunTests() {
 
   Mutex_RunTests();
   RecursiveMutex_RunTests();
+  TimedMutex_RunTests();
+  SharedMutex_RunTests();
   OnceFlag_RunTests();
+  ConditionVariable_RunTests();
+  Atomic_RunTests();
+  Semaphore_RunTests();
+  Latch_RunTests();
+  Barrier_RunTests();
 }
 
 } // namespace std_test